@@ -7,28 +7,27 @@
 
 namespace pegasus
 {
-    inline RegId getRegId(const sparta::Register* reg)
+    inline RegType getRegType(const sparta::RegisterBase* reg)
     {
-        RegId reg_id;
-
         switch (reg->getGroupNum())
         {
             case 1:
-                reg_id.reg_type = RegType::INTEGER;
-                break;
+                return RegType::INTEGER;
             case 2:
-                reg_id.reg_type = RegType::FLOATING_POINT;
-                break;
+                return RegType::FLOATING_POINT;
             case 3:
-                reg_id.reg_type = RegType::VECTOR;
-                break;
+                return RegType::VECTOR;
             case 4:
-                reg_id.reg_type = RegType::CSR;
-                break;
+                return RegType::CSR;
             default:
                 sparta_assert(false, "Invalid register group number");
         }
+    }
 
+    inline RegId getRegId(const sparta::Register* reg)
+    {
+        RegId reg_id;
+        reg_id.reg_type = getRegType(reg);
         reg_id.reg_num = reg->getID();
         reg_id.reg_name = reg->getName();
         return reg_id;
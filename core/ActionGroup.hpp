@@ -8,19 +8,6 @@
 
 namespace pegasus
 {
-    class ActionException : public std::exception
-    {
-      public:
-        ActionException(ActionGroup* action_group) : action_group_(action_group) {}
-
-        ActionGroup* getActionGroup() { return action_group_; }
-
-        const char* what() const noexcept;
-
-      private:
-        ActionGroup* action_group_;
-    };
-
     /*
      * \class ActionGroup
      *
@@ -67,28 +54,37 @@ namespace pegasus
 
         const std::vector<Action> & getActions() const { return actions_; };
 
-        ActionGroup* execute(PegasusState* state)
+        //! Iterators over the Actions, used by the threaded dispatch engine in PegasusCore
+        Action::ItrType begin() { return actions_.begin(); }
+        Action::ItrType end() { return actions_.end(); }
+
+        // StateT is always PegasusState, it is a template parameter so the redirect status can
+        // be checked without including PegasusState.hpp here
+        template <typename StateT> ActionGroup* execute(StateT* state)
         {
             Action::ItrType action_it = actions_.begin();
             const Action::ItrType end_it = actions_.end();
             while (action_it != end_it)
             {
-                try
-                {
-                    // Actions are responsible for incrementing the Action iterator. If an Action
-                    // needs to be repeated, the Action iterator will be returned without being
-                    // incremented.
-                    action_it = action_it->execute(state, action_it);
-                }
-                catch (ActionException & action_excp)
+                // Actions are responsible for incrementing the Action iterator. If an Action
+                // needs to be repeated, the Action iterator will be returned without being
+                // incremented.
+                action_it = action_it->execute(state, action_it);
+
+                // Actions that trap or otherwise leave the ActionGroup early return a redirect
+                // to the next ActionGroup through the PegasusState
+                if (SPARTA_EXPECT_FALSE(state->hasRedirect()))
                 {
-                    return action_excp.getActionGroup();
+                    return state->takeRedirect();
                 }
             }
 
             return next_action_group_;
         }
 
+        //! Replace all of the Actions in the group
+        void setActions(const std::vector<Action> & actions) { actions_ = actions; }
+
         //! Add Action to the back of the group
         void addAction(const Action & action) { actions_.emplace_back(action); }
 
@@ -137,6 +133,9 @@ namespace pegasus
             return next_action_group_;
         }
 
+        //! The next ActionGroup, nullptr at the end of simulation
+        ActionGroup* getNextActionGroupOrNull() const { return next_action_group_; }
+
         bool hasTag(ActionTagType tag) const
         {
             if (SPARTA_EXPECT_TRUE(actions_.empty() == false))
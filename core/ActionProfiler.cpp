@@ -0,0 +1,196 @@
+#include "core/ActionProfiler.hpp"
+#include "core/PegasusInst.hpp"
+#include "include/ActionTags.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <boost/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace pegasus
+{
+    void ActionProfiler::instrument(ActionGroup* action_group)
+    {
+        GroupProfile & group_profile = group_profiles_[action_group->getName()];
+        group_profile.profiler = this;
+        addSampleActions_(action_group, &group_profile);
+    }
+
+    void ActionProfiler::instrumentInst(ActionGroup* action_group, const PegasusInst* inst)
+    {
+        instrument(action_group);
+
+        InstProfile & inst_profile = inst_profiles_[inst->getMavisUid()];
+        inst_profile.mnemonic = inst->getMnemonic();
+        action_group->insertActionFront(pegasus::Action::createAction<&InstProfile::count_>(
+            &inst_profile, "profile count", ActionTags::PROFILE_TAG));
+    }
+
+    void ActionProfiler::addSampleActions_(ActionGroup* action_group, GroupProfile* group_profile)
+    {
+        const Action sample_action = pegasus::Action::createAction<&GroupProfile::sample_>(
+            group_profile, "profile sample", ActionTags::PROFILE_TAG);
+
+        std::vector<Action> actions;
+        for (const Action & action : action_group->getActions())
+        {
+            // Drop the profile Actions from a previous call
+            if (action.hasTag(ActionTags::PROFILE_TAG))
+            {
+                continue;
+            }
+            actions.emplace_back(action);
+            actions.emplace_back(sample_action);
+        }
+        action_group->setActions(actions);
+    }
+
+    Action::ItrType ActionProfiler::GroupProfile::sample_(PegasusState*, Action::ItrType action_it)
+    {
+        const uint64_t timestamp = readTimestamp_();
+        const uint64_t elapsed = timestamp - profiler->last_timestamp_;
+        profiler->last_timestamp_ = timestamp;
+
+        // Charge the Action that ran before this sample. It is looked up by name when it
+        // executes since Actions can be replaced after the group was instrumented.
+        ActionStats & stats = actions[std::prev(action_it)->getName()];
+        ++stats.count;
+        stats.cycles += elapsed;
+        cycles += elapsed;
+
+        return ++action_it;
+    }
+
+    uint64_t ActionProfiler::readTimestamp_()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    void ActionProfiler::report(std::ostream & os, const std::string & json_filename) const
+    {
+        // Instructions sorted by execution count
+        std::vector<std::pair<mavis::InstructionUniqueID, const InstProfile*>> insts;
+        for (const auto & [uid, inst_profile] : inst_profiles_)
+        {
+            insts.emplace_back(uid, &inst_profile);
+        }
+        std::sort(insts.begin(), insts.end(), [](const auto & lhs, const auto & rhs)
+                  { return lhs.second->count > rhs.second->count; });
+
+        // Actions with the same name are merged across ActionGroups
+        std::map<std::string, ActionStats> merged_actions;
+        uint64_t total_cycles = 0;
+        for (const auto & [group_name, group_profile] : group_profiles_)
+        {
+            for (const auto & [action_name, stats] : group_profile.actions)
+            {
+                ActionStats & merged = merged_actions[action_name];
+                merged.count += stats.count;
+                merged.cycles += stats.cycles;
+            }
+            total_cycles += group_profile.cycles;
+        }
+
+        std::vector<std::pair<std::string, ActionStats>> actions(merged_actions.begin(),
+                                                                 merged_actions.end());
+        std::sort(actions.begin(), actions.end(), [](const auto & lhs, const auto & rhs)
+                  { return lhs.second.cycles > rhs.second.cycles; });
+
+        std::vector<std::pair<std::string, const GroupProfile*>> groups;
+        for (const auto & [group_name, group_profile] : group_profiles_)
+        {
+            groups.emplace_back(group_name, &group_profile);
+        }
+        std::sort(groups.begin(), groups.end(), [](const auto & lhs, const auto & rhs)
+                  { return lhs.second->cycles > rhs.second->cycles; });
+
+        auto percent = [total_cycles](const uint64_t cycles)
+        { return (total_cycles == 0) ? 0.0 : (100.0 * cycles / total_cycles); };
+
+        os << std::dec << std::fixed << std::setprecision(2);
+        os << "Instruction profile:" << std::endl;
+        os << "  " << std::left << std::setw(24) << "Mnemonic" << std::right << std::setw(8)
+           << "UID" << std::setw(20) << "Count" << std::endl;
+        for (const auto & [uid, inst_profile] : insts)
+        {
+            os << "  " << std::left << std::setw(24) << inst_profile->mnemonic << std::right
+               << std::setw(8) << uid << std::setw(20) << inst_profile->count << std::endl;
+        }
+
+        os << "Action profile (timestamp cycles):" << std::endl;
+        os << "  " << std::left << std::setw(40) << "Action" << std::right << std::setw(20)
+           << "Count" << std::setw(20) << "Cycles" << std::setw(10) << "%" << std::endl;
+        for (const auto & [name, stats] : actions)
+        {
+            os << "  " << std::left << std::setw(40) << name << std::right << std::setw(20)
+               << stats.count << std::setw(20) << stats.cycles << std::setw(10)
+               << percent(stats.cycles) << std::endl;
+        }
+
+        os << "ActionGroup profile (timestamp cycles):" << std::endl;
+        os << "  " << std::left << std::setw(40) << "ActionGroup" << std::right << std::setw(20)
+           << "Cycles" << std::setw(10) << "%" << std::endl;
+        for (const auto & [name, group_profile] : groups)
+        {
+            os << "  " << std::left << std::setw(40) << name << std::right << std::setw(20)
+               << group_profile->cycles << std::setw(10) << percent(group_profile->cycles)
+               << std::endl;
+        }
+        os << std::defaultfloat;
+
+        if (json_filename.empty())
+        {
+            return;
+        }
+
+        boost::json::array json_insts;
+        for (const auto & [uid, inst_profile] : insts)
+        {
+            json_insts.emplace_back(boost::json::object{{"mnemonic", inst_profile->mnemonic},
+                                                        {"uid", uid},
+                                                        {"count", inst_profile->count}});
+        }
+
+        boost::json::array json_actions;
+        for (const auto & [name, stats] : actions)
+        {
+            json_actions.emplace_back(boost::json::object{
+                {"name", name}, {"count", stats.count}, {"cycles", stats.cycles}});
+        }
+
+        boost::json::array json_groups;
+        for (const auto & [name, group_profile] : groups)
+        {
+            boost::json::array json_group_actions;
+            for (const auto & [action_name, stats] : group_profile->actions)
+            {
+                json_group_actions.emplace_back(boost::json::object{
+                    {"name", action_name}, {"count", stats.count}, {"cycles", stats.cycles}});
+            }
+            json_groups.emplace_back(boost::json::object{{"name", name},
+                                                         {"cycles", group_profile->cycles},
+                                                         {"actions", json_group_actions}});
+        }
+
+        const boost::json::object json_report{{"instructions", json_insts},
+                                              {"actions", json_actions},
+                                              {"action_groups", json_groups}};
+        std::ofstream json_file(json_filename);
+        sparta_assert(json_file.is_open(), "Failed to open profiler report: " << json_filename);
+        json_file << boost::json::serialize(json_report) << std::endl;
+    }
+} // namespace pegasus
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "core/ActionGroup.hpp"
+#include "include/PegasusTypes.hpp"
+
+#include "mavis/OpcodeInfo.h"
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace pegasus
+{
+    class PegasusInst;
+
+    /*
+     * \class ActionProfiler
+     *
+     * \brief Per-hart instruction and Action profiler
+     *
+     * When enabled, the profiler inserts a sample Action after every Action of
+     * the core ActionGroups and of each instruction's linked Actions. A sample
+     * reads the timestamp counter and charges the time since the previous
+     * sample to the Action before it (by Action::getName) and to its
+     * ActionGroup. Each instruction's Actions also start with an Action that
+     * counts executions per Mavis UID.
+     *
+     * The Actions are added when the ActionGroups are built, so a hart without
+     * a profiler executes exactly the same Actions as before.
+     */
+    class ActionProfiler
+    {
+      public:
+        // Required by Action
+        using base_type = ActionProfiler;
+
+        // Add sample Actions to a core ActionGroup (safe to call again after the group changes)
+        void instrument(ActionGroup* action_group);
+
+        // Add the execution count and sample Actions to an instruction's linked Actions
+        void instrumentInst(ActionGroup* action_group, const PegasusInst* inst);
+
+        // Do not charge time spent outside of the Actions (e.g. between quanta) to the next
+        // Action
+        void resetTimestamp() { last_timestamp_ = readTimestamp_(); }
+
+        // Print sorted tables of the results and write them to a JSON file if a filename is
+        // given
+        void report(std::ostream & os, const std::string & json_filename) const;
+
+      private:
+        struct ActionStats
+        {
+            uint64_t count = 0;
+            uint64_t cycles = 0;
+        };
+
+        struct GroupProfile
+        {
+            using base_type = GroupProfile;
+
+            ActionProfiler* profiler = nullptr;
+            uint64_t cycles = 0;
+
+            // Keyed by the name pointer returned by Action::getName
+            std::unordered_map<const char*, ActionStats> actions;
+
+            Action::ItrType sample_(PegasusState*, Action::ItrType action_it);
+        };
+
+        struct InstProfile
+        {
+            using base_type = InstProfile;
+
+            std::string mnemonic;
+            uint64_t count = 0;
+
+            Action::ItrType count_(PegasusState*, Action::ItrType action_it)
+            {
+                ++count;
+                return ++action_it;
+            }
+        };
+
+        // Insert a sample Action after every Action in the group
+        void addSampleActions_(ActionGroup* action_group, GroupProfile* group_profile);
+
+        static uint64_t readTimestamp_();
+
+        uint64_t last_timestamp_ = 0;
+
+        // Node-based maps, the Actions keep pointers to the profiles
+        std::unordered_map<std::string, GroupProfile> group_profiles_;
+        std::unordered_map<mavis::InstructionUniqueID, InstProfile> inst_profiles_;
+    };
+} // namespace pegasus
@@ -21,6 +21,9 @@ namespace pegasus
     const ActionTagType ActionTags::DATA_G_STAGE_TRANSLATE_TAG =
         ActionTagFactory::createTag("DATA_G_STAGE_TRANSLATE");
     const ActionTagType ActionTags::EXCEPTION_TAG = ActionTagFactory::createTag("EXCEPTION");
+    const ActionTagType ActionTags::INCREMENT_PC_TAG = ActionTagFactory::createTag("INCREMENT_PC");
+    const ActionTagType ActionTags::OBSERVER_TAG = ActionTagFactory::createTag("OBSERVER");
+    const ActionTagType ActionTags::PROFILE_TAG = ActionTagFactory::createTag("PROFILE");
 
     // Stop Simulation
     const ActionTagType ActionTags::STOP_SIM_TAG = ActionTagFactory::createTag("STOP_SIM");
@@ -0,0 +1,141 @@
+#include "core/BBVCollector.hpp"
+#include "core/PegasusState.hpp"
+#include "sim/PegasusSim.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
+namespace pegasus
+{
+    BBVCollector::BBVCollector(uint64_t interval, const std::string & filename,
+                               const std::string & simpoints_filename) :
+        interval_(interval),
+        bb_file_(filename),
+        interval_end_(interval)
+    {
+        sparta_assert(bb_file_.is_open(), "Failed to open BBV file: " << filename);
+
+        // SimPoint writes one "<interval> <cluster>" line per selected interval
+        if (!simpoints_filename.empty())
+        {
+            std::ifstream simpoints_file(simpoints_filename);
+            sparta_assert(simpoints_file.is_open(),
+                          "Failed to open SimPoint file: " << simpoints_filename);
+            uint64_t interval_idx = 0;
+            uint64_t cluster = 0;
+            while (simpoints_file >> interval_idx >> cluster)
+            {
+                simpoints_.insert(interval_idx);
+            }
+            snapshot_prefix_ = std::filesystem::path(filename).replace_extension().string();
+        }
+
+        bbv_action_ = pegasus::Action::createAction<&BBVCollector::collect_>(this, "bbv");
+    }
+
+    void BBVCollector::start(PegasusState* state)
+    {
+        if (simpoints_.count(0) != 0)
+        {
+            saveCheckpoint_(state);
+        }
+    }
+
+    Action::ItrType BBVCollector::collect_(PegasusState* state, Action::ItrType action_it)
+    {
+        // Runs after the PC was incremented: the previous PC is the instruction that just
+        // executed
+        const uint64_t inst_count = state->getSimState()->inst_count;
+        const Addr inst_pc = state->getPrevPc();
+
+        // Jumped somewhere without a change of flow instruction (e.g. a trap)
+        if (SPARTA_EXPECT_FALSE(inst_pc != expected_pc_))
+        {
+            closeBlock_(inst_count - 1);
+            block_start_pc_ = inst_pc;
+        }
+
+        if (state->getSimState()->current_inst->isChangeOfFlowInst())
+        {
+            closeBlock_(inst_count);
+            block_start_pc_ = state->getPc();
+        }
+        expected_pc_ = state->getPc();
+
+        if (SPARTA_EXPECT_FALSE(inst_count >= interval_end_))
+        {
+            // The block continues into the next interval under the same ID
+            closeBlock_(inst_count);
+            writeInterval_();
+            interval_end_ += interval_;
+            ++interval_idx_;
+
+            if (SPARTA_EXPECT_FALSE(simpoints_.count(interval_idx_) != 0))
+            {
+                saveCheckpoint_(state);
+            }
+        }
+
+        return ++action_it;
+    }
+
+    void BBVCollector::closeBlock_(uint64_t inst_count)
+    {
+        if (inst_count > block_start_count_)
+        {
+            auto [it, inserted] = block_ids_.try_emplace(block_start_pc_, block_ids_.size());
+            if (inserted)
+            {
+                block_counts_.emplace_back(0);
+            }
+
+            uint64_t & count = block_counts_[it->second];
+            if (count == 0)
+            {
+                touched_blocks_.emplace_back(it->second);
+            }
+            count += inst_count - block_start_count_;
+        }
+        block_start_count_ = inst_count;
+    }
+
+    void BBVCollector::writeInterval_()
+    {
+        std::sort(touched_blocks_.begin(), touched_blocks_.end());
+
+        // SimPoint block IDs start at 1
+        bb_file_ << "T";
+        for (const uint32_t block_id : touched_blocks_)
+        {
+            bb_file_ << ":" << (block_id + 1) << ":" << block_counts_[block_id] << " ";
+            block_counts_[block_id] = 0;
+        }
+        bb_file_ << "\n";
+        touched_blocks_.clear();
+    }
+
+    void BBVCollector::saveCheckpoint_(PegasusState* state)
+    {
+        auto sim = dynamic_cast<PegasusSim*>(state->getContainer()->getRoot()->getSimulation());
+        sparta_assert(sim != nullptr);
+
+        std::ostringstream filename;
+        filename << snapshot_prefix_ << "." << interval_idx_ << ".snapshot";
+        std::cout << "Saving SimPoint interval " << std::dec << interval_idx_ << " at PC 0x"
+                  << std::hex << state->getPc() << std::dec << std::endl;
+        sim->saveSnapshot(filename.str());
+    }
+
+    void BBVCollector::finish(const PegasusState* state)
+    {
+        closeBlock_(state->getSimState()->inst_count);
+        if (!touched_blocks_.empty())
+        {
+            writeInterval_();
+        }
+        bb_file_.flush();
+    }
+} // namespace pegasus
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/Action.hpp"
+#include "include/PegasusTypes.hpp"
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pegasus
+{
+    class PegasusSim;
+    class PegasusState;
+
+    /*
+     * \class BBVCollector
+     *
+     * \brief Per-hart basic block vector collector for SimPoint
+     *
+     * When enabled, an Action after the increment PC Action of the finish
+     * ActionGroup tracks dynamic basic blocks: a block starts at the target
+     * of a change of flow instruction (or of a trap) and ends at the next one.
+     * The instructions executed in each block are accumulated per interval
+     * and every interval is written as one line of a SimPoint .bb file, with
+     * blocks numbered from 1 in the order they were first seen.
+     *
+     * Given the intervals selected by SimPoint, a snapshot of the simulator
+     * is saved at the start of each of them so the detailed model can start
+     * from there.
+     */
+    class BBVCollector
+    {
+      public:
+        // Required by Action
+        using base_type = BBVCollector;
+
+        BBVCollector(uint64_t interval, const std::string & filename,
+                     const std::string & simpoints_filename);
+
+        const Action & getAction() const { return bbv_action_; }
+
+        // Save the snapshot of the first interval if SimPoint selected it, it starts before any
+        // instruction executes
+        void start(PegasusState* state);
+
+        // Write the last, partial interval
+        void finish(const PegasusState* state);
+
+      private:
+        Action::ItrType collect_(PegasusState* state, Action::ItrType action_it);
+
+        // Charge the instructions of the current block up to inst_count
+        void closeBlock_(uint64_t inst_count);
+
+        void writeInterval_();
+
+        // Save a snapshot if SimPoint selected the interval that starts now
+        void saveCheckpoint_(PegasusState* state);
+
+        const uint64_t interval_;
+        std::ofstream bb_file_;
+
+        // Intervals to save snapshots for
+        std::set<uint64_t> simpoints_;
+        std::string snapshot_prefix_;
+
+        // The current block
+        Addr block_start_pc_ = 0;
+        uint64_t block_start_count_ = 0;
+        uint64_t interval_end_;
+        uint64_t interval_idx_ = 0;
+        // PC of the next instruction if the block continues
+        Addr expected_pc_ = 0;
+
+        // Block IDs by start PC and the instructions executed per block ID in this interval
+        std::unordered_map<Addr, uint32_t> block_ids_;
+        std::vector<uint64_t> block_counts_;
+        std::vector<uint32_t> touched_blocks_;
+
+        Action bbv_action_;
+    };
+} // namespace pegasus
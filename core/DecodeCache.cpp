@@ -0,0 +1,91 @@
+#include "core/DecodeCache.hpp"
+
+namespace pegasus
+{
+    const PegasusInstPtr* DecodeCache::lookup(const Addr pc, const Addr paddr,
+                                              const Context context)
+    {
+        auto block_it = blocks_.find(paddr);
+        if ((block_it == blocks_.end()) || (block_it->second->context != context)
+            || block_it->second->insts.empty())
+        {
+            return nullptr;
+        }
+
+        cursor_block_ = block_it->second.get();
+        cursor_idx_ = 1;
+        const PegasusInstPtr & inst = cursor_block_->insts.front();
+        cursor_pc_ = pc + inst->getOpcodeSize();
+        return &inst;
+    }
+
+    void DecodeCache::record(const PegasusInstPtr & inst, const Addr pc, const Addr paddr,
+                             const Context context)
+    {
+        // Keep appending to the block we are following if the instruction is the next one
+        const bool append = cursor_block_ && !cursor_block_->sealed
+                            && (cursor_idx_ == cursor_block_->insts.size()) && (pc == cursor_pc_)
+                            && (paddr == cursor_block_->end_paddr)
+                            && (context == cursor_block_->context);
+        if (!append)
+        {
+            if (SPARTA_EXPECT_FALSE((blocks_.size() >= max_blocks_) && !blocks_.contains(paddr)))
+            {
+                flush();
+            }
+
+            std::unique_ptr<Block> & block = blocks_[paddr];
+            if (block == nullptr)
+            {
+                block = std::make_unique<Block>();
+                code_pages_[paddr >> PAGESHIFT].emplace_back(paddr);
+            }
+            block->paddr = paddr;
+            block->context = context;
+            block->end_paddr = paddr;
+            block->sealed = false;
+            block->insts.clear();
+            cursor_block_ = block.get();
+        }
+
+        const uint32_t opcode_size = inst->getOpcodeSize();
+        cursor_block_->insts.emplace_back(inst);
+        cursor_block_->end_paddr += opcode_size;
+        cursor_idx_ = cursor_block_->insts.size();
+        cursor_pc_ = pc + opcode_size;
+
+        // Blocks end at a change of flow instruction or at the end of the page
+        const Addr page_offset_mask = (Addr(1) << PAGESHIFT) - 1;
+        if (inst->isChangeOfFlowInst() || ((cursor_block_->end_paddr & page_offset_mask) == 0))
+        {
+            cursor_block_->sealed = true;
+        }
+    }
+
+    void DecodeCache::invalidatePage(const Addr paddr)
+    {
+        auto page_it = code_pages_.find(paddr >> PAGESHIFT);
+        if (page_it == code_pages_.end())
+        {
+            return;
+        }
+
+        for (const Addr block_paddr : page_it->second)
+        {
+            auto block_it = blocks_.find(block_paddr);
+            if (block_it->second.get() == cursor_block_)
+            {
+                resetCursor();
+            }
+            blocks_.erase(block_it);
+        }
+        code_pages_.erase(page_it);
+    }
+
+    void DecodeCache::flush()
+    {
+        resetCursor();
+        blocks_.clear();
+        code_pages_.clear();
+    }
+} // namespace pegasus
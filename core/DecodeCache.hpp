@@ -0,0 +1,123 @@
+#pragma once
+
+#include "core/PegasusInst.hpp"
+#include "include/PegasusTypes.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pegasus
+{
+    /*
+     * \class DecodeCache
+     *
+     * \brief Per-hart cache of decoded basic blocks
+     *
+     * A block is a sequence of decoded instructions starting at a physical PC
+     * and ending at the first change-of-flow instruction or at the end of the
+     * 4K page, whichever comes first. Blocks never span a page, so once the
+     * first instruction of a block has been translated the rest of the block
+     * can be fetched without translating or decoding again.
+     *
+     * Blocks are recorded lazily as Decode produces instructions. The cache
+     * also tracks a cursor into the block being executed; Fetch asks for the
+     * next instruction of the cursor and falls back to the full
+     * Fetch/Translate/Decode path when the PC does not continue sequentially.
+     *
+     * Self-modifying code and JITs keep producing new blocks, so the cache is
+     * flushed when it reaches max_blocks.
+     */
+    class DecodeCache
+    {
+      public:
+        static constexpr uint32_t PAGESHIFT = 12;
+
+        // Decoding context the block was recorded in (privilege and virtualization mode)
+        using Context = uint32_t;
+
+        static Context makeContext(const PrivMode priv_mode, const bool virtual_mode)
+        {
+            return (static_cast<Context>(priv_mode) << 1) | (virtual_mode ? 1 : 0);
+        }
+
+        DecodeCache(const bool enabled, const uint32_t max_blocks) :
+            enabled_(enabled),
+            max_blocks_(max_blocks)
+        {
+            sparta_assert(max_blocks_ > 0, "The decode cache must hold at least one block");
+        }
+
+        bool isEnabled() const { return enabled_; }
+
+        // Next instruction in the current block if the PC continues sequentially
+        const PegasusInstPtr* next(const Addr pc)
+        {
+            if (SPARTA_EXPECT_TRUE(cursor_block_ && (pc == cursor_pc_)
+                                   && (cursor_idx_ < cursor_block_->insts.size())))
+            {
+                const PegasusInstPtr & inst = cursor_block_->insts[cursor_idx_++];
+                cursor_pc_ += inst->getOpcodeSize();
+                return &inst;
+            }
+            return nullptr;
+        }
+
+        // Called after Translate has resolved the PC. Returns the first instruction of the block
+        // that starts at paddr or nullptr if the instruction needs to be decoded.
+        const PegasusInstPtr* lookup(const Addr pc, const Addr paddr, const Context context);
+
+        // Record an instruction that was just decoded at pc/paddr
+        void record(const PegasusInstPtr & inst, const Addr pc, const Addr paddr,
+                    const Context context);
+
+        // Stop following the current block, the next fetch will translate its PC
+        void resetCursor()
+        {
+            cursor_block_ = nullptr;
+            cursor_idx_ = 0;
+        }
+
+        // Drop every block in the given physical page
+        void invalidatePage(const Addr paddr);
+
+        // Does the physical page contain any decoded instructions?
+        bool isCodePage(const Addr paddr) const
+        {
+            return !code_pages_.empty() && code_pages_.contains(paddr >> PAGESHIFT);
+        }
+
+        // Drop every block (fence.i, Mavis context change)
+        void flush();
+
+        size_t getNumBlocks() const { return blocks_.size(); }
+
+      private:
+        struct Block
+        {
+            Addr paddr = 0;
+            Context context = 0;
+            // Physical address following the last instruction in the block
+            Addr end_paddr = 0;
+            // No more instructions can be appended (change of flow or end of page)
+            bool sealed = false;
+            std::vector<PegasusInstPtr> insts;
+        };
+
+        const bool enabled_;
+        const uint32_t max_blocks_;
+
+        // Blocks by physical address of the first instruction
+        std::unordered_map<Addr, std::unique_ptr<Block>> blocks_;
+
+        // Start addresses of the blocks in each physical page
+        std::unordered_map<Addr, std::vector<Addr>> code_pages_;
+
+        // Block being executed (and possibly recorded)
+        Block* cursor_block_ = nullptr;
+        size_t cursor_idx_ = 0;
+        Addr cursor_pc_ = 0;
+    };
+} // namespace pegasus
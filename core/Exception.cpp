@@ -55,6 +55,7 @@ namespace pegasus
                                                 : static_cast<XLEN>(fault_cause_.getValue());
 
         DLOG("Exception code: " << excp_code);
+        ++state->getSimState()->trap_count;
 
         // When a trap occurs in HS-mode or U-mode, it goes to M-mode, unless
         // delegated by medeleg or mideleg, in which case it goes to HS-mode.
@@ -116,7 +117,7 @@ namespace pegasus
                                       ? determineTrapValue_(interrupt_cause_.getValue(), state)
                                       : determineTrapValue_(fault_cause_.getValue(), state);
         // Values for updating VSSTATUS/SSTATUS
-        const auto mstatus_sie = READ_CSR_FIELD<XLEN>(state, MSTATUS, "sie");
+        const auto mstatus_sie = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SIE);
         const auto xpp_val = static_cast<XLEN>(state->getPrivMode());
         const uint64_t sie_val = 0;
 
@@ -130,9 +131,9 @@ namespace pegasus
             WRITE_CSR_REG<XLEN>(state, VSTVAL, trap_val);
 
             // Update VSSTATUS
-            WRITE_CSR_FIELD<XLEN>(state, VSSTATUS, "spie", mstatus_sie);
-            WRITE_CSR_FIELD<XLEN>(state, VSSTATUS, "spp", xpp_val);
-            WRITE_CSR_FIELD<XLEN>(state, VSSTATUS, "sie", sie_val);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::VSSTATUS::SPIE, mstatus_sie);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::VSSTATUS::SPP, xpp_val);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::VSSTATUS::SIE, sie_val);
         }
         // HS-mode
         else if (priv_mode == PrivMode::SUPERVISOR)
@@ -144,24 +145,24 @@ namespace pegasus
             WRITE_CSR_REG<XLEN>(state, STVAL, trap_val);
 
             // Update SSTATUS
-            WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "spie", mstatus_sie);
-            WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "spp", xpp_val);
-            WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "sie", sie_val);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SPIE, mstatus_sie);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SPP, xpp_val);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SIE, sie_val);
 
             // Update HSTATUS
             if (state->getCore()->hasHypervisor())
             {
                 const uint64_t spv_val = prev_virt_mode;
-                WRITE_CSR_FIELD<XLEN>(state, HSTATUS, "spv", spv_val);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::HSTATUS::SPV, spv_val);
 
                 if (prev_virt_mode)
                 {
-                    WRITE_CSR_FIELD<XLEN>(state, HSTATUS, "spvp", xpp_val);
+                    WRITE_CSR_FIELD<XLEN>(state, CSR::HSTATUS::SPVP, xpp_val);
                 }
 
                 const uint64_t gva_val =
                     !is_interrupt ? determineGvaValue_(fault_cause_.getValue(), prev_virt_mode) : 0;
-                WRITE_CSR_FIELD<XLEN>(state, HSTATUS, "gva", gva_val);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::HSTATUS::GVA, gva_val);
 
                 // TODO: Guest physical address that faulted, shifted right by 2 bits
                 const uint64_t htval_val = 0;
@@ -181,11 +182,11 @@ namespace pegasus
             WRITE_CSR_REG<XLEN>(state, MTVAL, trap_val);
 
             // Update MSTATUS
-            const auto mstatus_mie = READ_CSR_FIELD<XLEN>(state, MSTATUS, "mie");
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpie", mstatus_mie);
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpp", xpp_val);
+            const auto mstatus_mie = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MIE);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPIE, mstatus_mie);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPP, xpp_val);
             const uint64_t mie_val = 0;
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mie", mie_val);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MIE, mie_val);
 
             if (state->getCore()->hasHypervisor())
             {
@@ -198,13 +199,13 @@ namespace pegasus
 
                 if constexpr (std::is_same_v<XLEN, RV64>)
                 {
-                    WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpv", mpv_val);
-                    WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "gva", gva_val);
+                    WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPV, mpv_val);
+                    WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::GVA, gva_val);
                 }
                 else
                 {
-                    WRITE_CSR_FIELD<XLEN>(state, MSTATUSH, "mpv", mpv_val);
-                    WRITE_CSR_FIELD<XLEN>(state, MSTATUSH, "gva", gva_val);
+                    WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUSH::MPV, mpv_val);
+                    WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUSH::GVA, gva_val);
                 }
             }
         }
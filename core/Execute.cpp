@@ -1,4 +1,5 @@
 #include "core/Execute.hpp"
+#include "core/ActionProfiler.hpp"
 #include "core/PegasusInst.hpp"
 #include "core/PegasusCore.hpp"
 #include "core/translate/Translate.hpp"
@@ -11,19 +12,87 @@ namespace pegasus
     Execute::Execute(sparta::TreeNode* execute_node, const ExecuteParameters*) :
         sparta::Unit(execute_node)
     {
-        Action execute_action = pegasus::Action::createAction<&Execute::execute_>(this, "Execute");
+        Action execute_action =
+            pegasus::Action::createAction<&Execute::execute_<false>>(this, "Execute");
         execute_action.addTag(ActionTags::EXECUTE_TAG);
         execute_action_group_.addAction(execute_action);
     }
 
+    void Execute::setFastForward(const bool fast_forward)
+    {
+        Action execute_action;
+        if (fast_forward)
+        {
+            execute_action = pegasus::Action::createAction<&Execute::execute_<true>>(
+                this, "Execute (fast-forward)", ActionTags::EXECUTE_TAG);
+        }
+        else
+        {
+            execute_action = pegasus::Action::createAction<&Execute::execute_<false>>(
+                this, "Execute", ActionTags::EXECUTE_TAG);
+        }
+        execute_action_group_.replaceAction(ActionTags::EXECUTE_TAG, execute_action);
+    }
+
+    template <bool FAST_FORWARD>
     Action::ItrType Execute::execute_(PegasusState* state, Action::ItrType action_it)
     {
-        const InstHandlers* inst_handlers = state->getCore()->getInstHandlers();
         // Connect instruction to Fetch
-        const auto inst = state->getCurrentInst();
+        const auto & inst = state->getCurrentInst();
+        if (SPARTA_EXPECT_FALSE(inst->getActionsVersion() != state->getInstActionsVersion()))
+        {
+            linkInstActions_(state, inst.get());
+        }
         ActionGroup* inst_action_group = inst->getActionGroup();
         inst_action_group->setNextActionGroup(state->getFinishActionGroup());
 
+        if constexpr (!FAST_FORWARD)
+        {
+            ILOG(inst);
+        }
+
+        // Execute the instruction
+        execute_action_group_.setNextActionGroup(inst_action_group);
+        return ++action_it;
+    }
+
+    void Execute::linkInstActions_(PegasusState* state, PegasusInst* inst)
+    {
+        const uint64_t version = state->getInstActionsVersion();
+        PegasusExtractor::LinkedActions & linked_actions =
+            inst->getExtractorInfo()->getLinkedActions(state->getCoreHartIdx());
+        if (linked_actions.version != version)
+        {
+            linkExtractorActions_(state, inst, linked_actions.actions);
+            linked_actions.version = version;
+        }
+
+        ActionGroup* inst_action_group = inst->getActionGroup();
+        inst_action_group->setActions(linked_actions.actions);
+
+        if (inst->writesCsr())
+        {
+            const InstHandlers* inst_handlers = state->getCore()->getInstHandlers();
+            const InstHandlers::CsrUpdateActionsMap* csr_update_actions =
+                (state->getXlen() == 64) ? inst_handlers->getCsrUpdateActionsMap<RV64>()
+                                         : inst_handlers->getCsrUpdateActionsMap<RV32>();
+            auto csr_action_it = csr_update_actions->find(inst->getCsr());
+            if (csr_action_it != csr_update_actions->end())
+            {
+                auto & action = csr_action_it->second;
+                inst_action_group->insertActionAfter(action, ActionTags::EXECUTE_TAG);
+            }
+        }
+
+        inst->setActionsVersion(version);
+    }
+
+    void Execute::linkExtractorActions_(PegasusState* state, const PegasusInst* inst,
+                                        std::vector<Action> & actions)
+    {
+        ActionGroup linked_action_group(inst->getMnemonic());
+        linked_action_group.setActions(inst->getExtractorInfo()->getInstActions());
+
         // Insert translation Action into instruction's ActionGroup between the compute address
         // handler and the execute handler
         if (inst->isMemoryInst())
@@ -47,7 +116,7 @@ namespace pegasus
                         translate_unit->getStoreTranslateActionGroup(hypervisor_inst);
                     break;
                 case translate_types::AccessType::INVALID:
-                    sparta_assert(false, "Invalid translate access type for inst: " << inst);
+                    sparta_assert(false, "Invalid translate access type for inst: " << *inst);
                     break;
             }
 
@@ -55,29 +124,17 @@ namespace pegasus
                  it != translate_action_group->getActions().rend(); ++it)
             {
                 auto & action = *it;
-                inst_action_group->insertActionAfter(action, ActionTags::COMPUTE_ADDR_TAG);
+                linked_action_group.insertActionAfter(action, ActionTags::COMPUTE_ADDR_TAG);
             }
         }
 
-        if (inst->writesCsr())
+        state->insertExecuteActions(&linked_action_group, inst->isMemoryInst());
+
+        if (ActionProfiler* profiler = state->getProfiler())
         {
-            const InstHandlers::CsrUpdateActionsMap* csr_update_actions =
-                (state->getXlen() == 64) ? inst_handlers->getCsrUpdateActionsMap<RV64>()
-                                         : inst_handlers->getCsrUpdateActionsMap<RV32>();
-            auto action_it = csr_update_actions->find(inst->getCsr());
-            if (action_it != csr_update_actions->end())
-            {
-                auto & action = action_it->second;
-                inst_action_group->insertActionAfter(action, ActionTags::EXECUTE_TAG);
-            }
+            profiler->instrumentInst(&linked_action_group, inst);
         }
 
-        state->insertExecuteActions(inst_action_group, inst->isMemoryInst());
-
-        ILOG(inst);
-
-        // Execute the instruction
-        execute_action_group_.setNextActionGroup(inst_action_group);
-        return ++action_it;
+        actions = linked_action_group.getActions();
     }
 } // namespace pegasus
@@ -9,6 +9,7 @@
 namespace pegasus
 {
     class PegasusState;
+    class PegasusInst;
 
     class Execute : public sparta::Unit
     {
@@ -27,9 +28,20 @@ namespace pegasus
 
         ActionGroup* getActionGroup() { return &execute_action_group_; }
 
+        // Switch between the instrumented and fast-forward execute Actions
+        void setFastForward(const bool fast_forward);
+
       private:
+        template <bool FAST_FORWARD>
         Action::ItrType execute_(pegasus::PegasusState* state, Action::ItrType action_it);
 
+        // Link the translate, observer and CSR update Actions into the instruction's ActionGroup
+        void linkInstActions_(PegasusState* state, PegasusInst* inst);
+
+        // Link the translate and observer Actions shared by all instructions from the extractor
+        void linkExtractorActions_(PegasusState* state, const PegasusInst* inst,
+                                   std::vector<Action> & actions);
+
         ActionGroup execute_action_group_{"Execute"};
     };
 } // namespace pegasus
@@ -10,10 +10,12 @@
 
 namespace pegasus
 {
-    Fetch::Fetch(sparta::TreeNode* fetch_node, const FetchParameters*) : sparta::Unit(fetch_node)
+    Fetch::Fetch(sparta::TreeNode* fetch_node, const FetchParameters* p) :
+        sparta::Unit(fetch_node),
+        decode_cache_(p->enable_decode_cache, p->decode_cache_max_blocks)
     {
-        Action fetch_action =
-            pegasus::Action::createAction<&Fetch::fetch_>(this, "fetch", ActionTags::FETCH_TAG);
+        Action fetch_action = pegasus::Action::createAction<&Fetch::fetch_<false>>(
+            this, "fetch", ActionTags::FETCH_TAG);
         fetch_action_group_.addAction(fetch_action);
 
         Action decode_action =
@@ -30,18 +32,38 @@ namespace pegasus
         Translate* translate_unit = hart_tn->getChild("translate")->getResourceAs<Translate*>();
         Execute* execute_unit = hart_tn->getChild("execute")->getResourceAs<Execute*>();
 
-        ActionGroup* inst_translate_action_group = translate_unit->getExecuteTranslateActionGroup();
-        ActionGroup* execute_action_group = execute_unit->getActionGroup();
+        inst_translate_action_group_ = translate_unit->getExecuteTranslateActionGroup();
+        execute_action_group_ = execute_unit->getActionGroup();
 
-        fetch_action_group_.setNextActionGroup(inst_translate_action_group);
-        inst_translate_action_group->setNextActionGroup(&decode_action_group_);
-        decode_action_group_.setNextActionGroup(execute_action_group);
-        execute_action_group->setNextActionGroup(&fetch_action_group_);
+        fetch_action_group_.setNextActionGroup(inst_translate_action_group_);
+        inst_translate_action_group_->setNextActionGroup(&decode_action_group_);
+        decode_action_group_.setNextActionGroup(execute_action_group_);
+        execute_action_group_->setNextActionGroup(&fetch_action_group_);
     }
 
+    void Fetch::setFastForward(const bool fast_forward)
+    {
+        Action fetch_action;
+        if (fast_forward)
+        {
+            fetch_action = pegasus::Action::createAction<&Fetch::fetch_<true>>(
+                this, "fetch (fast-forward)", ActionTags::FETCH_TAG);
+        }
+        else
+        {
+            fetch_action = pegasus::Action::createAction<&Fetch::fetch_<false>>(
+                this, "fetch", ActionTags::FETCH_TAG);
+        }
+        fetch_action_group_.replaceAction(ActionTags::FETCH_TAG, fetch_action);
+    }
+
+    template <bool FAST_FORWARD>
     Action::ItrType Fetch::fetch_(PegasusState* state, Action::ItrType action_it)
     {
-        ILOG("Fetching PC 0x" << std::hex << state->getPc());
+        if constexpr (!FAST_FORWARD)
+        {
+            ILOG("Fetching PC 0x" << std::hex << state->getPc());
+        }
 
         // Reset the sim state
         PegasusState::SimState* sim_state = state->getSimState();
@@ -49,12 +71,66 @@ namespace pegasus
 
         PegasusTranslationState* translation_state = state->getFetchTranslationState();
         translation_state->reset();
+
+        // If we are still executing sequentially through a decoded block, skip translation and
+        // decode and go straight to Execute
+        if (SPARTA_EXPECT_TRUE(decode_cache_.isEnabled()))
+        {
+            const PegasusInstPtr* cached_inst = decode_cache_.next(state->getPc());
+            if (cached_inst)
+            {
+                if (SPARTA_EXPECT_FALSE(!setupCachedInst_(state, *cached_inst)))
+                {
+                    THROW_ILLEGAL_INST;
+                }
+                fetch_action_group_.setNextActionGroup(execute_action_group_);
+                return ++action_it;
+            }
+        }
+
+        fetch_action_group_.setNextActionGroup(inst_translate_action_group_);
         translation_state->makeRequest(state->getPc(), sizeof(Opcode));
 
         // Keep going
         return ++action_it;
     }
 
+    bool Fetch::setupCachedInst_(PegasusState* state, const PegasusInstPtr & inst)
+    {
+        state->getSimState()->current_opcode = inst->getOpcode();
+        inst->getTranslationState()->reset();
+        inst->updateVecConfig(state);
+        state->setCurrentInst(inst);
+        state->setNextPc(state->getPc() + inst->getOpcodeSize());
+
+        if (SPARTA_EXPECT_FALSE(inst->hasCsr()))
+        {
+            return checkCsrAccess_(state, inst);
+        }
+        return true;
+    }
+
+    bool Fetch::checkCsrAccess_(PegasusState* state, const PegasusInstPtr & inst)
+    {
+        const uint32_t csr =
+            inst->getMavisOpcodeInfo()->getSpecialField(mavis::OpcodeInfo::SpecialField::CSR);
+        if (state->getCsrRegister(csr) == nullptr)
+        {
+            return false;
+        }
+
+        // TODO: This is probably not the best place for this check...
+        if (csr == SATP)
+        {
+            const uint32_t tvm_val = READ_CSR_FIELD<RV64>(state, CSR::MSTATUS::TVM);
+            if ((state->getPrivMode() == PrivMode::SUPERVISOR) && tvm_val)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     Action::ItrType Fetch::decode_(PegasusState* state, Action::ItrType action_it)
     {
         // Get translation result
@@ -92,6 +168,23 @@ namespace pegasus
         //    combined 32 bits are decoded as a non-compressed instruction.
         const bool page_crossing_access = result.getSize() == 2;
 
+        // Instructions that cross a page are never cached
+        const DecodeCache::Context decode_context =
+            DecodeCache::makeContext(state->getPrivMode(), state->getVirtualMode());
+        if (SPARTA_EXPECT_TRUE(decode_cache_.isEnabled() && !page_crossing_access))
+        {
+            const PegasusInstPtr* cached_inst =
+                decode_cache_.lookup(state->getPc(), result.getPAddr(), decode_context);
+            if (cached_inst)
+            {
+                if (SPARTA_EXPECT_FALSE(!setupCachedInst_(state, *cached_inst)))
+                {
+                    THROW_ILLEGAL_INST;
+                }
+                return ++action_it;
+            }
+        }
+
         // Read opcode from memory
         Opcode & opcode = state->getSimState()->current_opcode;
         OpcodeSize opcode_size = 4;
@@ -118,7 +211,8 @@ namespace pegasus
                 if ((opcode & 0x3) == 0x3)
                 {
                     // Go back to inst translate
-                    throw ActionException(fetch_action_group_.getNextActionGroup());
+                    return state->redirectActionGroup(fetch_action_group_.getNextActionGroup(),
+                                                      action_it);
                 }
             }
             else
@@ -152,26 +246,23 @@ namespace pegasus
             state->getFetchTranslationState()->popRequest();
         }
 
-        if (SPARTA_EXPECT_FALSE(inst->hasCsr()))
+        if (SPARTA_EXPECT_TRUE(decode_cache_.isEnabled()))
         {
-            const uint32_t csr =
-                inst->getMavisOpcodeInfo()->getSpecialField(mavis::OpcodeInfo::SpecialField::CSR);
-            if (state->getCsrRegister(csr) == nullptr)
+            if (SPARTA_EXPECT_TRUE(!page_crossing_access))
             {
-                THROW_ILLEGAL_INST;
+                decode_cache_.record(inst, state->getPc(), result.getPAddr(), decode_context);
             }
-
-            // TODO: This is probably not the best place for this check...
-            if (csr == SATP)
+            else
             {
-                const uint32_t tvm_val = READ_CSR_FIELD<RV64>(state, MSTATUS, "tvm");
-                if ((state->getPrivMode() == PrivMode::SUPERVISOR) && tvm_val)
-                {
-                    THROW_ILLEGAL_INST;
-                }
+                decode_cache_.resetCursor();
             }
         }
 
+        if (SPARTA_EXPECT_FALSE(inst->hasCsr() && !checkCsrAccess_(state, inst)))
+        {
+            THROW_ILLEGAL_INST;
+        }
+
         return ++action_it;
     }
 } // namespace pegasus
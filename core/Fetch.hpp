@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/ActionGroup.hpp"
+#include "core/DecodeCache.hpp"
 
 #include "sparta/simulation/ParameterSet.hpp"
 #include "sparta/simulation/TreeNode.hpp"
@@ -21,17 +22,35 @@ namespace pegasus
         {
           public:
             FetchParameters(sparta::TreeNode* node) : sparta::ParameterSet(node) {}
+
+            PARAMETER(bool, enable_decode_cache, true,
+                      "Cache decoded basic blocks to skip Fetch/Translate/Decode for hot code")
+            PARAMETER(uint32_t, decode_cache_max_blocks, 65536,
+                      "Flush the decode cache when it holds this many blocks")
         };
 
         Fetch(sparta::TreeNode* fetch_node, const FetchParameters* p);
 
         ActionGroup* getActionGroup() { return &fetch_action_group_; }
 
+        ActionGroup* getDecodeActionGroup() { return &decode_action_group_; }
+
+        DecodeCache* getDecodeCache() { return &decode_cache_; }
+
+        // Switch between the instrumented and fast-forward fetch Actions
+        void setFastForward(const bool fast_forward);
+
       private:
         PegasusState* state_ = nullptr;
 
+        DecodeCache decode_cache_;
+
+        ActionGroup* inst_translate_action_group_ = nullptr;
+        ActionGroup* execute_action_group_ = nullptr;
+
         void onBindTreeEarly_() override;
 
+        template <bool FAST_FORWARD>
         Action::ItrType fetch_(pegasus::PegasusState* state, Action::ItrType action_it);
 
         ActionGroup fetch_action_group_{"Fetch"};
@@ -39,5 +58,13 @@ namespace pegasus
         Action::ItrType decode_(pegasus::PegasusState* state, Action::ItrType action_it);
 
         ActionGroup decode_action_group_{"Decode"};
+
+        // Prepare a previously decoded instruction to be executed again. Returns false if the
+        // instruction is illegal in the current state.
+        bool setupCachedInst_(PegasusState* state, const PegasusInstPtr & inst);
+
+        // Checks that depend on the current state and cannot be cached. Returns false if the
+        // CSR access is illegal.
+        bool checkCsrAccess_(PegasusState* state, const PegasusInstPtr & inst);
     };
 } // namespace pegasus
@@ -1,7 +1,9 @@
 #include "PegasusCore.hpp"
+#include "core/ActionProfiler.hpp"
 #include "system/PegasusSystem.hpp"
 #include "system/SystemCallEmulator.hpp"
 #include "include/gen/CSRBitMasks32.hpp"
+#include "include/PegasusSnapshot.hpp"
 
 #include "sparta/simulation/ResourceTreeNode.hpp"
 #include "sparta/utils/LogUtils.hpp"
@@ -9,6 +11,7 @@
 #include "sparta/utils/SpartaTester.hpp"
 
 #include <filesystem>
+#include <iomanip>
 #include <regex>
 
 namespace pegasus
@@ -87,12 +90,12 @@ namespace pegasus
         num_harts_(p->num_harts),
         ev_advance_sim_(&unit_event_set_, "advance_sim",
                         CREATE_SPARTA_HANDLER(PegasusCore, advanceSim_)),
+        enable_threaded_dispatch_(p->enable_threaded_dispatch),
         pause_counter_duration_(p->pause_counter_duration),
-        ev_pause_counter_expires_(
-            &unit_event_set_, "pause_counter_expires",
-            CREATE_SPARTA_HANDLER_WITH_DATA(PegasusCore, pauseCounterExpires_, HartId)),
         syscall_emulation_enabled_(
             PegasusSimParameters::getParameter<bool>(core_tn, "enable_syscall_emulation")),
+        parallel_cores_(
+            PegasusSimParameters::getParameter<bool>(core_tn, "enable_parallel_cores")),
         arch_name_(p->arch),
         profile_(p->profile),
         isa_string_(p->isa),
@@ -105,7 +108,6 @@ namespace pegasus
         extension_manager_(mavis::extension_manager::riscv::RISCVExtensionManager::fromISA(
             isa_string_, isa_file_path_ + std::string("/riscv_isa_spec.json"), isa_file_path_)),
         hypervisor_enabled_(extension_manager_.isEnabled("h")),
-        reservations_(num_harts_),
         inst_handlers_(syscall_emulation_enabled_)
     {
         // top.core*.hart*
@@ -160,7 +162,11 @@ namespace pegasus
                                             << " is not supported in isa_string: " << isa_string_);
         }
 
-        sparta::StartupEvent(core_tn, CREATE_SPARTA_HANDLER(PegasusCore, advanceSim_));
+        // Parallel cores are run by PegasusSim instead of the sparta scheduler
+        if (!parallel_cores_)
+        {
+            sparta::StartupEvent(core_tn, CREATE_SPARTA_HANDLER(PegasusCore, advanceSim_));
+        }
     }
 
     PegasusCore::~PegasusCore() {}
@@ -175,14 +181,64 @@ namespace pegasus
 
     void PegasusCore::stopSim(const int64_t exit_code)
     {
+        // The harts of a core running on another host thread are stopped by that thread at the
+        // next quantum boundary
+        if (parallel_cores_ && (std::this_thread::get_id() != host_thread_id_))
+        {
+            requested_exit_code_.store(exit_code, std::memory_order_relaxed);
+            stop_requested_.store(true, std::memory_order_release);
+            return;
+        }
+
         DLOG("Stopping simulation for all harts");
         for (auto & [hart_idx, thread] : threads_)
         {
             thread->stopSim(exit_code);
             threads_running_.reset(hart_idx);
         }
+        threads_paused_.reset();
+        threads_waiting_.reset();
+        threads_blocked_.reset();
+    }
+
+    void PegasusCore::startHart(HartId hart_id)
+    {
+        PegasusState* state = threads_.at(hart_id);
+        DLOG("Starting hart" << std::dec << hart_id << " at PC 0x" << std::hex << state->getPc());
+        state->unpauseHart();
+        state->getSimState()->sim_stopped = false;
+        threads_running_.set(hart_id);
+        scheduleAdvanceSim_();
+    }
+
+    bool PegasusCore::wakeHart(HartId hart_id)
+    {
+        if (!threads_blocked_.test(hart_id) && !threads_waiting_.test(hart_id))
+        {
+            return false;
+        }
+
+        DLOG("Waking up hart" << std::dec << hart_id);
+        threads_[hart_id]->unpauseHart();
+        threads_blocked_.reset(hart_id);
+        threads_waiting_.reset(hart_id);
+        threads_running_.set(hart_id);
+        scheduleAdvanceSim_();
+        return true;
+    }
+
+    void PegasusCore::scheduleAdvanceSim_()
+    {
+        // Parallel cores keep running quanta, and a running core reschedules itself
+        if (parallel_cores_ || in_run_hart_ || ev_advance_sim_.isScheduled())
+        {
+            return;
+        }
 
-        ev_pause_counter_expires_.cancel();
+        // The core went idle, catch up with the current cycle
+        const uint64_t current_cycle = getClock()->currentCycle();
+        setCycles_(std::max(current_cycle, threads_[0]->getSimState()->cycles));
+        ev_advance_sim_.schedule(threads_[0]->getSimState()->cycles - current_cycle);
     }
 
     void PegasusCore::onBindTreeEarly_()
@@ -190,9 +246,12 @@ namespace pegasus
         // Pegasus System (shared by all harts)
         auto root_tn = getContainer()->getParentAs<sparta::RootTreeNode>();
         system_ = root_tn->getChild("system")->getResourceAs<pegasus::PegasusSystem>();
+        reservation_table_ = system_->getReservationTable();
 
         for (uint32_t hart_idx = 0; hart_idx < num_harts_; ++hart_idx)
         {
+            reservation_idxs_.emplace_back(reservation_table_->addHart());
+
             // Get PegasusState for each hart
             const std::string hart_name = "hart" + std::to_string(hart_idx);
             const auto thread = getContainer()->getChild(hart_name);
@@ -200,7 +259,7 @@ namespace pegasus
 
             PegasusState* state = threads_.at(hart_idx);
             // This MUST be done before initializing Mavis
-            state->setPegasusCore(this);
+            state->setPegasusCore(this, hart_idx);
         }
 
         // Initialize Mavis
@@ -237,6 +296,22 @@ namespace pegasus
         system_call_emulator_ =
             root_tn->getChild("system_call_emulator")->getResourceAs<pegasus::SystemCallEmulator>();
 
+        initHarts_();
+    }
+
+    void PegasusCore::reloadWorkloads()
+    {
+        threads_running_.reset();
+        for (auto & [hart_idx, state] : threads_)
+        {
+            (void)hart_idx;
+            state->resolveSymbolTriggers();
+        }
+        initHarts_();
+    }
+
+    void PegasusCore::initHarts_()
+    {
         for (uint32_t hart_idx = 0; hart_idx < num_harts_; ++hart_idx)
         {
             PegasusState* state = threads_.at(hart_idx);
@@ -264,6 +339,16 @@ namespace pegasus
     {
         extension_manager_.switchMavisContext(*mavis_.get());
 
+        // Previously decoded instructions may no longer be valid
+        for (auto & [hart_id, state] : threads_)
+        {
+            (void)hart_id;
+            if (state->getFetchUnit())
+            {
+                state->getFetchUnit()->getDecodeCache()->flush();
+            }
+        }
+
         if (isCompressionEnabled())
         {
             setPcAlignment_(2);
@@ -324,101 +409,382 @@ namespace pegasus
         return uarch_files;
     }
 
-    // This method will execute a single thread for up to X instructions
+    // This method will execute a single running thread for up to X instructions
     // where X is the quantum for that thread. The cycle count of all threads
     // is updated to match the current thread's cycle count. Then this event
-    // is rescheduled at that cycle count.
+    // is rescheduled at that cycle count. Stopped, paused and waiting threads
+    // are skipped; if none of the threads can run, the event is rescheduled
+    // when the first pause counter expires.
     void PegasusCore::advanceSim_()
     {
+        const uint64_t current_cycle = threads_[current_hart_id_]->getSimState()->cycles;
+        wakeHarts_(current_cycle);
+
+        if (threads_running_.none())
+        {
+            if (threads_paused_.any())
+            {
+                const uint64_t wake_cycle = getNextWakeCycle_();
+                setCycles_(wake_cycle);
+                ev_advance_sim_.schedule(wake_cycle - getClock()->currentCycle());
+            }
+            return;
+        }
+
+        // Simple round robin over the running threads
+        while (!threads_running_.test(current_hart_id_))
+        {
+            ++current_hart_id_;
+            current_hart_id_ = (current_hart_id_ == num_harts_) ? 0 : current_hart_id_;
+        }
+
         PegasusState* state = threads_[current_hart_id_];
-        auto* sim_state = state->getSimState();
-        bool pause_thread = false;
-        if ((sim_state->sim_stopped == false)
-            && (sim_state->sim_pause_reason == SimPauseReason::INVALID))
+        runHart_(current_hart_id_);
+
+        // Update current cycle for all threads
+        const uint64_t next_cycle = state->getSimState()->cycles;
+        setCycles_(next_cycle);
+
+        ++current_hart_id_;
+        current_hart_id_ = (current_hart_id_ == num_harts_) ? 0 : current_hart_id_;
+
+        if (isRunning())
         {
-            DLOG("Running hart" << std::dec << current_hart_id_);
-            Fetch* fetch = state->getFetchUnit();
-            ActionGroup* next_action_group = fetch->getActionGroup();
-            while (next_action_group)
+            // Keep going!
+            ev_advance_sim_.schedule(next_cycle - getClock()->currentCycle());
+        }
+    }
+
+    // Run every hart of the core for one quantum. Used instead of the advance_sim event when the
+    // cores run on parallel host threads.
+    void PegasusCore::runQuantum()
+    {
+        host_thread_id_ = std::this_thread::get_id();
+
+        // Stops requested by other host threads are applied at the quantum boundary
+        if (SPARTA_EXPECT_FALSE(stop_requested_.load(std::memory_order_acquire)))
+        {
+            stop_requested_.store(false, std::memory_order_relaxed);
+            stopSim(requested_exit_code_.load(std::memory_order_relaxed));
+            return;
+        }
+
+        wakeHarts_(threads_[0]->getSimState()->cycles);
+
+        // Jump to the first pause counter expiration when no hart can run
+        if (threads_running_.none() && threads_paused_.any())
+        {
+            const uint64_t wake_cycle = getNextWakeCycle_();
+            setCycles_(wake_cycle);
+            wakeHarts_(wake_cycle);
+        }
+
+        for (HartId hart_id = 0; hart_id < num_harts_; ++hart_id)
+        {
+            if (threads_running_.test(hart_id))
             {
-                next_action_group = next_action_group->execute(state);
+                runHart_(hart_id);
+                setCycles_(threads_[hart_id]->getSimState()->cycles);
             }
+        }
+    }
 
-            if (sim_state->sim_stopped)
+    // Move paused harts whose pause counter expired and waiting harts with a pending interrupt
+    // back to the running harts. Waiting harts also resume when nothing else on the core can run
+    // (WFI may complete at any time).
+    void PegasusCore::wakeHarts_(const uint64_t current_cycle)
+    {
+        for (HartId hart_id = 0; hart_id < num_harts_; ++hart_id)
+        {
+            if (threads_paused_.test(hart_id) && (current_cycle >= pause_expires_[hart_id]))
             {
-                DLOG("Stopping hart" << std::dec << current_hart_id_);
-                threads_running_.reset(current_hart_id_);
+                DLOG("Pause counter expired for hart" << std::dec << hart_id);
+                threads_[hart_id]->unpauseHart();
+                threads_paused_.reset(hart_id);
+                threads_running_.set(hart_id);
             }
+        }
 
-            switch (sim_state->sim_pause_reason)
+        if (SPARTA_EXPECT_FALSE(threads_waiting_.any()))
+        {
+            const bool idle = threads_running_.none() && threads_paused_.none();
+            for (HartId hart_id = 0; hart_id < num_harts_; ++hart_id)
             {
-                case SimPauseReason::QUANTUM:
-                    state->unpauseHart();
-                    break;
-                case SimPauseReason::INTERRUPT:
-                    sparta_assert(false, "Pause reason INTERRUPT is not supported yet!");
-                    break;
-                case SimPauseReason::PAUSE:
-                    pause_thread = true;
-                    break;
-                case SimPauseReason::FORK:
-                    sparta_assert(false, "Pause reason FORK is not supported yet!");
-                    break;
-                case SimPauseReason::INVALID:
-                    break;
+                if (threads_waiting_.test(hart_id)
+                    && (idle || threads_[hart_id]->isInterruptPending()))
+                {
+                    DLOG("Waking up hart" << std::dec << hart_id);
+                    threads_[hart_id]->unpauseHart();
+                    threads_waiting_.reset(hart_id);
+                    threads_running_.set(hart_id);
+                }
             }
         }
+    }
 
-        // Update current cycle for all threads
-        const uint64_t current_cycle = sim_state->cycles;
+    uint64_t PegasusCore::getNextWakeCycle_() const
+    {
+        uint64_t wake_cycle = std::numeric_limits<uint64_t>::max();
         for (HartId hart_id = 0; hart_id < num_harts_; ++hart_id)
         {
-            threads_[hart_id]->getSimState()->cycles = current_cycle;
+            if (threads_paused_.test(hart_id))
+            {
+                wake_cycle = std::min(wake_cycle, pause_expires_[hart_id]);
+            }
         }
+        return wake_cycle;
+    }
 
-        if (pause_thread)
+    void PegasusCore::setCycles_(const uint64_t cycles)
+    {
+        for (auto & [hart_id, state] : threads_)
         {
-            DLOG("Starting pause counter for hart " << std::dec << current_hart_id_);
-            threads_running_.reset(current_hart_id_);
-            ev_pause_counter_expires_.preparePayload(current_hart_id_)
-                ->schedule(current_cycle - getClock()->currentCycle() + pause_counter_duration_);
+            (void)hart_id;
+            state->getSimState()->cycles = cycles;
         }
+    }
 
-        // Simple round robin
-        ++current_hart_id_;
-        current_hart_id_ = (current_hart_id_ == num_harts_) ? 0 : current_hart_id_;
+    PegasusCore::SnapshotHartStatus PegasusCore::getSnapshotHartStatus_(HartId hart_id) const
+    {
+        // The instruction limit only stops the hart that reached it, it was still running
+        if (threads_running_.test(hart_id)
+            || threads_.at(hart_id)->getSimState()->inst_limit_reached)
+        {
+            return SnapshotHartStatus::RUNNING;
+        }
+        if (threads_paused_.test(hart_id))
+        {
+            return SnapshotHartStatus::PAUSED;
+        }
+        if (threads_waiting_.test(hart_id))
+        {
+            return SnapshotHartStatus::WAITING;
+        }
+        if (threads_blocked_.test(hart_id))
+        {
+            return SnapshotHartStatus::BLOCKED;
+        }
+        return SnapshotHartStatus::STOPPED;
+    }
 
-        if (threads_running_.any())
+    void PegasusCore::saveSnapshot(std::ostream & os)
+    {
+        snapshot::write<uint32_t>(os, num_harts_);
+        for (auto & [hart_id, state] : threads_)
         {
-            // Keep going!
-            ev_advance_sim_.schedule(current_cycle - getClock()->currentCycle());
+            snapshot::writeTag(os, snapshot::HART_TAG);
+            const SnapshotHartStatus status = getSnapshotHartStatus_(hart_id);
+            snapshot::write(os, status);
+
+            // Pause counters are saved relative to the current cycle, cycles restart from zero
+            const uint64_t cycles = state->getSimState()->cycles;
+            const uint64_t pause_cycles =
+                ((status == SnapshotHartStatus::PAUSED) && (pause_expires_[hart_id] > cycles))
+                    ? (pause_expires_[hart_id] - cycles)
+                    : 0;
+            snapshot::write(os, pause_cycles);
+
+            const Reservation reservation = getReservation(hart_id);
+            snapshot::write(os, reservation.isValid());
+            snapshot::write<Addr>(os, reservation.isValid() ? reservation.getValue() : 0);
+
+            state->saveSnapshot(os);
+        }
+    }
+
+    void PegasusCore::restoreSnapshot(std::istream & is)
+    {
+        const uint32_t num_harts = snapshot::read<uint32_t>(is);
+        sparta_assert(num_harts == num_harts_, "Snapshot was taken with " << num_harts
+                                                   << " harts on core" << core_id_ << ", not "
+                                                   << num_harts_);
+        for (auto & [hart_id, state] : threads_)
+        {
+            snapshot::readTag(is, snapshot::HART_TAG);
+            const SnapshotHartStatus status = snapshot::read<SnapshotHartStatus>(is);
+            sparta_assert(status <= SnapshotHartStatus::STOPPED,
+                          "Snapshot has an invalid status for hart " << std::dec << hart_id);
+            const uint64_t pause_cycles = snapshot::read<uint64_t>(is);
+
+            Reservation reservation;
+            const bool reservation_valid = snapshot::read<bool>(is);
+            const Addr reservation_paddr = snapshot::read<Addr>(is);
+            if (reservation_valid)
+            {
+                reservation = reservation_paddr;
+            }
+            setReservation(hart_id, reservation);
+
+            state->restoreSnapshot(is);
+            state->unpauseHart();
+
+            // Futex queues are not saved, so blocked harts resume as if woken spuriously
+            auto* sim_state = state->getSimState();
+            sim_state->sim_stopped = (status == SnapshotHartStatus::STOPPED);
+            threads_running_.set(hart_id, (status == SnapshotHartStatus::RUNNING)
+                                              || (status == SnapshotHartStatus::BLOCKED));
+            threads_paused_.set(hart_id, status == SnapshotHartStatus::PAUSED);
+            threads_waiting_.set(hart_id, status == SnapshotHartStatus::WAITING);
+            threads_blocked_.reset(hart_id);
+            pause_expires_[hart_id] = sim_state->cycles + pause_cycles;
         }
     }
 
-    // This event will be scheduled if a thread executes an instruction
-    // that pauses it. Once the pause counter expires, this event will
-    // unpause the thread and reschedule the advance sim event.
-    void PegasusCore::pauseCounterExpires_(const HartId & hart_id)
+    void PegasusCore::reportUtilization(std::ostream & os) const
+    {
+        for (const auto & [hart_id, state] : threads_)
+        {
+            const auto* sim_state = state->getSimState();
+            const double utilization =
+                (sim_state->cycles == 0) ? 0.0
+                                         : (100.0 * sim_state->inst_count / sim_state->cycles);
+            os << "core" << std::dec << core_id_ << ".hart" << hart_id << ": " << std::fixed
+               << std::setprecision(2) << utilization << std::defaultfloat << "% utilization, "
+               << sim_state->inst_count << " instructions, " << state->getNumQuanta()
+               << " quanta, " << state->getNumSyncInsts() << " AMO/LR/SC/fence, quantum "
+               << state->getQuantumSize() << std::endl;
+        }
+    }
+
+    // Run a running hart for up to one quantum and move it to the paused, waiting or stopped
+    // harts if it did not reach the end of its quantum. The hart is identified by its index on
+    // the core, not by its mhartid parameter.
+    void PegasusCore::runHart_(const HartId hart_id)
     {
         PegasusState* state = threads_[hart_id];
-        if (state->getSimState()->sim_pause_reason == SimPauseReason::PAUSE)
+        auto* sim_state = state->getSimState();
+        DLOG("Running hart" << std::dec << hart_id);
+        if (ActionProfiler* profiler = state->getProfiler())
         {
-            DLOG("Pause counter expired for hart" << std::dec << hart_id);
-            state->unpauseHart();
-            threads_running_.set(hart_id);
-            if (ev_advance_sim_.isScheduled() == false)
-            {
-                // Update current cycle for all threads
-                const uint64_t current_cycle = getClock()->currentCycle();
-                for (HartId hart_id = 0; hart_id < num_harts_; ++hart_id)
-                {
-                    threads_[hart_id]->getSimState()->cycles = current_cycle;
-                }
+            profiler->resetTimestamp();
+        }
 
-                // Keep going!
-                ev_advance_sim_.schedule();
+        in_run_hart_ = true;
+        if (enable_threaded_dispatch_)
+        {
+            runThreaded_(state);
+        }
+        else
+        {
+            Fetch* fetch = state->getFetchUnit();
+            ActionGroup* next_action_group = fetch->getActionGroup();
+            while (next_action_group)
+            {
+                next_action_group = next_action_group->execute(state);
             }
         }
+        in_run_hart_ = false;
+
+        if (sim_state->sim_stopped)
+        {
+            DLOG("Stopping hart" << std::dec << hart_id);
+            threads_running_.reset(hart_id);
+            return;
+        }
+
+        switch (sim_state->sim_pause_reason)
+        {
+            case SimPauseReason::QUANTUM:
+                state->endQuantum();
+                state->unpauseHart();
+                break;
+            case SimPauseReason::INTERRUPT:
+                sparta_assert(false, "Pause reason INTERRUPT is not supported yet!");
+                break;
+            case SimPauseReason::PAUSE:
+                DLOG("Starting pause counter for hart " << std::dec << hart_id);
+                threads_running_.reset(hart_id);
+                threads_paused_.set(hart_id);
+                pause_expires_[hart_id] = sim_state->cycles + pause_counter_duration_;
+                break;
+            case SimPauseReason::FORK:
+                sparta_assert(false, "Pause reason FORK is not supported yet!");
+                break;
+            case SimPauseReason::WFI:
+                DLOG("Hart " << std::dec << hart_id << " is waiting for an interrupt");
+                threads_running_.reset(hart_id);
+                threads_waiting_.set(hart_id);
+                break;
+            case SimPauseReason::FUTEX:
+                DLOG("Hart " << std::dec << hart_id << " is blocked on a futex");
+                threads_running_.reset(hart_id);
+                threads_blocked_.set(hart_id);
+                break;
+            case SimPauseReason::INVALID:
+                break;
+        }
+    }
+
+    // Threaded dispatch engine. Instead of returning to advanceSim_ after every ActionGroup, the
+    // Fetch -> Translate -> Decode -> Execute -> Finish ActionGroups run in a single loop that
+    // dispatches directly to the next Action, follows the next ActionGroup when the end of a
+    // group is reached and picks up redirects (including traps) returned by Actions as status
+    // codes.
+    void PegasusCore::runThreaded_(PegasusState* state)
+    {
+        // Status after executing an Action, see dispatch targets below
+        enum DispatchStatus : uint32_t
+        {
+            NEXT_ACTION = 0b00,
+            END_OF_GROUP = 0b01,
+            REDIRECT = 0b10,
+            REDIRECT_AT_END_OF_GROUP = 0b11
+        };
+
+        ActionGroup* action_group = state->getFetchUnit()->getActionGroup();
+        Action::ItrType action_it = action_group->begin();
+        Action::ItrType end_it = action_group->end();
+
+#if defined(__GNUC__)
+        // Computed goto dispatch
+        static void* const dispatch_table[] = {&&next_action, &&end_of_group, &&redirect,
+                                               &&redirect};
+#define PEGASUS_DISPATCH(status) goto* dispatch_table[status]
+#else
+#define PEGASUS_DISPATCH(status)                                                                   \
+    switch (status)                                                                                \
+    {                                                                                              \
+        case NEXT_ACTION:                                                                          \
+            goto next_action;                                                                      \
+        case END_OF_GROUP:                                                                         \
+            goto end_of_group;                                                                     \
+        default:                                                                                   \
+            goto redirect;                                                                         \
+    }
+#endif
+
+        // Empty ActionGroups are allowed (e.g. instructions without any Actions)
+        if (SPARTA_EXPECT_FALSE(action_it == end_it))
+        {
+            goto end_of_group;
+        }
+
+    next_action:
+    {
+        // Actions are responsible for incrementing the Action iterator
+        action_it = action_it->execute(state, action_it);
+        const uint32_t status = (state->hasRedirect() ? REDIRECT : NEXT_ACTION)
+                                | ((action_it == end_it) ? END_OF_GROUP : NEXT_ACTION);
+        PEGASUS_DISPATCH(status);
+    }
+
+    end_of_group:
+        action_group = action_group->getNextActionGroupOrNull();
+        if (SPARTA_EXPECT_FALSE(action_group == nullptr))
+        {
+            return;
+        }
+        action_it = action_group->begin();
+        end_it = action_group->end();
+        PEGASUS_DISPATCH((action_it == end_it) ? END_OF_GROUP : NEXT_ACTION);
+
+    redirect:
+        action_group = state->takeRedirect();
+        action_it = action_group->begin();
+        end_it = action_group->end();
+        PEGASUS_DISPATCH((action_it == end_it) ? END_OF_GROUP : NEXT_ACTION);
+
+#undef PEGASUS_DISPATCH
     }
 
     template <bool IS_UNIT_TEST> bool PegasusCore::compare(const PegasusCore* core) const
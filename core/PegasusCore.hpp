@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <vector>
 #include <string>
 #include <cinttypes>
+#include <ostream>
+#include <thread>
 
 #include "core/PegasusAllocatorWrapper.hpp"
 #include "core/PegasusState.hpp"
@@ -11,12 +15,12 @@
 #include "core/translate/Translate.hpp"
 #include "core/Execute.hpp"
 #include "core/Exception.hpp"
+#include "system/ReservationTable.hpp"
 
 #include "mavis/mavis/extension_managers/RISCVExtensionManager.hpp"
 
 #include "sparta/simulation/ResourceFactory.hpp"
 #include "sparta/events/Event.hpp"
-#include "sparta/events/PayloadEvent.hpp"
 
 template <class InstT, class ExtenT, class InstTypeAllocator, class ExtTypeAllocator> class Mavis;
 
@@ -52,6 +56,9 @@ namespace pegasus
             PARAMETER(std::string, isa_file_path, "mavis_json", "Where are the Mavis isa files?")
             PARAMETER(std::string, uarch_file_path, "arch", "Where are the Pegasus uarch files?")
             PARAMETER(uint64_t, pause_counter_duration, 256, "Pause counter duration in cycles")
+            PARAMETER(bool, enable_threaded_dispatch, false,
+                      "Run the ActionGroups in a single threaded dispatch loop instead of "
+                      "returning to the core after every ActionGroup")
 
           private:
             static bool validateProfile_(std::string & profile, const sparta::TreeNode*)
@@ -72,6 +79,45 @@ namespace pegasus
 
         void stopSim(const int64_t exit_code);
 
+        // Run every hart for one quantum on the calling host thread (enable_parallel_cores)
+        void runQuantum();
+
+        // Does any hart still need to run?
+        bool isRunning() const
+        {
+            return threads_running_.any() || threads_paused_.any() || threads_waiting_.any()
+                   || stop_requested_.load(std::memory_order_acquire);
+        }
+
+        // Are the cores running on parallel host threads?
+        bool isParallel() const { return parallel_cores_; }
+
+        // Is the hart stopped and free to run a new thread (system call emulation)?
+        bool isHartIdle(HartId hart_id) const
+        {
+            return threads_.at(hart_id)->getSimState()->sim_stopped
+                   && !threads_blocked_.test(hart_id) && !threads_waiting_.test(hart_id);
+        }
+
+        // Start running an idle hart from its current PC
+        void startHart(HartId hart_id);
+
+        // Resume a hart blocked on a futex or waiting for an interrupt. Returns false if the hart
+        // was not blocked or waiting.
+        bool wakeHart(HartId hart_id);
+
+        // Save/restore the state of every hart and which harts are running. Restoring does not
+        // schedule anything, it is done before the simulation starts.
+        void saveSnapshot(std::ostream & os);
+        void restoreSnapshot(std::istream & is);
+
+        // The system reloaded its workloads before the simulation started (batch mode), set up
+        // the harts for the new workloads
+        void reloadWorkloads();
+
+        // Print the share of the core's cycles each hart spent executing instructions
+        void reportUtilization(std::ostream & os) const;
+
         CoreId getCoreId() const { return core_id_; }
 
         uint32_t getNumThreads() const { return num_harts_; }
@@ -127,35 +173,38 @@ namespace pegasus
 
         uint64_t getPcAlignmentMask() const { return pc_alignment_mask_; }
 
-        using Reservation = sparta::utils::ValidValue<Addr>;
+        // LR/SC reservations are kept in the system-wide ReservationTable. Harts are identified
+        // by their index on this core (PegasusState::getCoreHartIdx), not by their mhartid.
+        using Reservation = ReservationTable::Reservation;
 
         void makeReservation(HartId hart_id, Addr paddr)
         {
+            reservation_table_->makeReservation(reservation_idxs_[hart_id], paddr);
+        }
 
-            for (uint32_t hart_id = 0; hart_id < num_harts_; ++hart_id)
-            {
-                auto & reservation = reservations_.at(hart_id);
-                if (reservation.isValid() && (reservation.getValue() == paddr))
-                {
-                    reservation.clearValid();
-                }
-            }
-            reservations_.at(hart_id) = paddr;
+        // Returns true if the hart's reservation was still valid for paddr. Always clears the
+        // hart's reservation. SCs hold the system memory lock across this and their store, so
+        // the store invalidates the other harts before any of them can check their reservation.
+        bool consumeReservation(HartId hart_id, Addr paddr)
+        {
+            return reservation_table_->consumeReservation(reservation_idxs_[hart_id], paddr);
         }
 
-        Reservation & getReservation(HartId hart_id) { return reservations_.at(hart_id); }
+        Reservation getReservation(HartId hart_id) const
+        {
+            return reservation_table_->getReservation(reservation_idxs_.at(hart_id));
+        }
 
-        const Reservation & getReservation(HartId hart_id) const
+        void setReservation(HartId hart_id, const Reservation & reservation)
         {
-            return reservations_.at(hart_id);
+            reservation_table_->setReservation(reservation_idxs_.at(hart_id), reservation);
         }
 
-        void clearReservations()
+        // A hart stored to memory, invalidate the reservations of all other harts in the system
+        // on the same cache line(s)
+        void invalidateReservations(HartId hart_id, Addr paddr, size_t size)
         {
-            for (auto & reservation : reservations_)
-            {
-                reservation.clearValid();
-            }
+            reservation_table_->invalidate(reservation_idxs_[hart_id], paddr, size);
         }
 
         const InstHandlers* getInstHandlers() const { return &inst_handlers_; }
@@ -168,6 +217,9 @@ namespace pegasus
         void onBindTreeEarly_() override;
         void onBindTreeLate_() override;
 
+        // Set up the program stack and starting PC of the harts that run a workload
+        void initHarts_();
+
         sparta::ResourceFactory<pegasus::PegasusState,
                                 pegasus::PegasusState::PegasusStateParameters>
             state_factory_;
@@ -198,19 +250,53 @@ namespace pegasus
         // Execute the threads on this core
         void advanceSim_();
         sparta::Event<> ev_advance_sim_;
+        void runHart_(const HartId hart_id);
+        void wakeHarts_(const uint64_t current_cycle);
+        uint64_t getNextWakeCycle_() const;
+        void setCycles_(const uint64_t cycles);
+
+        // Threaded dispatch engine
+        const bool enable_threaded_dispatch_;
+        void runThreaded_(PegasusState* state);
 
         // Pause counter
         const uint64_t pause_counter_duration_;
-        void pauseCounterExpires_(const HartId & hart_id);
-        sparta::PayloadEvent<HartId> ev_pause_counter_expires_;
 
-        // Status of each thread
+        // Status of each thread. Paused threads resume at their pause_expires_ cycle, waiting
+        // threads (WFI) when an interrupt is pending or no other thread can run.
         HartId current_hart_id_ = 0;
         std::bitset<8> threads_running_;
+        std::bitset<8> threads_paused_;
+        std::bitset<8> threads_waiting_;
+        std::bitset<8> threads_blocked_;
+
+        // Set while a hart of this core executes; advanceSim_ reschedules itself afterwards
+        bool in_run_hart_ = false;
+        void scheduleAdvanceSim_();
+        std::array<uint64_t, 8> pause_expires_{};
+
+        // Scheduling status of a hart in a snapshot
+        enum class SnapshotHartStatus : uint8_t
+        {
+            RUNNING,
+            PAUSED,
+            WAITING,
+            BLOCKED,
+            STOPPED
+        };
+        SnapshotHartStatus getSnapshotHartStatus_(HartId hart_id) const;
 
         // Is system call emulation enabled?
         const bool syscall_emulation_enabled_;
 
+        // Cores run on parallel host threads (see PegasusSim::runParallel_)
+        const bool parallel_cores_;
+        std::thread::id host_thread_id_;
+
+        // Stop requested from another core's host thread
+        std::atomic<bool> stop_requested_{false};
+        std::atomic<int64_t> requested_exit_code_{0};
+
         // Arch name
         // FIXME: We should be able to get this from Sparta --arch
         const std::string arch_name_;
@@ -271,8 +357,9 @@ namespace pegasus
             pc_alignment_mask_ = ~(pc_alignment - 1);
         }
 
-        //! LR/SC Reservations
-        std::vector<Reservation> reservations_;
+        //! LR/SC Reservations (owned by PegasusSystem), indexed by the table slot of each hart
+        ReservationTable* reservation_table_ = nullptr;
+        std::vector<uint32_t> reservation_idxs_;
 
         // Instruction Actions
         InstHandlers inst_handlers_;
@@ -33,7 +33,8 @@ namespace pegasus
         is_cof_inst_(getUarchJsonValue<bool, true>(uarch_json, "cof")),
         is_hypervisor_inst_(getUarchJsonValue<bool, true>(uarch_json, "hypervisor")),
         veccfg_(getJsonVecCfg(uarch_json)),
-        inst_action_group_(mnemonic_)
+        inst_action_group_(mnemonic_),
+        linked_actions_(core->getNumThreads())
     {
         const auto xlen = core->getXlen();
         const InstHandlers::InstHandlersMap* inst_compute_address_handlers =
@@ -2,6 +2,7 @@
 
 #include "core/ActionGroup.hpp"
 #include "core/VecConfigOverride.hpp"
+#include "include/PegasusTypes.hpp"
 #include "mavis/JSONUtils.hpp"
 #include "sparta/utils/SpartaSharedPointerAllocator.hpp"
 
@@ -32,6 +33,27 @@ namespace pegasus
 
         bool isHypervisorInst() const { return is_hypervisor_inst_; }
 
+        // Instruction Actions with the translate and observer Actions of a hart linked in by
+        // Execute. Mavis shares extractors between the harts of a core, so each hart has its
+        // own copy, indexed by PegasusState::getCoreHartIdx(). The Actions are stale if the
+        // version does not match the hart's current PegasusState::getInstActionsVersion().
+        struct LinkedActions
+        {
+            std::vector<Action> actions;
+            uint64_t version = 0;
+        };
+
+        LinkedActions & getLinkedActions(const HartId core_hart_idx)
+        {
+            return linked_actions_.at(core_hart_idx);
+        }
+
+        // Instruction handler Actions before linking
+        const std::vector<Action> & getInstActions() const
+        {
+            return inst_action_group_.getActions();
+        }
+
       private:
         const std::string mnemonic_;
         const std::string inst_handler_name_;
@@ -43,6 +65,8 @@ namespace pegasus
 
         ActionGroup inst_action_group_;
 
+        std::vector<LinkedActions> linked_actions_;
+
         friend class PegasusInst;
     };
 
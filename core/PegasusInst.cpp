@@ -87,8 +87,22 @@ namespace pegasus
         rs3_reg_(state->getSpartaRegister(rs3_info_)),
         rd_reg_(state->getSpartaRegister(rd_info_)),
         rd2_reg_(state->getSpartaRegister(rd2_info_)),
-        inst_action_group_(extractor_info_->inst_action_group_)
+        inst_action_group_(extractor_info_->getName())
     {
+        // Start from the Actions Execute has already linked for this instruction if they are
+        // current. CSR update Actions are specific to each instruction so they are always linked
+        // by Execute.
+        const PegasusExtractor::LinkedActions & linked_actions =
+            extractor_info_->getLinkedActions(state->getCoreHartIdx());
+        if ((linked_actions.version == state->getInstActionsVersion()) && !writesCsr())
+        {
+            inst_action_group_.setActions(linked_actions.actions);
+            actions_version_ = linked_actions.version;
+        }
+        else
+        {
+            inst_action_group_.setActions(extractor_info_->getInstActions());
+        }
     }
 
     PegasusInst::~PegasusInst() = default;
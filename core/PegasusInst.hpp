@@ -208,6 +208,13 @@ namespace pegasus
 
         const ActionGroup* getActionGroup() const { return &inst_action_group_; }
 
+        // Version of the linked Actions in the ActionGroup (see Execute)
+        uint64_t getActionsVersion() const { return actions_version_; }
+
+        void setActionsVersion(const uint64_t version) { actions_version_ = version; }
+
+        PegasusExtractor* getExtractorInfo() const { return extractor_info_.get(); }
+
         const VectorConfig* getVecConfig() const { return &vec_config_; }
 
         VectorConfig* getVecConfig() { return &vec_config_; }
@@ -267,6 +274,9 @@ namespace pegasus
 
         ActionGroup inst_action_group_;
 
+        // 0 if Execute has not linked the translate/observer/CSR Actions into the ActionGroup
+        uint64_t actions_version_ = 0;
+
         friend std::ostream & operator<<(std::ostream & os, const PegasusInst & inst);
     };
 
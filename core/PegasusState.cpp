@@ -6,8 +6,11 @@
 #include "core/Execute.hpp"
 #include "core/translate/Translate.hpp"
 #include "core/Exception.hpp"
+#include "core/ActionProfiler.hpp"
+#include "core/BBVCollector.hpp"
 #include "include/ActionTags.hpp"
 #include "include/PegasusUtils.hpp"
+#include "include/PegasusSnapshot.hpp"
 #include "system/PegasusSystem.hpp"
 #include "core/observers/SimController.hpp"
 #include "core/observers/InstructionLogger.hpp"
@@ -22,6 +25,7 @@
 #include "sparta/utils/SpartaTester.hpp"
 
 #include <algorithm>
+#include <bit>
 
 namespace pegasus
 {
@@ -62,13 +66,36 @@ namespace pegasus
         reg_json_file_path_(p->reg_json_file_path),
         ilimit_(getInstLimit(hart_tn->getRoot(), p->ilimit)),
         quantum_(p->quantum),
+        adaptive_quantum_(p->adaptive_quantum),
+        min_quantum_(p->min_quantum),
+        max_quantum_(p->max_quantum),
+        current_quantum_(quantum_),
+        quantum_end_(quantum_),
         stop_sim_on_wfi_(p->stop_sim_on_wfi),
+        fast_forward_insts_(p->fast_forward_insts),
+        fast_forward_pc_((p->fast_forward_pc == 0) ? std::numeric_limits<Addr>::max()
+                                                   : p->fast_forward_pc),
+        fast_forward_to_tracepoint_(p->fast_forward_to_tracepoint),
+        fast_forward_symbol_(p->fast_forward_symbol),
+        roi_end_insts_(p->roi_end_insts),
+        roi_end_pc_((p->roi_end_pc == 0) ? std::numeric_limits<Addr>::max() : p->roi_end_pc),
+        roi_end_at_tracepoint_(p->roi_end_at_tracepoint),
+        roi_end_symbol_(p->roi_end_symbol),
+        profiler_(p->enable_profiler ? std::make_unique<ActionProfiler>() : nullptr),
+        profiler_report_(p->profiler_report),
+        bbv_collector_((p->bbv_interval > 0)
+                           ? std::make_unique<BBVCollector>(p->bbv_interval, p->bbv_filename,
+                                                            p->bbv_simpoints)
+                           : nullptr),
         stf_filename_(p->stf_filename),
+        stf_buffer_size_(p->stf_buffer_size),
         validation_stf_filename_(p->validate_with_stf),
         validate_trace_begin_(p->validate_trace_begin),
         validate_inst_begin_(p->validate_inst_begin),
         ulimit_stack_size_(p->ulimit_stack_size),
+        enable_fast_memory_(p->enable_fast_memory),
         priv_mode_(getPrivilegeMode(p->priv_mode)),
+        vec_reg_file_(vlen_ / 8),
         inst_logger_(hart_tn, "inst", "Pegasus Instruction Logger"),
         stf_valid_logger_(hart_tn, "stf_valid", "Pegasus STF Validator Logger"),
         finish_action_group_("finish_inst"),
@@ -102,23 +129,39 @@ namespace pegasus
         add_registers(vec_rset_);
         add_registers(csr_rset_);
 
-        // Increment PC Action
+        // Start from the initial values of the vector registers
+        syncVecRegsFromSparta();
+
+        // Increment PC Actions for the instrumented and fast-forward modes
         const bool CHECK_ILIMIT = ilimit_ > 0;
         if (CHECK_ILIMIT)
         {
-            increment_pc_action_ = pegasus::Action::createAction<&PegasusState::incrementPc_<true>>(
-                this, "increment pc");
+            increment_pc_action_ =
+                pegasus::Action::createAction<&PegasusState::incrementPc_<true, false>>(
+                    this, "increment pc", ActionTags::INCREMENT_PC_TAG);
+            fast_forward_increment_pc_action_ =
+                pegasus::Action::createAction<&PegasusState::incrementPc_<true, true>>(
+                    this, "increment pc (fast-forward)", ActionTags::INCREMENT_PC_TAG);
         }
         else
         {
             increment_pc_action_ =
-                pegasus::Action::createAction<&PegasusState::incrementPc_<false>>(this,
-                                                                                  "increment pc");
+                pegasus::Action::createAction<&PegasusState::incrementPc_<false, false>>(
+                    this, "increment pc", ActionTags::INCREMENT_PC_TAG);
+            fast_forward_increment_pc_action_ =
+                pegasus::Action::createAction<&PegasusState::incrementPc_<false, true>>(
+                    this, "increment pc (fast-forward)", ActionTags::INCREMENT_PC_TAG);
         }
 
         // Add increment PC Action to finish ActionGroup
         finish_action_group_.addAction(increment_pc_action_);
 
+        // Basic blocks are tracked in both the instrumented and fast-forward modes
+        if (bbv_collector_)
+        {
+            finish_action_group_.addAction(bbv_collector_->getAction());
+        }
+
         // Create Action to stop simulation
         stop_action_ = pegasus::Action::createAction<&PegasusState::stopSim_>(this, "stop sim");
         stop_action_.addTag(ActionTags::STOP_SIM_TAG);
@@ -130,6 +173,9 @@ namespace pegasus
 
         // Update VectorConfig vlen
         vector_config_.setVLEN(vlen_);
+
+        sparta_assert(!adaptive_quantum_ || ((min_quantum_ > 0) && (min_quantum_ <= max_quantum_)),
+                      "Invalid adaptive quantum range: " << min_quantum_ << " to " << max_quantum_);
     }
 
     // Not default -- defined in source file to reduce massive inlining
@@ -197,9 +243,15 @@ namespace pegasus
             }
         }
 
-        if (!stf_filename_.empty())
+        resolveSymbolTriggers();
+
+        // With a fast-forward trigger, the STF trace starts at the handoff
+        const bool fast_forward_at_start = (fast_forward_insts_ > 0)
+                                           || (fast_forward_pc_ != std::numeric_limits<Addr>::max())
+                                           || fast_forward_to_tracepoint_;
+        if (!stf_filename_.empty() && !fast_forward_at_start)
         {
-            addObserver(std::make_unique<STFLogger>(xlen_, pc_, stf_filename_, this));
+            startStfTrace_();
         }
 
         if (!validation_stf_filename_.empty())
@@ -217,6 +269,27 @@ namespace pegasus
                     validate_trace_begin_, validate_inst_begin_));
             }
         }
+
+        // Start in fast-forward mode if any handoff trigger is set
+        if (fast_forward_at_start)
+        {
+            enterFastForward();
+        }
+
+        // Instruction ActionGroups are instrumented by Execute when their Actions are linked
+        if (profiler_)
+        {
+            profiler_->instrument(fetch_unit_->getActionGroup());
+            profiler_->instrument(translate_unit_->getExecuteTranslateActionGroup());
+            if (pegasus_core_->hasHypervisor())
+            {
+                profiler_->instrument(translate_unit_->getExecuteTranslateActionGroup(true));
+            }
+            profiler_->instrument(fetch_unit_->getDecodeActionGroup());
+            profiler_->instrument(execute_unit_->getActionGroup());
+            profiler_->instrument(exception_unit_->getActionGroup());
+            profiler_->instrument(&finish_action_group_);
+        }
     }
 
     void PegasusState::setPrivMode(PrivMode priv_mode, bool virt_mode)
@@ -225,6 +298,12 @@ namespace pegasus
                       "Attempting to change privilege mode to an unsupported mode: " << priv_mode);
         virtual_mode_ = virt_mode && (priv_mode != PrivMode::MACHINE);
         priv_mode_ = priv_mode;
+
+        // Next fetch must be translated in the new context
+        if (fetch_unit_)
+        {
+            fetch_unit_->getDecodeCache()->resetCursor();
+        }
     }
 
     template <typename XLEN>
@@ -243,13 +322,14 @@ namespace pegasus
         };
 
         const uint32_t ATP_CSR = Translate::getAtpCsr(stage);
-        const uint32_t atp_mode_val = READ_CSR_FIELD<XLEN>(this, ATP_CSR, "mode");
+        // The MODE and PPN fields are in the same place in satp, vsatp and hgatp
+        const uint32_t atp_mode_val = READ_CSR_FIELD<XLEN>(this, ATP_CSR, CSR::SATP::MODE);
         sparta_assert(atp_mode_val < mmu_mode_map.size(), "atp mode: " << atp_mode_val);
         const translate_types::TranslationMode mode = mmu_mode_map[atp_mode_val];
 
         // FIXME: Hypervisor does not support MPRV yet
-        const uint32_t mprv_val = READ_CSR_FIELD<XLEN>(this, MSTATUS, "mprv");
-        const PrivMode prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(this, MSTATUS, "mpp");
+        const uint32_t mprv_val = READ_CSR_FIELD<XLEN>(this, CSR::MSTATUS::MPRV);
+        const PrivMode prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(this, CSR::MSTATUS::MPP);
         ldst_priv_modes_.at(static_cast<uint32_t>(stage)) =
             (mprv_val == 1) ? prev_priv_mode : priv_mode_;
         const translate_types::TranslationMode ls_mode =
@@ -259,25 +339,45 @@ namespace pegasus
 
         DLOG_CODE_BLOCK(DLOG_OUTPUT(stage << " MMU Mode: " << mode);
                         DLOG_OUTPUT(stage << " MMU LS Mode: " << ls_mode););
+
+        // The mapping of the next PC may have changed
+        if (fetch_unit_)
+        {
+            fetch_unit_->getDecodeCache()->resetCursor();
+        }
+
+        // Let the TLBs know which address space is active
+        const uint32_t atp_id =
+            (stage == translate_types::TranslationStage::GUEST)
+                ? READ_CSR_FIELD<XLEN>(this, ATP_CSR, CSR::HGATP::VMID)
+                : READ_CSR_FIELD<XLEN>(this, ATP_CSR, CSR::SATP::ASID);
+        translate_unit_->updateAtp(stage, mode, atp_id,
+                                   READ_CSR_FIELD<XLEN>(this, ATP_CSR, CSR::SATP::PPN));
+
+        bool translate_actions_changed = false;
         switch (stage)
         {
             case translate_types::TranslationStage::SUPERVISOR:
-                translate_unit_
-                    ->updateTranslationMode<XLEN, translate_types::TranslationStage::SUPERVISOR>(
-                        mode, ls_mode);
+                translate_actions_changed = translate_unit_->updateTranslationMode<
+                    XLEN, translate_types::TranslationStage::SUPERVISOR>(mode, ls_mode);
                 break;
             case translate_types::TranslationStage::VIRTUAL_SUPERVISOR:
-                translate_unit_->updateTranslationMode<
+                translate_actions_changed = translate_unit_->updateTranslationMode<
                     XLEN, translate_types::TranslationStage::VIRTUAL_SUPERVISOR>(mode, ls_mode);
                 break;
             case translate_types::TranslationStage::GUEST:
-                translate_unit_
-                    ->updateTranslationMode<XLEN, translate_types::TranslationStage::GUEST>(
-                        mode, ls_mode);
+                translate_actions_changed = translate_unit_->updateTranslationMode<
+                    XLEN, translate_types::TranslationStage::GUEST>(mode, ls_mode);
                 break;
             case translate_types::TranslationStage::INVALID:
                 sparta_assert(false, "Translation stage cannot be INVALID!");
         }
+
+        // Instructions must relink their Actions with the new translate Actions
+        if (translate_actions_changed)
+        {
+            ++inst_actions_version_;
+        }
     }
 
     void PegasusState::pauseHart(const SimPauseReason reason)
@@ -292,11 +392,34 @@ namespace pegasus
     void PegasusState::unpauseHart()
     {
         sim_state_.sim_pause_reason = SimPauseReason::INVALID;
+        quantum_end_ = sim_state_.inst_count + current_quantum_;
         // We replace the next ActionGroup pointer to pause the sim, so it needs to
         // be set back to Fetch
         finish_action_group_.setNextActionGroup(fetch_unit_->getActionGroup());
     }
 
+    void PegasusState::endQuantum()
+    {
+        ++num_quanta_;
+        if (adaptive_quantum_)
+        {
+            // Halve the quantum after synchronizing with other harts, double it otherwise
+            current_quantum_ = (quantum_sync_insts_ > 0)
+                                   ? std::max(current_quantum_ / 2, min_quantum_)
+                                   : std::min(current_quantum_ * 2, max_quantum_);
+        }
+        quantum_sync_insts_ = 0;
+    }
+
+    bool PegasusState::isInterruptPending()
+    {
+        if (xlen_ == 64)
+        {
+            return (READ_CSR_REG<RV64>(this, MIP) & READ_CSR_REG<RV64>(this, MIE)) != 0;
+        }
+        return (READ_CSR_REG<RV32>(this, MIP) & READ_CSR_REG<RV32>(this, MIE)) != 0;
+    }
+
     sparta::Register* PegasusState::getSpartaRegister(const mavis::OperandInfo::Element* operand)
     {
         if (operand)
@@ -323,6 +446,8 @@ namespace pegasus
 
     Action::ItrType PegasusState::preExecute_(PegasusState* state, Action::ItrType action_it)
     {
+        // Observers read the vector registers from the Sparta registers
+        syncVecRegsToSparta();
         for (const auto & observer : observers_)
         {
             observer->preExecute(state);
@@ -333,6 +458,7 @@ namespace pegasus
 
     Action::ItrType PegasusState::postExecute_(PegasusState* state, Action::ItrType action_it)
     {
+        syncVecRegsToSparta();
         for (const auto & observer : observers_)
         {
             observer->postExecute(state);
@@ -343,6 +469,7 @@ namespace pegasus
 
     Action::ItrType PegasusState::preException_(PegasusState* state, Action::ItrType action_it)
     {
+        syncVecRegsToSparta();
         for (const auto & observer : observers_)
         {
             observer->preException(state);
@@ -351,6 +478,29 @@ namespace pegasus
         return ++action_it;
     }
 
+    void PegasusState::syncVecRegsToSparta_()
+    {
+        uint32_t dirty_regs = vec_reg_file_.getDirtyRegs();
+        while (dirty_regs != 0)
+        {
+            const uint32_t reg_num = std::countr_zero(dirty_regs);
+            dirty_regs &= dirty_regs - 1;
+            const std::span<const uint8_t> value = vec_reg_file_.getRegGroup(reg_num, 1);
+            vec_rset_->getRegister(reg_num)->poke(value.data(), value.size(), 0);
+        }
+        vec_reg_file_.clearDirtyRegs();
+    }
+
+    void PegasusState::syncVecRegsFromSparta()
+    {
+        for (uint32_t reg_num = 0; reg_num < VecRegFile::NUM_REGS; ++reg_num)
+        {
+            const std::span<uint8_t> value = vec_reg_file_.getMutableRegGroup(reg_num, 1);
+            vec_rset_->getRegister(reg_num)->peek(value.data(), value.size(), 0);
+        }
+        vec_reg_file_.clearDirtyRegs();
+    }
+
     void PegasusState::enableInteractiveMode()
     {
         sparta_assert(sim_controller_ == nullptr, "Interactive mode is already enabled");
@@ -379,24 +529,70 @@ namespace pegasus
         return reg;
     }
 
+    uint8_t* PegasusState::getHostPointer_(const Addr paddr, const size_t size)
+    {
+        constexpr Addr BLOCK_SIZE = PegasusSystem::PEGASUS_SYSTEM_BLOCK_SIZE;
+        const Addr block = paddr / BLOCK_SIZE;
+        const Addr offset = paddr % BLOCK_SIZE;
+
+        // Accesses that cross a block go through the memory map
+        if (SPARTA_EXPECT_FALSE((offset + size) > BLOCK_SIZE))
+        {
+            return nullptr;
+        }
+
+        HostBlockCacheEntry & entry = host_block_cache_[block % HOST_BLOCK_CACHE_SIZE];
+        if (SPARTA_EXPECT_FALSE(entry.block != block))
+        {
+            PegasusSystem* system = pegasus_core_->getSystem();
+            const auto lock = system->lockMemory();
+            uint8_t* host = system->getHostBlock(paddr);
+            if (host == nullptr)
+            {
+                return nullptr;
+            }
+            entry.block = block;
+            entry.host = host;
+        }
+        return entry.host + offset;
+    }
+
     template <typename MemoryType>
     MemoryType PegasusState::readMemory(const PegasusTranslationState::TranslationResult & result,
                                         const MemAccessSource source)
     {
-        auto* memory = pegasus_core_->getSystem()->getSystemMemory();
+        PegasusSystem* system = pegasus_core_->getSystem();
 
         static_assert(std::is_trivial<MemoryType>());
         static_assert(std::is_standard_layout<MemoryType>());
         const size_t size = sizeof(MemoryType);
-        std::vector<uint8_t> buffer(sizeof(MemoryType) / sizeof(uint8_t), 0);
-        const MemorySupplement supplement{result.getPAddr(), result.getVAddr(), source};
-        const bool success = memory->tryRead(result.getPAddr(), size, buffer.data(), &supplement);
-        sparta_assert(success,
-                      "Failed to read from memory at address 0x" << std::hex << result.getPAddr());
+        const Addr paddr = result.getPAddr();
+        MemoryType value;
+
+        const uint8_t* host_ptr = nullptr;
+        // Observers are detached while fast-forwarding
+        if (SPARTA_EXPECT_TRUE(enable_fast_memory_
+                               && (fast_forward_ || !system->hasMemoryObservers())))
+        {
+            host_ptr = getHostPointer_(paddr, size);
+        }
+
+        if (SPARTA_EXPECT_TRUE(host_ptr != nullptr))
+        {
+            std::memcpy(&value, host_ptr, size);
+        }
+        else
+        {
+            const auto lock = system->lockMemory();
+            auto* memory = system->getSystemMemory();
+            const MemorySupplement supplement{paddr, result.getVAddr(), source};
+            const bool success =
+                memory->tryRead(paddr, size, reinterpret_cast<uint8_t*>(&value), &supplement);
+            sparta_assert(success, "Failed to read from memory at address 0x" << std::hex << paddr);
+        }
 
-        const MemoryType value = convertFromByteVector<MemoryType>(buffer);
         ILOG("Memory read (" << source << ", " << std::dec << size << "B) to 0x" << std::hex
-                             << result.getPAddr() << ": 0x" << (uint64_t)value);
+                             << paddr << ": 0x" << (uint64_t)value);
         return value;
     }
 
@@ -412,19 +608,54 @@ namespace pegasus
     void PegasusState::writeMemory(const PegasusTranslationState::TranslationResult & result,
                                    const MemoryType value, const MemAccessSource source)
     {
-        auto* memory = pegasus_core_->getSystem()->getSystemMemory();
+        PegasusSystem* system = pegasus_core_->getSystem();
 
         static_assert(std::is_trivial<MemoryType>());
         static_assert(std::is_standard_layout<MemoryType>());
         const size_t size = sizeof(MemoryType);
-        const std::vector<uint8_t> buffer = convertToByteVector<MemoryType>(value);
-        const MemorySupplement supplement{result.getPAddr(), result.getVAddr(), source};
-        const bool success = memory->tryWrite(result.getPAddr(), size, buffer.data(), &supplement);
-        sparta_assert(success,
-                      "Failed to write to memory at address 0x" << std::hex << result.getPAddr());
+        const Addr paddr = result.getPAddr();
+
+        uint8_t* host_ptr = nullptr;
+        // Observers are detached while fast-forwarding
+        if (SPARTA_EXPECT_TRUE(enable_fast_memory_
+                               && (fast_forward_ || !system->hasMemoryObservers())))
+        {
+            host_ptr = getHostPointer_(paddr, size);
+        }
+
+        if (SPARTA_EXPECT_TRUE(host_ptr != nullptr))
+        {
+            std::memcpy(host_ptr, &value, size);
+        }
+        else
+        {
+            const auto lock = system->lockMemory();
+            auto* memory = system->getSystemMemory();
+            const MemorySupplement supplement{paddr, result.getVAddr(), source};
+            const bool success = memory->tryWrite(
+                paddr, size, reinterpret_cast<const uint8_t*>(&value), &supplement);
+            sparta_assert(success, "Failed to write to memory at address 0x" << std::hex << paddr);
+        }
+
+        pegasus_core_->invalidateReservations(core_hart_idx_, paddr, size);
 
         ILOG("Memory write (" << source << ", " << std::dec << size << "B) to 0x" << std::hex
-                              << result.getPAddr() << ": 0x" << (uint64_t)value);
+                              << paddr << ": 0x" << (uint64_t)value);
+
+        // Drop any decoded instructions from the page(s) that were written
+        if (fetch_unit_)
+        {
+            DecodeCache* decode_cache = fetch_unit_->getDecodeCache();
+            const Addr last_paddr = result.getPAddr() + size - 1;
+            if (SPARTA_EXPECT_FALSE(decode_cache->isCodePage(result.getPAddr())))
+            {
+                decode_cache->invalidatePage(result.getPAddr());
+            }
+            if (SPARTA_EXPECT_FALSE(decode_cache->isCodePage(last_paddr)))
+            {
+                decode_cache->invalidatePage(last_paddr);
+            }
+        }
     }
 
     template <typename MemoryType>
@@ -436,6 +667,59 @@ namespace pegasus
         writeMemory<MemoryType>(result, value, source);
     }
 
+    uint8_t* PegasusState::getHostMemory(const Addr paddr, const size_t size)
+    {
+        // Observers are detached while fast-forwarding
+        if (!enable_fast_memory_
+            || (!fast_forward_ && pegasus_core_->getSystem()->hasMemoryObservers()))
+        {
+            return nullptr;
+        }
+        return getHostPointer_(paddr, size);
+    }
+
+    void PegasusState::hostMemoryWritten(const Addr paddr, const size_t size)
+    {
+        pegasus_core_->invalidateReservations(core_hart_idx_, paddr, size);
+
+        // getHostPointer_ rejects accesses that cross a 4K block, so this is a single page
+        if (fetch_unit_)
+        {
+            DecodeCache* decode_cache = fetch_unit_->getDecodeCache();
+            if (SPARTA_EXPECT_FALSE(decode_cache->isCodePage(paddr)))
+            {
+                decode_cache->invalidatePage(paddr);
+            }
+        }
+    }
+
+    bool PegasusState::readMemoryBlock(const Addr paddr, void* data, const size_t size)
+    {
+        const uint8_t* host_ptr = getHostMemory(paddr, size);
+        if (host_ptr == nullptr)
+        {
+            return false;
+        }
+        std::memcpy(data, host_ptr, size);
+
+        ILOG("Memory block read (" << std::dec << size << "B) to 0x" << std::hex << paddr);
+        return true;
+    }
+
+    bool PegasusState::writeMemoryBlock(const Addr paddr, const void* data, const size_t size)
+    {
+        uint8_t* host_ptr = getHostMemory(paddr, size);
+        if (host_ptr == nullptr)
+        {
+            return false;
+        }
+        std::memcpy(host_ptr, data, size);
+        hostMemoryWritten(paddr, size);
+
+        ILOG("Memory block write (" << std::dec << size << "B) to 0x" << std::hex << paddr);
+        return true;
+    }
+
 #define INSTANTIATE_READ_MEMORY_METHODS(SIZE)                                                      \
     template SIZE PegasusState::readMemory<SIZE>(                                                  \
         const PegasusTranslationState::TranslationResult &, const MemAccessSource);                \
@@ -464,16 +748,25 @@ namespace pegasus
     {
         if (observers_.empty())
         {
-            pre_execute_action_ =
-                pegasus::Action::createAction<&PegasusState::preExecute_>(this, "pre execute");
-            post_execute_action_ =
-                pegasus::Action::createAction<&PegasusState::postExecute_>(this, "post execute");
-            pre_exception_action_ =
-                pegasus::Action::createAction<&PegasusState::preException_>(this, "pre exception");
+            pre_execute_action_ = pegasus::Action::createAction<&PegasusState::preExecute_>(
+                this, "pre execute", ActionTags::OBSERVER_TAG);
+            post_execute_action_ = pegasus::Action::createAction<&PegasusState::postExecute_>(
+                this, "post execute", ActionTags::OBSERVER_TAG);
+            pre_exception_action_ = pegasus::Action::createAction<&PegasusState::preException_>(
+                this, "pre exception", ActionTags::OBSERVER_TAG);
 
-            finish_action_group_.addAction(post_execute_action_);
-            exception_unit_->getActionGroup()->insertActionBefore(pre_exception_action_,
-                                                                  ActionTags::EXCEPTION_TAG);
+            // Added when fast-forward hands off to the instrumented mode
+            if (!fast_forward_)
+            {
+                finish_action_group_.addAction(post_execute_action_);
+                exception_unit_->getActionGroup()->insertActionBefore(pre_exception_action_,
+                                                                      ActionTags::EXCEPTION_TAG);
+                if (profiler_)
+                {
+                    profiler_->instrument(&finish_action_group_);
+                    profiler_->instrument(exception_unit_->getActionGroup());
+                }
+            }
         }
 
         pegasus_core_->getSystem()->registerMemoryCallbacks(observer.get());
@@ -483,11 +776,14 @@ namespace pegasus
         }
 
         observers_.emplace_back(std::move(observer));
+
+        // Instructions must relink their Actions with the pre execute Action
+        ++inst_actions_version_;
     }
 
     void PegasusState::insertExecuteActions(ActionGroup* action_group, const bool is_memory_inst)
     {
-        if (pre_execute_action_)
+        if (pre_execute_action_ && !fast_forward_)
         {
             if (is_memory_inst)
             {
@@ -500,13 +796,136 @@ namespace pegasus
         }
     }
 
-    template <bool CHECK_ILIMIT>
+    void PegasusState::enterFastForward()
+    {
+        if (!fast_forward_)
+        {
+            setFastForward_(true);
+        }
+    }
+
+    void PegasusState::exitFastForward()
+    {
+        if (fast_forward_)
+        {
+            setFastForward_(false);
+        }
+    }
+
+    void PegasusState::setFastForward_(const bool fast_forward)
+    {
+        fast_forward_ = fast_forward;
+
+        fetch_unit_->setFastForward(fast_forward);
+        execute_unit_->setFastForward(fast_forward);
+        finish_action_group_.replaceAction(ActionTags::INCREMENT_PC_TAG,
+                                           fast_forward ? fast_forward_increment_pc_action_
+                                                        : increment_pc_action_);
+
+        if (post_execute_action_)
+        {
+            ActionGroup* exception_action_group = exception_unit_->getActionGroup();
+            if (fast_forward)
+            {
+                finish_action_group_.removeAction(ActionTags::OBSERVER_TAG);
+                exception_action_group->removeAction(ActionTags::OBSERVER_TAG);
+            }
+            else
+            {
+                finish_action_group_.addAction(post_execute_action_);
+                exception_action_group->insertActionBefore(pre_exception_action_,
+                                                           ActionTags::EXCEPTION_TAG);
+            }
+        }
+
+        if (profiler_)
+        {
+            profiler_->instrument(&finish_action_group_);
+            profiler_->instrument(exception_unit_->getActionGroup());
+        }
+
+        // Instructions must relink their Actions with or without the pre execute Action
+        ++inst_actions_version_;
+    }
+
+    void PegasusState::startStfTrace_()
+    {
+        // The logger records the initial register state, which includes the vector registers
+        // written while observers were detached
+        syncVecRegsToSparta();
+        auto stf_logger =
+            std::make_unique<STFLogger>(xlen_, pc_, stf_filename_, this, stf_buffer_size_);
+        stf_logger_ = stf_logger.get();
+        addObserver(std::move(stf_logger));
+    }
+
+    void PegasusState::endRoi_()
+    {
+        ILOG("Region of interest ended after " << std::dec << sim_state_.inst_count
+                                               << " instructions at PC 0x" << std::hex << prev_pc_);
+        check_roi_end_ = false;
+        if (stf_logger_)
+        {
+            stf_logger_->close();
+        }
+
+        // Fast-forward to the end of the workload without handing off again
+        fast_forward_insts_ = 0;
+        fast_forward_pc_ = std::numeric_limits<Addr>::max();
+        fast_forward_to_tracepoint_ = false;
+        setFastForward_(true);
+    }
+
+    void PegasusState::resolveSymbolTriggers()
+    {
+        // PC triggers can be given as symbols of the workload
+        if (!fast_forward_symbol_.empty())
+        {
+            fast_forward_pc_ = findSymbol_(fast_forward_symbol_);
+        }
+        if (!roi_end_symbol_.empty())
+        {
+            roi_end_pc_ = findSymbol_(roi_end_symbol_);
+        }
+        check_roi_end_ = (roi_end_insts_ > 0) || (roi_end_pc_ != std::numeric_limits<Addr>::max())
+                         || roi_end_at_tracepoint_;
+    }
+
+    Addr PegasusState::findSymbol_(const std::string & symbol) const
+    {
+        for (const auto & [addr, name] : pegasus_core_->getSystem()->getSymbols())
+        {
+            if (name == symbol)
+            {
+                return addr;
+            }
+        }
+        sparta_assert(false, "Symbol " << symbol << " was not found in the workload");
+        return 0;
+    }
+
+    template <bool CHECK_ILIMIT, bool FAST_FORWARD>
     Action::ItrType PegasusState::incrementPc_(PegasusState*, Action::ItrType action_it)
     {
+        // The instruction that just executed is the first one after the region of interest
+        bool roi_end = false;
+        if constexpr (!FAST_FORWARD)
+        {
+            if (SPARTA_EXPECT_FALSE(check_roi_end_))
+            {
+                roi_end = (sim_state_.inst_count == roi_end_insts_) || (pc_ == roi_end_pc_)
+                          || (roi_end_at_tracepoint_
+                              && isStopTracepoint(sim_state_.current_opcode));
+            }
+        }
+
         // Set PC
         prev_pc_ = pc_;
         pc_ = next_pc_;
-        DLOG("PC: 0x" << std::hex << pc_);
+        if constexpr (!FAST_FORWARD)
+        {
+            DLOG("PC: 0x" << std::hex << pc_);
+        }
 
         // Increment instruction count
         ++sim_state_.inst_count;
@@ -522,17 +941,54 @@ namespace pegasus
                 std::cout << "Reached instruction limit (" << std::dec << ilimit_
                           << "), stopping simulation." << std::endl;
                 const uint64_t exit_code = 0;
+                sim_state_.inst_limit_reached = true;
                 stopSim(exit_code);
             }
         }
 
-        if (sim_state_.inst_count % quantum_ == 0)
+        // Other harts still need their turn while this one fast-forwards
+        if (SPARTA_EXPECT_FALSE(sim_state_.inst_count >= quantum_end_))
         {
-            DLOG("Executed " << std::dec << quantum_
-                             << " instructions (total: " << sim_state_.inst_count << ")");
+            if constexpr (!FAST_FORWARD)
+            {
+                DLOG("Reached the end of the quantum (total: " << std::dec
+                                                               << sim_state_.inst_count << ")");
+            }
             pauseHart(SimPauseReason::QUANTUM);
         }
 
+        if constexpr (FAST_FORWARD)
+        {
+            // The tracepoint hands off after it executes, the PC trigger before the instruction
+            // at that PC executes
+            if (SPARTA_EXPECT_FALSE(
+                    (sim_state_.inst_count == fast_forward_insts_) || (pc_ == fast_forward_pc_)
+                    || (fast_forward_to_tracepoint_
+                        && isStartTracepoint(sim_state_.current_opcode))))
+            {
+                ILOG("Fast-forward finished after " << std::dec << sim_state_.inst_count
+                                                    << " instructions at PC 0x" << std::hex << pc_);
+                setFastForward_(false);
+                if (!stf_filename_.empty() && (stf_logger_ == nullptr))
+                {
+                    startStfTrace_();
+                }
+
+                // Swapping the finish Actions invalidates the Action iterator, leave the
+                // ActionGroup through a redirect instead
+                return redirectActionGroup(finish_action_group_.getNextActionGroup(), action_it);
+            }
+        }
+        else
+        {
+            if (SPARTA_EXPECT_FALSE(roi_end))
+            {
+                // Skip the observers for this instruction, it is outside of the region
+                endRoi_();
+                return redirectActionGroup(finish_action_group_.getNextActionGroup(), action_it);
+            }
+        }
+
         return ++action_it;
     }
 
@@ -855,19 +1311,19 @@ namespace pegasus
                 POKE_CSR_REG<RV64>(this, MHARTID, hart_id_);
 
                 const uint64_t xlen_val = 2;
-                POKE_CSR_FIELD<RV64>(this, MISA, "mxl", xlen_val);
+                POKE_CSR_FIELD<RV64>(this, CSR::MISA::MXL, xlen_val);
 
                 const uint32_t ext_val = pegasus_core_->getMisaExtFieldValue<RV64>();
-                POKE_CSR_FIELD<RV64>(this, MISA, "extensions", ext_val);
+                POKE_CSR_FIELD<RV64>(this, CSR::MISA::EXTENSIONS, ext_val);
 
                 // Initialize MSTATUS/STATUS with User and Supervisor mode XLEN
-                POKE_CSR_FIELD<RV64>(this, MSTATUS, "uxl", xlen_val);
-                POKE_CSR_FIELD<RV64>(this, MSTATUS, "sxl", xlen_val);
-                POKE_CSR_FIELD<RV64>(this, SSTATUS, "uxl", xlen_val);
+                POKE_CSR_FIELD<RV64>(this, CSR::MSTATUS::UXL, xlen_val);
+                POKE_CSR_FIELD<RV64>(this, CSR::MSTATUS::SXL, xlen_val);
+                POKE_CSR_FIELD<RV64>(this, CSR::SSTATUS::UXL, xlen_val);
 
                 if (pegasus_core_->hasHypervisor())
                 {
-                    POKE_CSR_FIELD<RV64>(this, VSSTATUS, "uxl", xlen_val);
+                    POKE_CSR_FIELD<RV64>(this, CSR::VSSTATUS::UXL, xlen_val);
                 }
             }
             else
@@ -875,10 +1331,10 @@ namespace pegasus
                 POKE_CSR_REG<RV32>(this, MHARTID, hart_id_);
 
                 const uint32_t xlen_val = 1;
-                POKE_CSR_FIELD<RV32>(this, MISA, "mxl", xlen_val);
+                POKE_CSR_FIELD<RV32>(this, CSR::MISA::MXL, xlen_val);
 
                 const uint32_t ext_val = pegasus_core_->getMisaExtFieldValue<RV32>();
-                POKE_CSR_FIELD<RV32>(this, MISA, "extensions", ext_val);
+                POKE_CSR_FIELD<RV32>(this, CSR::MISA::EXTENSIONS, ext_val);
             }
 
             std::cout << "PegasusState::boot()\n";
@@ -900,14 +1356,122 @@ namespace pegasus
         }
     }
 
+    void PegasusState::start()
+    {
+        if (bbv_collector_)
+        {
+            bbv_collector_->start(this);
+        }
+    }
+
     void PegasusState::cleanup()
     {
+        syncVecRegsToSparta();
+
+        if (bbv_collector_)
+        {
+            bbv_collector_->finish(this);
+        }
+
+        if (profiler_)
+        {
+            std::cout << "Profile for hart " << std::dec << hart_id_ << std::endl;
+            profiler_->report(std::cout, profiler_report_);
+        }
+
         if (sim_controller_)
         {
             sim_controller_->onSimulationFinished(this);
         }
     }
 
+    void PegasusState::saveSnapshot(std::ostream & os)
+    {
+        syncVecRegsToSparta();
+
+        snapshot::write(os, pc_);
+        snapshot::write(os, priv_mode_);
+        snapshot::write(os, virtual_mode_);
+
+        for (RegisterSet* rset : {int_rset_.get(), fp_rset_.get(), vec_rset_.get(),
+                                  csr_rset_.get()})
+        {
+            snapshot::write<uint32_t>(os, rset->getNumRegisters());
+            for (uint32_t reg_num = 0; reg_num < rset->getNumRegisters(); ++reg_num)
+            {
+                // Register numbers may have holes
+                std::vector<uint8_t> value;
+                if (const sparta::Register* reg = rset->getRegister(reg_num))
+                {
+                    value.resize(reg->getNumBytes());
+                    reg->peek(value.data(), value.size(), 0);
+                }
+                snapshot::writeBytes(os, value);
+            }
+        }
+
+        snapshot::write<uint64_t>(os, vector_config_.getLMUL());
+        snapshot::write<uint64_t>(os, vector_config_.getSEW());
+        snapshot::write(os, vector_config_.getVTA());
+        snapshot::write(os, vector_config_.getVMA());
+        snapshot::write<uint64_t>(os, vector_config_.getVL());
+        snapshot::write<uint64_t>(os, vector_config_.getVSTART());
+    }
+
+    void PegasusState::restoreSnapshot(std::istream & is)
+    {
+        pc_ = snapshot::read<Addr>(is);
+        const PrivMode priv_mode = snapshot::read<PrivMode>(is);
+        const bool virtual_mode = snapshot::read<bool>(is);
+
+        for (RegisterSet* rset : {int_rset_.get(), fp_rset_.get(), vec_rset_.get(),
+                                  csr_rset_.get()})
+        {
+            const uint32_t num_regs = snapshot::read<uint32_t>(is);
+            sparta_assert(num_regs == rset->getNumRegisters(),
+                          "Snapshot was taken with a different register set for "
+                              << rset->getLocation());
+            for (uint32_t reg_num = 0; reg_num < num_regs; ++reg_num)
+            {
+                std::vector<uint8_t> value = snapshot::readBytes(is);
+                if (sparta::Register* reg = rset->getRegister(reg_num))
+                {
+                    sparta_assert(value.size() == reg->getNumBytes(),
+                                  "Snapshot size mismatch for " << reg->getLocation());
+                    reg->poke(value.data(), value.size(), 0);
+                }
+            }
+        }
+
+        vector_config_.setLMUL(snapshot::read<uint64_t>(is));
+        vector_config_.setSEW(snapshot::read<uint64_t>(is));
+        vector_config_.setVTA(snapshot::read<bool>(is));
+        vector_config_.setVMA(snapshot::read<bool>(is));
+        vector_config_.setVL(snapshot::read<uint64_t>(is));
+        vector_config_.setVSTART(snapshot::read<uint64_t>(is));
+        syncVecRegsFromSparta();
+
+        // Derived state: privilege mode, MMU modes and anything decoded from the old memory
+        setPrivMode(priv_mode, virtual_mode);
+        if (xlen_ == 64)
+        {
+            updateTranslationMode<RV64>(translate_types::TranslationStage::SUPERVISOR);
+            updateTranslationMode<RV64>(translate_types::TranslationStage::VIRTUAL_SUPERVISOR);
+            updateTranslationMode<RV64>(translate_types::TranslationStage::GUEST);
+        }
+        else
+        {
+            updateTranslationMode<RV32>(translate_types::TranslationStage::SUPERVISOR);
+            updateTranslationMode<RV32>(translate_types::TranslationStage::VIRTUAL_SUPERVISOR);
+            updateTranslationMode<RV32>(translate_types::TranslationStage::GUEST);
+        }
+        if (fetch_unit_)
+        {
+            fetch_unit_->getDecodeCache()->flush();
+        }
+        host_block_cache_.fill(HostBlockCacheEntry());
+    }
+
     template bool PegasusState::compare<false>(const PegasusState* rhs) const;
     template bool PegasusState::compare<true>(const PegasusState* rhs) const;
 
@@ -4,6 +4,7 @@
 #include "core/PegasusInst.hpp"
 #include "core/observers/Observer.hpp"
 #include "core/VecConfig.hpp"
+#include "core/VecRegFile.hpp"
 
 #include "arch/RegisterSet.hpp"
 #include "arch/gen/supportedISA.hpp"
@@ -17,6 +18,12 @@
 #include "sparta/simulation/Unit.hpp"
 #include "sparta/utils/SpartaSharedPointerAllocator.hpp"
 
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <limits>
+#include <ostream>
+
 namespace pegasus
 {
     class PegasusInst;
@@ -27,6 +34,8 @@ namespace pegasus
     class Execute;
     class Translate;
     class Exception;
+    class ActionProfiler;
+    class BBVCollector;
     class SimController;
     class VectorState;
     class STFLogger;
@@ -59,9 +68,17 @@ namespace pegasus
             PARAMETER(uint32_t, vlen, 256, "Vector register size in bits")
             PARAMETER(uint32_t, ilimit, 0, "Instruction limit for stopping simulation")
             PARAMETER(uint32_t, quantum, 500, "Instruction quantum size")
+            PARAMETER(bool, adaptive_quantum, false,
+                      "Lengthen the quantum while the hart runs without AMO, LR/SC or fence "
+                      "instructions and shorten it around them")
+            PARAMETER(uint32_t, min_quantum, 50, "Smallest adaptive quantum size")
+            PARAMETER(uint32_t, max_quantum, 20000, "Largest adaptive quantum size")
             PARAMETER(bool, stop_sim_on_wfi, false, "Executing a WFI instruction stops simulation")
             PARAMETER(std::string, stf_filename, "",
                       "STF Trace file name (when not given, STF tracing is disabled)")
+            PARAMETER(uint32_t, stf_buffer_size, 4096,
+                      "Instructions buffered for the STF writer thread (0 writes the trace on the "
+                      "simulation thread)")
             PARAMETER(std::string, validate_with_stf, "",
                       "STF Trace file name (when not given, STF tracing is disabled)")
             PARAMETER(uint64_t, validate_trace_begin, 1,
@@ -71,6 +88,44 @@ namespace pegasus
             // Typical stack pointer is 8KB on most linux systems
             PARAMETER(uint32_t, ulimit_stack_size, 8192,
                       "Typical ulimit stack size for system call emulation")
+            PARAMETER(bool, enable_fast_memory, true,
+                      "Access memory through host pointers when no observer needs memory callbacks")
+            // Fast-forward runs without observers, logging or quantum bookkeeping until the
+            // first handoff trigger is reached
+            PARAMETER(uint64_t, fast_forward_insts, 0,
+                      "Fast-forward this many instructions (0 disables the trigger)")
+            PARAMETER(uint64_t, fast_forward_pc, 0,
+                      "Fast-forward until this PC is reached (0 disables the trigger)")
+            PARAMETER(bool, fast_forward_to_tracepoint, false,
+                      "Fast-forward until a start tracepoint (xor x0, x0, x0 or slli x0, x0, 0x1f) "
+                      "executes")
+            PARAMETER(std::string, fast_forward_symbol, "",
+                      "Fast-forward until the PC reaches this symbol")
+            // The region of interest runs from the fast-forward handoff (or the first
+            // instruction) to the first end trigger, the STF trace only covers the region
+            PARAMETER(uint64_t, roi_end_insts, 0,
+                      "End the region of interest after this many instructions (0 disables the "
+                      "trigger)")
+            PARAMETER(uint64_t, roi_end_pc, 0,
+                      "End the region of interest when this PC is reached (0 disables the "
+                      "trigger)")
+            PARAMETER(std::string, roi_end_symbol, "",
+                      "End the region of interest when the PC reaches this symbol")
+            PARAMETER(bool, roi_end_at_tracepoint, false,
+                      "End the region of interest at a stop tracepoint (xor x0, x1, x1 or "
+                      "slli x0, x1, 0x1f)")
+            PARAMETER(bool, enable_profiler, false,
+                      "Profile instruction counts and Action/ActionGroup cycles")
+            PARAMETER(std::string, profiler_report, "",
+                      "JSON file for the profiler report (when not given, only the tables are "
+                      "printed)")
+            PARAMETER(uint64_t, bbv_interval, 0,
+                      "Collect basic block vectors over intervals of this many instructions (0 "
+                      "disables collection)")
+            PARAMETER(std::string, bbv_filename, "pegasus.bb", "SimPoint basic block vector file")
+            PARAMETER(std::string, bbv_simpoints, "",
+                      "SimPoint .simpoints file, a snapshot is saved at the start of every "
+                      "interval it lists")
 
             // Set by PegasusCore
             HIDDEN_PARAMETER(uint32_t, xlen, 64, "XLEN (either 32 or 64 bit)")
@@ -92,12 +147,67 @@ namespace pegasus
 
         HartId getHartId() const { return hart_id_; }
 
+        // Position of this hart on its core (the mhartid parameter need not be unique)
+        HartId getCoreHartIdx() const { return core_hart_idx_; }
+
         uint64_t getXlen() const;
 
-        uint64_t getQuantumSize() const { return quantum_; }
+        uint64_t getQuantumSize() const { return current_quantum_; }
+
+        // AMO, LR/SC and fence instructions synchronize with other harts. With an adaptive
+        // quantum, the current quantum ends shortly after one so the other harts can catch up.
+        void noteSyncInst()
+        {
+            ++num_sync_insts_;
+            ++quantum_sync_insts_;
+            if (adaptive_quantum_)
+            {
+                quantum_end_ = std::min(quantum_end_, sim_state_.inst_count + min_quantum_);
+            }
+        }
+
+        // Called by PegasusCore when the hart reached the end of its quantum
+        void endQuantum();
+
+        uint64_t getNumQuanta() const { return num_quanta_; }
+
+        uint64_t getNumSyncInsts() const { return num_sync_insts_; }
+
+        // Is an enabled interrupt pending (mip & mie)?
+        bool isInterruptPending();
 
         bool getStopSimOnWfi() const { return stop_sim_on_wfi_; }
 
+        // Magic instructions marking the start of a region of interest (xor x0, x0, x0 or
+        // slli x0, x0, 0x1f)
+        static constexpr Opcode START_TRACEPOINT_OPCODE = 0x00004033;
+        static constexpr Opcode START_TRACEPOINT_SLLI_OPCODE = 0x01f01013;
+
+        // Magic instructions marking the end of a region of interest (xor x0, x1, x1 or
+        // slli x0, x1, 0x1f)
+        static constexpr Opcode STOP_TRACEPOINT_OPCODE = 0x0010c033;
+        static constexpr Opcode STOP_TRACEPOINT_SLLI_OPCODE = 0x01f09013;
+
+        static bool isStartTracepoint(const Opcode opcode)
+        {
+            return (opcode == START_TRACEPOINT_OPCODE) || (opcode == START_TRACEPOINT_SLLI_OPCODE);
+        }
+
+        static bool isStopTracepoint(const Opcode opcode)
+        {
+            return (opcode == STOP_TRACEPOINT_OPCODE) || (opcode == STOP_TRACEPOINT_SLLI_OPCODE);
+        }
+
+        // Fast-forward mode strips observer, logging and quantum bookkeeping Actions from the
+        // fetch/execute/finish path. Switch modes between instructions, not from an Action.
+        void enterFastForward();
+        void exitFastForward();
+
+        bool isFastForwarding() const { return fast_forward_; }
+
+        // nullptr unless the profiler is enabled
+        ActionProfiler* getProfiler() const { return profiler_.get(); }
+
         void setPc(Addr pc) { pc_ = pc; }
 
         Addr getPc() const { return pc_; }
@@ -135,12 +245,16 @@ namespace pegasus
             // Number of instructions executed
             uint64_t inst_count = 0;
 
+            // Number of traps taken (exceptions and interrupts)
+            uint64_t trap_count = 0;
+
             // How many cycles
             uint64_t cycles = 0;
 
             // Simulation control
             SimPauseReason sim_pause_reason = SimPauseReason::INVALID;
             bool sim_stopped = true;
+            bool inst_limit_reached = false;
             bool test_passed = true;
             int64_t workload_exit_code = 0;
 
@@ -184,7 +298,11 @@ namespace pegasus
 
         PegasusCore* getCore() const { return pegasus_core_; }
 
-        void setPegasusCore(PegasusCore* pegasus_core) { pegasus_core_ = pegasus_core; }
+        void setPegasusCore(PegasusCore* pegasus_core, HartId core_hart_idx)
+        {
+            pegasus_core_ = pegasus_core;
+            core_hart_idx_ = core_hart_idx;
+        }
 
         void enableInteractiveMode();
 
@@ -218,6 +336,25 @@ namespace pegasus
             return vec_rset_->getRegister(reg_num);
         }
 
+        // Instruction handlers access the vector registers through the vector register file, the
+        // vec_regs register set mirrors it for tooling and checkpoints
+        VecRegFile* getVecRegFile() { return &vec_reg_file_; }
+
+        const VecRegFile* getVecRegFile() const { return &vec_reg_file_; }
+
+        // Copy the vector registers written since the last sync to the vec_regs register set
+        void syncVecRegsToSparta()
+        {
+            if (SPARTA_EXPECT_FALSE(vec_reg_file_.getDirtyRegs() != 0))
+            {
+                syncVecRegsToSparta_();
+            }
+        }
+
+        // Reload the vector register file after the vec_regs register set was written directly
+        // (e.g. by a checkpoint restore or a debugger)
+        void syncVecRegsFromSparta();
+
         sparta::Register* getCsrRegister(uint32_t reg_num)
         {
             return csr_rset_->getRegister(reg_num);
@@ -272,16 +409,54 @@ namespace pegasus
         void writeMemory(const Addr paddr, const MemoryType value,
                          const MemAccessSource source = MemAccessSource::INVALID);
 
+        // Copy size bytes at paddr with a single memcpy. Only possible for host backed memory
+        // that is not watched by observers, returns false without accessing memory otherwise
+        // and the caller falls back to readMemory/writeMemory.
+        bool readMemoryBlock(const Addr paddr, void* data, const size_t size);
+        bool writeMemoryBlock(const Addr paddr, const void* data, const size_t size);
+
+        // Host pointer to size bytes at paddr, or nullptr in the same cases as readMemoryBlock.
+        // Writes through it must be followed by hostMemoryWritten.
+        uint8_t* getHostMemory(const Addr paddr, const size_t size);
+        void hostMemoryWritten(const Addr paddr, const size_t size);
+
         void addObserver(std::unique_ptr<Observer> observer);
 
         const std::vector<std::unique_ptr<Observer>> & getObservers() const { return observers_; }
 
         void insertExecuteActions(ActionGroup* action_group, const bool is_memory_inst);
 
+        // Incremented whenever the translate or observer Actions that Execute links into
+        // instruction ActionGroups change
+        uint64_t getInstActionsVersion() const { return inst_actions_version_; }
+
         ActionGroup* getFinishActionGroup() { return &finish_action_group_; }
 
         ActionGroup* getStopSimActionGroup() { return &stop_sim_action_group_; }
 
+        // Leave the current ActionGroup and continue execution at the given ActionGroup. The
+        // redirect is picked up by the engine after the current Action returns.
+        void redirectActionGroup(ActionGroup* action_group)
+        {
+            redirect_action_group_ = action_group;
+        }
+
+        // For Actions, redirect and stop executing the current ActionGroup
+        Action::ItrType redirectActionGroup(ActionGroup* action_group, Action::ItrType action_it)
+        {
+            redirectActionGroup(action_group);
+            return action_it;
+        }
+
+        bool hasRedirect() const { return redirect_action_group_ != nullptr; }
+
+        ActionGroup* takeRedirect()
+        {
+            ActionGroup* action_group = redirect_action_group_;
+            redirect_action_group_ = nullptr;
+            return action_group;
+        }
+
         Exception* getExceptionUnit() const { return exception_unit_; }
 
         void stopSim(const int64_t exit_code)
@@ -302,9 +477,21 @@ namespace pegasus
         // called at the top of PegasusSim::run()
         void boot();
 
+        // Called after every hart booted and the snapshot (if any) was restored, right before
+        // the first instruction executes
+        void start();
+
         // One-time cleanup phase after simulation end.
         void cleanup();
 
+        // Save/restore the architectural state of the hart (PC, privilege mode, registers and
+        // vector configuration) for a snapshot
+        void saveSnapshot(std::ostream & os);
+        void restoreSnapshot(std::istream & is);
+
+        // Look up the PC triggers given as workload symbols (fast_forward_symbol, roi_end_symbol)
+        void resolveSymbolTriggers();
+
       private:
         void onBindTreeEarly_() override;
         void onBindTreeLate_() override;
@@ -317,6 +504,9 @@ namespace pegasus
         Action post_execute_action_;
         Action pre_exception_action_;
 
+        // Starts at 1 so that instructions that have never been linked (version 0) are stale
+        uint64_t inst_actions_version_ = 1;
+
         Action::ItrType stopSim_(PegasusState*, Action::ItrType action_it)
         {
             for (auto & obs : observers_)
@@ -332,6 +522,9 @@ namespace pegasus
         //! Hart ID
         const HartId hart_id_;
 
+        //! Index of this hart on its core, set by the core
+        HartId core_hart_idx_ = 0;
+
         // VLEN (128, 256, 512, 1024 or 2048 bits)
         const uint32_t vlen_;
 
@@ -347,11 +540,61 @@ namespace pegasus
         // Instruction quantum size
         const uint64_t quantum_;
 
+        //! Adaptive quantum
+        const bool adaptive_quantum_;
+        const uint64_t min_quantum_;
+        const uint64_t max_quantum_;
+        uint64_t current_quantum_;
+
+        //! The current quantum ends when inst_count reaches quantum_end_
+        uint64_t quantum_end_;
+        uint64_t quantum_sync_insts_ = 0;
+
+        //! Scheduler statistics
+        uint64_t num_quanta_ = 0;
+        uint64_t num_sync_insts_ = 0;
+
         //! Stop simulatiion on WFI
         const bool stop_sim_on_wfi_;
 
+        //! Fast-forward handoff triggers, disabled once the region of interest ends
+        uint64_t fast_forward_insts_;
+        Addr fast_forward_pc_;
+        bool fast_forward_to_tracepoint_;
+        const std::string fast_forward_symbol_;
+
+        //! Region of interest end triggers
+        const uint64_t roi_end_insts_;
+        Addr roi_end_pc_;
+        const bool roi_end_at_tracepoint_;
+        const std::string roi_end_symbol_;
+        bool check_roi_end_ = false;
+
+        // Leave the region of interest: close the STF trace and fast-forward to the end
+        void endRoi_();
+
+        // Start the STF trace at the current PC
+        void startStfTrace_();
+
+        // Look up a symbol of the workload
+        Addr findSymbol_(const std::string & symbol) const;
+
+        //! Currently fast-forwarding
+        bool fast_forward_ = false;
+
+        void setFastForward_(const bool fast_forward);
+
+        //! Instruction and Action profiler
+        std::unique_ptr<ActionProfiler> profiler_;
+        const std::string profiler_report_;
+
+        //! Basic block vector collector
+        std::unique_ptr<BBVCollector> bbv_collector_;
+
         // STF Trace Filename
         const std::string stf_filename_;
+        const uint32_t stf_buffer_size_;
+        STFLogger* stf_logger_ = nullptr;
         const std::string validation_stf_filename_;
         const uint64_t validate_trace_begin_ = 0x1;
         const uint64_t validate_inst_begin_ = 0x1;
@@ -359,6 +602,21 @@ namespace pegasus
         //! Typical stack size for system call emulation
         const uint64_t ulimit_stack_size_;
 
+        //! Per-hart cache of host pointers to DRAM blocks. readMemory/writeMemory use it to
+        //! bypass the sparta memory map when no observer needs memory callbacks.
+        struct HostBlockCacheEntry
+        {
+            Addr block = std::numeric_limits<Addr>::max();
+            uint8_t* host = nullptr;
+        };
+
+        static constexpr uint32_t HOST_BLOCK_CACHE_SIZE = 64;
+        std::array<HostBlockCacheEntry, HOST_BLOCK_CACHE_SIZE> host_block_cache_;
+        const bool enable_fast_memory_;
+
+        // Host pointer for an access or nullptr if it must go through the memory map
+        uint8_t* getHostPointer_(const Addr paddr, const size_t size);
+
         //! Current pc
         Addr pc_ = 0x0;
 
@@ -387,9 +645,10 @@ namespace pegasus
         VectorConfig vector_config_;
 
         // Increment PC Action
-        template <bool CHECK_ILIMIT>
+        template <bool CHECK_ILIMIT, bool FAST_FORWARD>
         Action::ItrType incrementPc_(PegasusState* state, Action::ItrType action_it);
         pegasus::Action increment_pc_action_;
+        pegasus::Action fast_forward_increment_pc_action_;
 
         // Translation/MMU state
         PegasusTranslationState fetch_translation_state_;
@@ -415,6 +674,11 @@ namespace pegasus
         std::unique_ptr<RegisterSet> vec_rset_;
         std::unique_ptr<RegisterSet> csr_rset_;
 
+        // Vector registers used by instruction handlers
+        VecRegFile vec_reg_file_;
+
+        void syncVecRegsToSparta_();
+
         // Cached registers by name
         std::unordered_map<std::string, sparta::Register*> registers_by_name_;
 
@@ -438,6 +702,9 @@ namespace pegasus
         Action pause_action_;
         ActionGroup pause_sim_action_group_;
 
+        // Pending ActionGroup redirect (trap, page-crossing fetch, etc.)
+        ActionGroup* redirect_action_group_ = nullptr;
+
         // Co-simulation debug utils
         std::unordered_map<std::string, int> reg_ids_by_name_;
         SimController* sim_controller_ = nullptr;
@@ -480,26 +747,26 @@ namespace pegasus
     template <typename VLEN>
     static inline VLEN READ_VEC_REG(PegasusState* state, uint32_t reg_ident)
     {
-        return state->getVecRegister(reg_ident)->dmiRead<VLEN>();
+        return state->getVecRegFile()->read<VLEN>(reg_ident, 0);
     }
 
     template <typename VLEN>
     static inline void WRITE_VEC_REG(PegasusState* state, uint32_t reg_ident, VLEN reg_value)
     {
-        state->getVecRegister(reg_ident)->dmiWrite<VLEN>(reg_value);
+        state->getVecRegFile()->write<VLEN>(reg_ident, reg_value, 0);
     }
 
     template <typename Elem>
     static inline Elem READ_VEC_ELEM(PegasusState* state, uint32_t reg_ident, uint32_t idx)
     {
-        return state->getVecRegister(reg_ident)->dmiRead<Elem>(idx);
+        return state->getVecRegFile()->read<Elem>(reg_ident, idx);
     }
 
     template <typename Elem>
     static inline void WRITE_VEC_ELEM(PegasusState* state, uint32_t reg_ident, Elem value,
                                       uint32_t idx)
     {
-        state->getVecRegister(reg_ident)->dmiWrite<Elem>(value, idx);
+        state->getVecRegFile()->write<Elem>(reg_ident, value, idx);
     }
 
     template <typename XLEN>
@@ -617,4 +884,78 @@ namespace pegasus
             POKE_CSR_REG<XLEN>(state, reg_ident, csr_value);
         }
     }
+
+    // Field accessors using the generated CSR field descriptors (e.g. CSR::MSTATUS::MIE). The
+    // bit range is resolved at compile time, so these are preferred over the string versions
+    // above in instruction handlers and other hot paths.
+    template <typename XLEN, CsrFieldType FieldT>
+    static inline XLEN READ_CSR_FIELD(PegasusState* state, uint32_t reg_ident, FieldT)
+    {
+        static_assert(std::is_same_v<XLEN, RV64> || std::is_same_v<XLEN, RV32>);
+        if constexpr (!FieldT::template exists<XLEN>())
+        {
+            sparta_assert(false, "CSR field does not exist for XLEN: " << std::hex << reg_ident);
+            return 0;
+        }
+        else
+        {
+            return (state->getCsrRegister(reg_ident)->dmiRead<XLEN>()
+                    & FieldT::template mask<XLEN>())
+                   >> FieldT::template lsb<XLEN>();
+        }
+    }
+
+    template <typename XLEN, CsrFieldType FieldT>
+    static inline XLEN READ_CSR_FIELD(PegasusState* state, FieldT field)
+    {
+        return READ_CSR_FIELD<XLEN>(state, FieldT::csr_num, field);
+    }
+
+    template <typename XLEN, CsrFieldType FieldT>
+    static inline void WRITE_CSR_FIELD(PegasusState* state, uint32_t reg_ident, FieldT,
+                                       uint64_t field_value)
+    {
+        static_assert(std::is_same_v<XLEN, RV64> || std::is_same_v<XLEN, RV32>);
+        if constexpr (!FieldT::template exists<XLEN>())
+        {
+            sparta_assert(false, "CSR field does not exist for XLEN: " << std::hex << reg_ident);
+        }
+        else
+        {
+            constexpr XLEN mask = FieldT::template mask<XLEN>();
+            const XLEN csr_value = READ_CSR_REG<XLEN>(state, reg_ident);
+            const XLEN new_field_value = XLEN(field_value) << FieldT::template lsb<XLEN>();
+            WRITE_CSR_REG<XLEN>(state, reg_ident, (csr_value & ~mask) | (new_field_value & mask));
+        }
+    }
+
+    template <typename XLEN, CsrFieldType FieldT>
+    static inline void WRITE_CSR_FIELD(PegasusState* state, FieldT field, uint64_t field_value)
+    {
+        WRITE_CSR_FIELD<XLEN>(state, FieldT::csr_num, field, field_value);
+    }
+
+    template <typename XLEN, CsrFieldType FieldT>
+    static inline void POKE_CSR_FIELD(PegasusState* state, uint32_t reg_ident, FieldT,
+                                      uint64_t field_value)
+    {
+        static_assert(std::is_same_v<XLEN, RV64> || std::is_same_v<XLEN, RV32>);
+        if constexpr (!FieldT::template exists<XLEN>())
+        {
+            sparta_assert(false, "CSR field does not exist for XLEN: " << std::hex << reg_ident);
+        }
+        else
+        {
+            constexpr XLEN mask = FieldT::template mask<XLEN>();
+            const XLEN csr_value = READ_CSR_REG<XLEN>(state, reg_ident);
+            const XLEN new_field_value = XLEN(field_value) << FieldT::template lsb<XLEN>();
+            POKE_CSR_REG<XLEN>(state, reg_ident, (csr_value & ~mask) | (new_field_value & mask));
+        }
+    }
+
+    template <typename XLEN, CsrFieldType FieldT>
+    static inline void POKE_CSR_FIELD(PegasusState* state, FieldT field, uint64_t field_value)
+    {
+        POKE_CSR_FIELD<XLEN>(state, FieldT::csr_num, field, field_value);
+    }
 } // namespace pegasus
@@ -54,11 +54,13 @@ namespace pegasus
 
 #include "core/Exception.hpp"
 
+// Raise a trap from an Action. The Action returns immediately and the engine continues at the
+// Exception ActionGroup, no C++ exception is thrown. Requires `state` and `action_it` in scope.
 #define TRAP_IMPL(cause)                                                                           \
     {                                                                                              \
         auto exception_unit = state->getExceptionUnit();                                           \
         exception_unit->setUnhandledException(cause);                                              \
-        throw ActionException(exception_unit->getActionGroup());                                   \
+        return state->redirectActionGroup(exception_unit->getActionGroup(), action_it);            \
     }
 
 #define THROW_MISALIGNED_FETCH TRAP_IMPL(FaultCause::INST_ADDR_MISALIGNED)
@@ -15,7 +15,7 @@ namespace pegasus
     template <typename XLEN> void VectorConfig::vsetVTYPE(PegasusState* state, XLEN vtype)
     {
         WRITE_CSR_REG<XLEN>(state, VTYPE, vtype);
-        const size_t vlmul = READ_CSR_FIELD<XLEN>(state, VTYPE, "vlmul");
+        const size_t vlmul = READ_CSR_FIELD<XLEN>(state, CSR::VTYPE::VLMUL);
 
         static const size_t lmul_table[8] = {
             8,  // 000
@@ -31,9 +31,9 @@ namespace pegasus
         const size_t lmul = lmul_table[vlmul & 0b111];
         sparta_assert(lmul, "Invalid vtype VLMUL encoding.");
         setLMUL(lmul);
-        setSEW(8u << READ_CSR_FIELD<XLEN>(state, VTYPE, "vsew"));
-        setVTA(READ_CSR_FIELD<XLEN>(state, VTYPE, "vta"));
-        setVMA(READ_CSR_FIELD<XLEN>(state, VTYPE, "vma"));
+        setSEW(8u << READ_CSR_FIELD<XLEN>(state, CSR::VTYPE::VSEW));
+        setVTA(READ_CSR_FIELD<XLEN>(state, CSR::VTYPE::VTA));
+        setVMA(READ_CSR_FIELD<XLEN>(state, CSR::VTYPE::VMA));
     }
 
     template RV32 VectorConfig::vsetAVL<RV32>(PegasusState*, bool, RV32);
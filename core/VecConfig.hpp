@@ -8,6 +8,7 @@
 namespace pegasus
 {
     constexpr size_t VLEN_MIN = 32;
+    constexpr size_t VLEN_MAX = 2048;
 
     class PegasusState;
 
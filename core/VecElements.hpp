@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <cstring>
 #include <limits>
 
 #include "core/PegasusState.hpp"
@@ -667,6 +668,70 @@ namespace pegasus
         uint32_t reg_id_ = 0;
     }; // class Elements
 
+    /**
+     * @brief Copy the first *num_bytes* of the vector register group starting at *reg_id* into
+     * *buf*. The registers of a group are contiguous in the *VecRegFile*, so this is a single copy
+     * unless VLEN was lowered at run time.
+     *
+     * @param state Pointer to *PegasusState* object.
+     * @param reg_id First vector register of the group.
+     * @param buf Destination buffer of at least *num_bytes*.
+     * @param num_bytes Number of bytes to copy.
+     */
+    inline void readVecRegGroup(PegasusState* state, uint32_t reg_id, void* buf, size_t num_bytes)
+    {
+        const VecRegFile* vec_reg_file = state->getVecRegFile();
+        const size_t vlenb = state->getVectorConfig()->getVLEN() / 8;
+        const uint32_t num_regs = (num_bytes + vlenb - 1) / vlenb;
+        uint8_t* bytes = static_cast<uint8_t*>(buf);
+        if (vlenb == vec_reg_file->getVLENB())
+        {
+            memcpy(bytes, vec_reg_file->getRegGroup(reg_id, num_regs).data(), num_bytes);
+            return;
+        }
+
+        // VLEN was lowered below the size of the register storage
+        for (size_t offset = 0; offset < num_bytes; offset += vlenb)
+        {
+            const size_t size = std::min(vlenb, num_bytes - offset);
+            memcpy(bytes + offset, vec_reg_file->getRegGroup(reg_id + offset / vlenb, 1).data(),
+                   size);
+        }
+    }
+
+    /**
+     * @brief Copy *num_bytes* from *buf* into the start of the vector register group starting at
+     * *reg_id*. Bytes past *num_bytes* are left untouched.
+     *
+     * @param state Pointer to *PegasusState* object.
+     * @param reg_id First vector register of the group.
+     * @param buf Source buffer of at least *num_bytes*.
+     * @param num_bytes Number of bytes to copy.
+     */
+    inline void writeVecRegGroup(PegasusState* state, uint32_t reg_id, const void* buf,
+                                 size_t num_bytes)
+    {
+        VecRegFile* vec_reg_file = state->getVecRegFile();
+        const size_t vlenb = state->getVectorConfig()->getVLEN() / 8;
+        const uint32_t num_regs = (num_bytes + vlenb - 1) / vlenb;
+        const uint8_t* bytes = static_cast<const uint8_t*>(buf);
+        if (vlenb == vec_reg_file->getVLENB())
+        {
+            memcpy(vec_reg_file->getMutableRegGroup(reg_id, num_regs).data(), bytes, num_bytes);
+            return;
+        }
+
+        for (size_t offset = 0; offset < num_bytes; offset += vlenb)
+        {
+            const size_t size = std::min(vlenb, num_bytes - offset);
+            memcpy(vec_reg_file->getMutableRegGroup(reg_id + offset / vlenb, 1).data(),
+                   bytes + offset, size);
+        }
+    }
+
+    /**< Size of the largest vector register group (LMUL=8) in bytes. */
+    constexpr size_t VREG_GROUP_MAX_BYTES = VLEN_MAX / 8 * 8;
+
     using MaskElement = Element<VLEN_MIN>;
     using MaskElements = Elements<MaskElement, true>;
     using MaskBitIterator = MaskElements::MaskBitIterator<>;
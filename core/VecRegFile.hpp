@@ -0,0 +1,93 @@
+#pragma once
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <cassert>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <span>
+
+namespace pegasus
+{
+    /*!
+     * \class VecRegFile
+     * \brief Storage of the 32 vector registers of a hart
+     *
+     * All registers live in one aligned buffer, register n at n * VLENB, so a register group is
+     * contiguous in host memory and instruction handlers can access it through a std::span
+     * instead of one register lookup and DMI access per element. Registers written since the
+     * last sync are tracked so PegasusState can mirror them into the vec_regs register set, which
+     * is what tooling and checkpoints see.
+     */
+    class VecRegFile
+    {
+      public:
+        static constexpr uint32_t NUM_REGS = 32;
+        static constexpr size_t ALIGNMENT = 64;
+
+        explicit VecRegFile(const uint32_t vlenb) :
+            vlenb_(vlenb),
+            data_(static_cast<uint8_t*>(std::aligned_alloc(ALIGNMENT, NUM_REGS * vlenb)))
+        {
+            sparta_assert(data_ != nullptr, "Failed to allocate the vector register file");
+            memset(data_.get(), 0, NUM_REGS * vlenb_);
+        }
+
+        uint32_t getVLENB() const { return vlenb_; }
+
+        // Read-only view of num_regs registers starting at reg_num
+        std::span<const uint8_t> getRegGroup(const uint32_t reg_num, const uint32_t num_regs) const
+        {
+            assert((reg_num + num_regs) <= NUM_REGS);
+            return {data_.get() + reg_num * vlenb_, size_t(num_regs) * vlenb_};
+        }
+
+        // Writable view of num_regs registers starting at reg_num, marks them as written
+        std::span<uint8_t> getMutableRegGroup(const uint32_t reg_num, const uint32_t num_regs)
+        {
+            assert((reg_num + num_regs) <= NUM_REGS);
+            markDirty_(reg_num, num_regs);
+            return {data_.get() + reg_num * vlenb_, size_t(num_regs) * vlenb_};
+        }
+
+        template <typename T> T read(const uint32_t reg_num, const uint32_t idx) const
+        {
+            assert((reg_num < NUM_REGS) && (((idx + 1) * sizeof(T)) <= vlenb_));
+            T value;
+            memcpy(&value, data_.get() + reg_num * vlenb_ + idx * sizeof(T), sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void write(const uint32_t reg_num, const T & value, const uint32_t idx)
+        {
+            assert((reg_num < NUM_REGS) && (((idx + 1) * sizeof(T)) <= vlenb_));
+            memcpy(data_.get() + reg_num * vlenb_ + idx * sizeof(T), &value, sizeof(T));
+            dirty_regs_ |= uint32_t(1) << reg_num;
+        }
+
+        // Bit n is set if register n was written since the last call to clearDirtyRegs
+        uint32_t getDirtyRegs() const { return dirty_regs_; }
+
+        void clearDirtyRegs() { dirty_regs_ = 0; }
+
+      private:
+        void markDirty_(const uint32_t reg_num, const uint32_t num_regs)
+        {
+            const uint64_t mask = ((uint64_t(1) << num_regs) - 1) << reg_num;
+            dirty_regs_ |= static_cast<uint32_t>(mask);
+        }
+
+        const uint32_t vlenb_;
+
+        struct FreeDeleter
+        {
+            void operator()(uint8_t* ptr) const { std::free(ptr); }
+        };
+
+        std::unique_ptr<uint8_t[], FreeDeleter> data_;
+        uint32_t dirty_regs_ = 0;
+    };
+} // namespace pegasus
@@ -47,6 +47,11 @@ namespace pegasus
                       || std::is_same_v<SIZE, D>);
         static_assert(sizeof(XLEN) >= sizeof(SIZE));
 
+        state->noteSyncInst();
+
+        // The read-modify-write must not interleave with AMOs from cores on other host threads
+        const auto lock = state->getCore()->getSystem()->lockMemory();
+
         const PegasusInstPtr & inst = state->getCurrentInst();
         const XLEN paddr = inst->getTranslationState()->getResult().getPAddr();
         XLEN rd_val = 0;
@@ -77,12 +82,14 @@ namespace pegasus
         static_assert(std::is_same_v<SIZE, B> || std::is_same_v<SIZE, H> || std::is_same_v<SIZE, W>
                       || std::is_same_v<SIZE, D>);
 
+        state->noteSyncInst();
+
         const PegasusInstPtr & inst = state->getCurrentInst();
         auto xlation_state = inst->getTranslationState();
 
         // Make the reservation
         const uint64_t paddr = xlation_state->getResult().getPAddr();
-        state->getCore()->makeReservation(state->getHartId(), paddr);
+        state->getCore()->makeReservation(state->getCoreHartIdx(), paddr);
 
         // Get the memory
         const XLEN rd_val =
@@ -107,23 +114,11 @@ namespace pegasus
         static_assert(std::is_same_v<SIZE, B> || std::is_same_v<SIZE, H> || std::is_same_v<SIZE, W>
                       || std::is_same_v<SIZE, D>);
 
+        state->noteSyncInst();
+
         const PegasusInstPtr & inst = state->getCurrentInst();
         auto xlation_state = inst->getTranslationState();
 
-        XLEN fail_code = 1; // assume bad
-        if (const auto & resv = state->getCore()->getReservation(state->getHartId());
-            resv.isValid())
-        {
-            if (resv == xlation_state->getResult().getPAddr())
-            {
-                const uint64_t rs2_val = READ_INT_REG<XLEN>(state, inst->getRs2());
-                state->writeMemory<SIZE>(xlation_state->getResult(), rs2_val,
-                                         MemAccessSource::INSTRUCTION);
-                fail_code = 0;
-            }
-        }
-        xlation_state->popResult();
-
         // From RISC-V spec:
         //
         // Regardless of success or failure, executing an SC instruction invalidates
@@ -132,10 +127,22 @@ namespace pegasus
         // An SC may succeed only if no store from another hart to the
         // reservation set can be observed to have occurred between the LR and the SC,
         // and if there is no other SC between the LR and itself in program order.
-        // FIXME: All store instructions can invalidate a reservation, not just a SC
-
-        // Always clear all reservations after a SC
-        state->getCore()->clearReservations();
+        //
+        // Stores from other harts invalidate the reservation in the system ReservationTable,
+        // and the store of a successful SC invalidates the reservations of the other harts.
+        // The check and that invalidation must not interleave with an SC from a core on
+        // another host thread, or both could succeed on the same reservation set.
+        const auto lock = state->getCore()->getSystem()->lockMemory();
+        XLEN fail_code = 1; // assume bad
+        if (state->getCore()->consumeReservation(state->getCoreHartIdx(),
+                                                 xlation_state->getResult().getPAddr()))
+        {
+            const uint64_t rs2_val = READ_INT_REG<XLEN>(state, inst->getRs2());
+            state->writeMemory<SIZE>(xlation_state->getResult(), rs2_val,
+                                     MemAccessSource::INSTRUCTION);
+            fail_code = 0;
+        }
+        xlation_state->popResult();
 
         WRITE_INT_REG<XLEN>(state, inst->getRd(), fail_code);
         return ++action_it;
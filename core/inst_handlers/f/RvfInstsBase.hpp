@@ -98,36 +98,36 @@ namespace pegasus
 
             // FFLAGS
             WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "NX",
+                state, CSR::FFLAGS::NX,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_inexact) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "UF",
+                state, CSR::FFLAGS::UF,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_underflow) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "OF",
+                state, CSR::FFLAGS::OF,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_overflow) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "DZ",
+                state, CSR::FFLAGS::DZ,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_infinite) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "NV",
+                state, CSR::FFLAGS::NV,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_invalid) != 0));
 
             // FCSR
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "NX",
+                state, CSR::FCSR::NX,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_inexact) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "UF",
+                state, CSR::FCSR::UF,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_underflow) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "OF",
+                state, CSR::FCSR::OF,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_overflow) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "DZ",
+                state, CSR::FCSR::DZ,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_infinite) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "NV",
+                state, CSR::FCSR::NV,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_invalid) != 0));
         }
 
@@ -136,19 +136,19 @@ namespace pegasus
         {
             // FCSR
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "NX",
+                state, CSR::FCSR::NX,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_inexact) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "UF",
+                state, CSR::FCSR::UF,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_underflow) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "OF",
+                state, CSR::FCSR::OF,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_overflow) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "DZ",
+                state, CSR::FCSR::DZ,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_infinite) != 0));
             WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "NV",
+                state, CSR::FCSR::NV,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_invalid) != 0));
         }
 
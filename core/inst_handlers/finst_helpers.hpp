@@ -476,23 +476,17 @@ namespace pegasus
     template <typename XLEN> void restoreFloatCsrs(PegasusState* state)
     {
         decltype(softfloat_exceptionFlags) value = 0;
-        auto csr = READ_CSR_REG<XLEN>(state, FFLAGS);
+        const XLEN csr = READ_CSR_REG<XLEN>(state, FFLAGS);
 
-        auto syncBitField =
-            [&csr, &value](uint32_t csr_num, const char* field_name, exceptionFlag_t flag)
-        {
-            const auto & csr_bit_range = getCsrBitRange<XLEN>(csr_num, field_name);
-            const auto lsb = csr_bit_range.first;
-            const auto msb = csr_bit_range.second;
-            const XLEN mask = ((XLEN{1} << (msb - lsb + 1)) - 1) << lsb;
-            value |= ((csr & mask) != 0) * flag;
-        };
+        // Field bit ranges come from the generated CSR descriptors, so there is no per-call lookup
+        auto syncBitField = [csr, &value]<CsrFieldType FieldT>(FieldT, exceptionFlag_t flag)
+        { value |= ((csr & FieldT::template mask<XLEN>()) != 0) * flag; };
 
-        syncBitField(FFLAGS, "NX", softfloat_flag_inexact);
-        syncBitField(FFLAGS, "UF", softfloat_flag_underflow);
-        syncBitField(FFLAGS, "OF", softfloat_flag_overflow);
-        syncBitField(FFLAGS, "DZ", softfloat_flag_infinite);
-        syncBitField(FFLAGS, "NV", softfloat_flag_invalid);
+        syncBitField(CSR::FFLAGS::NX, softfloat_flag_inexact);
+        syncBitField(CSR::FFLAGS::UF, softfloat_flag_underflow);
+        syncBitField(CSR::FFLAGS::OF, softfloat_flag_overflow);
+        syncBitField(CSR::FFLAGS::DZ, softfloat_flag_infinite);
+        syncBitField(CSR::FFLAGS::NV, softfloat_flag_invalid);
         softfloat_exceptionFlags = value;
     }
 
@@ -501,34 +495,31 @@ namespace pegasus
         XLEN mask = 0;
         XLEN value = 0;
 
-        auto updateBitField =
-            [&mask, &value](uint32_t csr_num, const char* field_name, exceptionFlag_t flag)
+        auto updateBitField = [&mask, &value]<CsrFieldType FieldT>(FieldT, exceptionFlag_t flag)
         {
-            const auto & csr_bit_range = getCsrBitRange<XLEN>(csr_num, field_name);
-            const auto lsb = csr_bit_range.first;
-            const auto msb = csr_bit_range.second;
-            value |= static_cast<XLEN>((softfloat_exceptionFlags & flag) != 0) << lsb;
-            mask |= ((XLEN{1} << (msb - lsb + 1)) - 1) << lsb;
+            value |= static_cast<XLEN>((softfloat_exceptionFlags & flag) != 0)
+                     << FieldT::template lsb<XLEN>();
+            mask |= FieldT::template mask<XLEN>();
         };
 
         // FFLAGS
-        auto fflags = READ_CSR_REG<XLEN>(state, FFLAGS);
-        updateBitField(FFLAGS, "NX", softfloat_flag_inexact);
-        updateBitField(FFLAGS, "UF", softfloat_flag_underflow);
-        updateBitField(FFLAGS, "OF", softfloat_flag_overflow);
-        updateBitField(FFLAGS, "DZ", softfloat_flag_infinite);
-        updateBitField(FFLAGS, "NV", softfloat_flag_invalid);
+        const XLEN fflags = READ_CSR_REG<XLEN>(state, FFLAGS);
+        updateBitField(CSR::FFLAGS::NX, softfloat_flag_inexact);
+        updateBitField(CSR::FFLAGS::UF, softfloat_flag_underflow);
+        updateBitField(CSR::FFLAGS::OF, softfloat_flag_overflow);
+        updateBitField(CSR::FFLAGS::DZ, softfloat_flag_infinite);
+        updateBitField(CSR::FFLAGS::NV, softfloat_flag_invalid);
         WRITE_CSR_REG<XLEN>(state, FFLAGS, (fflags & ~mask) | value);
 
         mask = 0;
         value = 0;
         // FCSR
-        auto fcsr = READ_CSR_REG<XLEN>(state, FCSR);
-        updateBitField(FCSR, "NX", softfloat_flag_inexact);
-        updateBitField(FCSR, "UF", softfloat_flag_underflow);
-        updateBitField(FCSR, "OF", softfloat_flag_overflow);
-        updateBitField(FCSR, "DZ", softfloat_flag_infinite);
-        updateBitField(FCSR, "NV", softfloat_flag_invalid);
+        const XLEN fcsr = READ_CSR_REG<XLEN>(state, FCSR);
+        updateBitField(CSR::FCSR::NX, softfloat_flag_inexact);
+        updateBitField(CSR::FCSR::UF, softfloat_flag_underflow);
+        updateBitField(CSR::FCSR::OF, softfloat_flag_overflow);
+        updateBitField(CSR::FCSR::DZ, softfloat_flag_infinite);
+        updateBitField(CSR::FCSR::NV, softfloat_flag_invalid);
         WRITE_CSR_REG<XLEN>(state, FCSR, (fcsr & ~mask) | value);
     }
 
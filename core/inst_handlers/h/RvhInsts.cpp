@@ -3,6 +3,8 @@
 #include "core/ActionGroup.hpp"
 #include "core/PegasusState.hpp"
 #include "core/PegasusInst.hpp"
+#include "core/translate/Translate.hpp"
+#include "core/Fetch.hpp"
 #include "include/PegasusUtils.hpp"
 
 namespace pegasus
@@ -169,7 +171,7 @@ namespace pegasus
         {
             // HFENCE.GVMA is valid only in HS-mode when mstatus.TVM=0,
             // or in M-mode (irrespective of mstatus.TVM)
-            XLEN tvm = READ_CSR_FIELD<XLEN>(state, MSTATUS, "tvm");
+            XLEN tvm = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::TVM);
             if (((tvm == 0) && (priv_mode != PrivMode::HYPERVISOR))
                 || (priv_mode != PrivMode::MACHINE))
             {
@@ -185,7 +187,34 @@ namespace pegasus
             }
         }
 
-        // TODO: Flush any TLBs and instruction/block caches in the future
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        std::optional<Addr> addr;
+        std::optional<uint32_t> id;
+        if (inst->getRs1() != 0)
+        {
+            addr = READ_INT_REG<XLEN>(state, inst->getRs1());
+        }
+        if (inst->getRs2() != 0)
+        {
+            id = READ_INT_REG<XLEN>(state, inst->getRs2());
+        }
+
+        if constexpr (GUEST)
+        {
+            // HFENCE.GVMA takes the guest physical address shifted right by 2
+            if (addr.has_value())
+            {
+                addr = addr.value() << 2;
+            }
+            state->getTranslateUnit()->fenceGvma(addr, id);
+        }
+        else
+        {
+            state->getTranslateUnit()->fenceVma(
+                translate_types::TranslationStage::VIRTUAL_SUPERVISOR, addr, id);
+        }
+        state->getFetchUnit()->getDecodeCache()->resetCursor();
+
         return ++action_it;
     }
 
@@ -199,7 +228,8 @@ namespace pegasus
 
         // From Hypervisor spec:
         // instructions are valid only in M-mode or HS-mode, or in U-mode when hstatus.HU=1
-        if ((state->getPrivMode() == PrivMode::USER) || READ_CSR_FIELD<XLEN>(state, HSTATUS, "hu"))
+        if ((state->getPrivMode() == PrivMode::USER)
+            || READ_CSR_FIELD<XLEN>(state, CSR::HSTATUS::HU))
         {
             THROW_ILLEGAL_INST;
         }
@@ -6,6 +6,7 @@
 #include "core/ActionGroup.hpp"
 #include "core/PegasusCore.hpp"
 #include "core/PegasusInst.hpp"
+#include "core/translate/Translate.hpp"
 #include "system/PegasusSystem.hpp"
 #include "system/SystemCallEmulator.hpp"
 #include "sparta/memory/SimpleMemoryMapNode.hpp"
@@ -898,18 +899,18 @@ namespace pegasus
                              & state->getCore()->getPcAlignmentMask());
 
             // Get the previous privilege mode from the MPP field of MSTATUS
-            prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, MSTATUS, "mpp");
+            prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPP);
 
             if (state->getCore()->hasHypervisor())
             {
                 // Get the previous virtual mode from the MPV field of MSTATUS
                 if constexpr (std::is_same_v<XLEN, RV64>)
                 {
-                    prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, MSTATUS, "mpv");
+                    prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPV);
                 }
                 else
                 {
-                    prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, MSTATUSH, "mpv");
+                    prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, CSR::MSTATUSH::MPV);
                 }
 
                 // If MPP=3, the virtualization mode remains 0
@@ -925,33 +926,33 @@ namespace pegasus
             {
                 // TODO: Will need to update the load/store translation mode when translation is
                 // supported
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mprv", (XLEN)0);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPRV, (XLEN)0);
             }
 
             // Set MIE = MPIE and reset MPIE
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mie",
-                                  READ_CSR_FIELD<XLEN>(state, MSTATUS, "mpie"));
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpie", (XLEN)1);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MIE,
+                                  READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPIE));
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPIE, (XLEN)1);
 
             // Reset MPP
             // TODO: Check if User mode is available
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpp", (XLEN)PrivMode::USER);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPP, (XLEN)PrivMode::USER);
 
             // Reset MPV
             if constexpr (std::is_same_v<XLEN, RV64>)
             {
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpv", 0);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPV, 0);
             }
             else
             {
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUSH, "mpv", 0);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUSH::MPV, 0);
             }
         }
         else
         {
             const bool virt_mode = state->getVirtualMode();
 
-            const uint32_t vtsr_val = READ_CSR_FIELD<XLEN>(state, HSTATUS, "vtsr");
+            const uint32_t vtsr_val = READ_CSR_FIELD<XLEN>(state, CSR::HSTATUS::VTSR);
             if (virt_mode && (vtsr_val || (state->getPrivMode() == PrivMode::USER)))
             {
                 THROW_ILLEGAL_VIRTUAL_INST;
@@ -959,7 +960,7 @@ namespace pegasus
 
             // When TSR=1, attempts to execute SRET in S-mode (or HS-mode)
             // will raise an illegal instruction exception
-            const uint32_t tsr_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "tsr");
+            const uint32_t tsr_val = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::TSR);
             if (tsr_val && !virt_mode && (state->getPrivMode() == PrivMode::SUPERVISOR))
             {
                 THROW_ILLEGAL_INST;
@@ -973,15 +974,15 @@ namespace pegasus
                                  & state->getCore()->getPcAlignmentMask());
 
                 // Get the previous privilege mode from the VSPP field of MSTATUS
-                prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, VSSTATUS, "spp");
+                prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, CSR::VSSTATUS::SPP);
 
                 // Set SIE = MSTATUS[SPIE] and reset SPIE
-                WRITE_CSR_FIELD<XLEN>(state, VSSTATUS, "sie",
-                                      READ_CSR_FIELD<XLEN>(state, MSTATUS, "spie"));
-                WRITE_CSR_FIELD<XLEN>(state, VSSTATUS, "spie", (XLEN)1);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::VSSTATUS::SIE,
+                                      READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SPIE));
+                WRITE_CSR_FIELD<XLEN>(state, CSR::VSSTATUS::SPIE, (XLEN)1);
 
                 // Reset SPP
-                WRITE_CSR_FIELD<XLEN>(state, VSSTATUS, "spp", (XLEN)PrivMode::USER);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::VSSTATUS::SPP, (XLEN)PrivMode::USER);
             }
             else
             {
@@ -990,26 +991,26 @@ namespace pegasus
                                  & state->getCore()->getPcAlignmentMask());
 
                 // Get the previous privilege mode from the SPP field of MSTATUS
-                prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, SSTATUS, "spp");
+                prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SPP);
 
                 // Set SIE = MSTATUS[SPIE] and reset SPIE
-                WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "sie",
-                                      READ_CSR_FIELD<XLEN>(state, MSTATUS, "spie"));
-                WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "spie", (XLEN)1);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SIE,
+                                      READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SPIE));
+                WRITE_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SPIE, (XLEN)1);
 
                 // Reset SPP
-                WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "spp", (XLEN)PrivMode::USER);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SPP, (XLEN)PrivMode::USER);
 
                 if (state->getCore()->hasHypervisor())
                 {
-                    prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, HSTATUS, "spvp");
-                    WRITE_CSR_FIELD<XLEN>(state, HSTATUS, "spv", (XLEN)0);
+                    prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, CSR::HSTATUS::SPVP);
+                    WRITE_CSR_FIELD<XLEN>(state, CSR::HSTATUS::SPV, (XLEN)0);
                 }
 
                 // Reset the MPRV bit
                 // TODO: Will need to update the load/store translation mode when translation is
                 // supported
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mprv", (XLEN)0);
+                WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MPRV, (XLEN)0);
             }
         }
 
@@ -1041,9 +1042,11 @@ namespace pegasus
                                       READ_INT_REG<XLEN>(state, 13), READ_INT_REG<XLEN>(state, 14),
                                       READ_INT_REG<XLEN>(state, 15), READ_INT_REG<XLEN>(state, 16)};
 
-        auto mem = state->getCore()->getSystem()->getSystemMemory();
+        PegasusSystem* system = state->getCore()->getSystem();
+        const auto lock = system->lockMemory();
+        auto mem = system->getSystemMemory();
         auto emulator = state->getCore()->getSystemCallEmulator();
-        auto ret_code = static_cast<XLEN>(emulator->emulateSystemCall(call_stack, mem));
+        auto ret_code = static_cast<XLEN>(emulator->emulateSystemCall(state, call_stack, mem));
         WRITE_INT_REG<XLEN>(state, 10, ret_code);
 
         return ++action_it;
@@ -1071,7 +1074,8 @@ namespace pegasus
         return ++action_it;
     }
 
-    Action::ItrType RviInsts::ebreakHandler_(pegasus::PegasusState* state, Action::ItrType)
+    Action::ItrType RviInsts::ebreakHandler_(pegasus::PegasusState* state,
+                                             Action::ItrType action_it)
     {
         ///////////////////////////////////////////////////////////////////////
         // START OF SPIKE CODE
@@ -1095,7 +1099,7 @@ namespace pegasus
 
     Action::ItrType RviInsts::fenceHandler_(pegasus::PegasusState* state, Action::ItrType action_it)
     {
-        (void)state;
+        state->noteSyncInst();
         return ++action_it;
     }
 
@@ -1120,12 +1124,32 @@ namespace pegasus
         // END OF SPIKE CODE
         ///////////////////////////////////////////////////////////////////////
 
-        const uint32_t tvm_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "tvm");
+        const uint32_t tvm_val = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::TVM);
         if ((state->getPrivMode() == PrivMode::SUPERVISOR) && tvm_val)
         {
             THROW_ILLEGAL_INST;
         }
 
+        // rs1 == x0 flushes all addresses, rs2 == x0 flushes all address spaces
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        std::optional<Addr> vaddr;
+        std::optional<uint32_t> asid;
+        if (inst->getRs1() != 0)
+        {
+            vaddr = READ_INT_REG<XLEN>(state, inst->getRs1());
+        }
+        if (inst->getRs2() != 0)
+        {
+            asid = READ_INT_REG<XLEN>(state, inst->getRs2());
+        }
+
+        // In VS-mode, SFENCE.VMA operates on the VS-stage translations of the current VM
+        const translate_types::TranslationStage stage =
+            state->getVirtualMode() ? translate_types::TranslationStage::VIRTUAL_SUPERVISOR
+                                    : translate_types::TranslationStage::SUPERVISOR;
+        state->getTranslateUnit()->fenceVma(stage, vaddr, asid);
+        state->getFetchUnit()->getDecodeCache()->resetCursor();
+
         return ++action_it;
     }
 
@@ -1150,7 +1174,7 @@ namespace pegasus
         // END OF SPIKE CODE
         ///////////////////////////////////////////////////////////////////////
 
-        const uint32_t tw_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "tw");
+        const uint32_t tw_val = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::TW);
         if (tw_val)
         {
             THROW_ILLEGAL_INST;
@@ -1163,6 +1187,11 @@ namespace pegasus
             ActionGroup* inst_action_group = state->getCurrentInst()->getActionGroup();
             inst_action_group->setNextActionGroup(state->getStopSimActionGroup());
         }
+        else
+        {
+            // The core skips the hart until an interrupt is pending or no other hart can run
+            state->pauseHart(SimPauseReason::WFI);
+        }
         return ++action_it;
     }
 
@@ -343,8 +343,8 @@ namespace pegasus
         using S = typename decltype(elems_vs2)::ElemType::ValueType;
         using R = typename decltype(elems_vd)::ElemType::ValueType;
         Functor functor{};
-        sat = READ_CSR_FIELD<XLEN>(state, VXSAT, "VXSAT");
-        xrm = static_cast<Xrm>(READ_CSR_FIELD<XLEN>(state, VXRM, "VXRM"));
+        sat = READ_CSR_FIELD<XLEN>(state, CSR::VXSAT::VXSAT);
+        xrm = static_cast<Xrm>(READ_CSR_FIELD<XLEN>(state, CSR::VXRM::VXRM));
 
         auto execute = [&](auto iter, const auto & end)
         {
@@ -382,8 +382,8 @@ namespace pegasus
             const MaskElements mask_elems{state, inst->getVecConfig(), pegasus::V0};
             execute(mask_elems.maskBitIterBegin(), mask_elems.maskBitIterEnd());
         }
-        WRITE_CSR_FIELD<XLEN>(state, VXSAT, "VXSAT", sat);
-        WRITE_CSR_FIELD<XLEN>(state, VCSR, "VXSAT", sat);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::VXSAT::VXSAT, sat);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::VCSR::VXSAT, sat);
 
         return ++action_it;
     }
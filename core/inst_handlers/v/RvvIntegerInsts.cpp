@@ -1,3 +1,4 @@
+#include <array>
 #include <limits>
 
 #include "core/inst_handlers/v/RvvIntegerInsts.hpp"
@@ -1355,11 +1356,91 @@ namespace pegasus
         return ++action_it;
     }
 
+    // Division by zero traps on the host, so these functors cannot be applied to inactive
+    // elements and then blended away
+    template <template <typename> typename FunctorT, typename T>
+    constexpr bool isSafeForInactiveElems = !std::is_same_v<FunctorT<T>, std::divides<T>>
+                                            && !std::is_same_v<FunctorT<T>, std::modulus<T>>;
+
+    // Register group version of viBinaryHelper for vstart == 0. The operands are copied out of
+    // the register groups once and the loops below are simple enough for the compiler to
+    // vectorize. Masked off elements are blended with the previous destination value and tail
+    // elements are not written, which is what the element path does.
+    template <typename XLEN, size_t elemWidth, OperandMode opMode,
+              template <typename> typename FunctorT, typename T>
+    void viBinaryGroupHelper(PegasusState* state)
+    {
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const size_t vl = inst->getVecConfig()->getVL();
+
+        using S1 = UintType<elemWidth>;
+        using S2 = UintType<opMode.src2 == OperandMode::Mode::W ? 2 * elemWidth : elemWidth>;
+        using R = UintType<opMode.dst == OperandMode::Mode::W ? 2 * elemWidth : elemWidth>;
+        constexpr auto ext = [](auto value)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                return sext<T>(value);
+            }
+            else
+            {
+                return zext<T>(value);
+            }
+        };
+
+        alignas(64) std::array<S2, VREG_GROUP_MAX_BYTES / sizeof(S2)> vs2;
+        alignas(64) std::array<R, VREG_GROUP_MAX_BYTES / sizeof(R)> vd;
+        readVecRegGroup(state, inst->getRs2(), vs2.data(), vl * sizeof(S2));
+
+        FunctorT<T> functor{};
+        if constexpr (opMode.src1 == OperandMode::Mode::V)
+        {
+            alignas(64) std::array<S1, VREG_GROUP_MAX_BYTES / sizeof(S1)> vs1;
+            readVecRegGroup(state, inst->getRs1(), vs1.data(), vl * sizeof(S1));
+            for (size_t i = 0; i < vl; ++i)
+            {
+                vd[i] = static_cast<R>(functor(ext(vs2[i]), ext(vs1[i])));
+            }
+        }
+        else
+        {
+            const T scalar = (opMode.src1 == OperandMode::Mode::X)
+                                 ? ext(READ_INT_REG<XLEN>(state, inst->getRs1()))
+                                 : ext(inst->getImmediate());
+            for (size_t i = 0; i < vl; ++i)
+            {
+                vd[i] = static_cast<R>(functor(ext(vs2[i]), scalar));
+            }
+        }
+
+        if (!inst->getVM())
+        {
+            alignas(64) std::array<R, VREG_GROUP_MAX_BYTES / sizeof(R)> vd_prev;
+            alignas(64) std::array<uint8_t, VLEN_MAX / 8> mask;
+            readVecRegGroup(state, inst->getRd(), vd_prev.data(), vl * sizeof(R));
+            readVecRegGroup(state, pegasus::V0, mask.data(), (vl + 7) / 8);
+            for (size_t i = 0; i < vl; ++i)
+            {
+                const bool active = (mask[i / 8] >> (i % 8)) & 1;
+                vd[i] = active ? vd[i] : vd_prev[i];
+            }
+        }
+
+        writeVecRegGroup(state, inst->getRd(), vd.data(), vl * sizeof(R));
+    }
+
     template <typename XLEN, size_t elemWidth, OperandMode opMode,
               template <typename> typename FunctorT, typename T>
     Action::ItrType viBinaryHelper(PegasusState* state, Action::ItrType action_it)
     {
         const PegasusInstPtr & inst = state->getCurrentInst();
+        if (inst->getVecConfig()->getVSTART() == 0
+            && (inst->getVM() || isSafeForInactiveElems<FunctorT, T>))
+        {
+            viBinaryGroupHelper<XLEN, elemWidth, opMode, FunctorT, T>(state);
+            return ++action_it;
+        }
+
         auto elems_vs1 =
             opMode.src1 != OperandMode::Mode::V
                 ? Elements<Element<elemWidth>, false>{}
@@ -2,8 +2,15 @@
 #include "core/PegasusState.hpp"
 #include "core/ActionGroup.hpp"
 #include "core/VecElements.hpp"
+#include "core/Trap.hpp"
 #include "include/ActionTags.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <set>
+#include <utility>
+
 namespace pegasus
 {
     template <typename XLEN>
@@ -335,6 +342,15 @@ namespace pegasus
             pegasus::Action::createAction<
                 &RvvLoadStoreInsts::vlsreComputeAddressHandler_<XLEN, VLEN_MIN>, RvvLoadStoreInsts>(
                 nullptr, "vs8r.v", ActionTags::COMPUTE_ADDR_TAG));
+
+        // Segment loads and stores with 2 to 8 fields
+        [&]<size_t... N>(std::index_sequence<N...>)
+        {
+            (getSegmentComputeAddressHandlers_<XLEN, N + 2, 8>(inst_handlers), ...);
+            (getSegmentComputeAddressHandlers_<XLEN, N + 2, 16>(inst_handlers), ...);
+            (getSegmentComputeAddressHandlers_<XLEN, N + 2, 32>(inst_handlers), ...);
+            (getSegmentComputeAddressHandlers_<XLEN, N + 2, 64>(inst_handlers), ...);
+        }(std::make_index_sequence<7>{});
     }
 
     template <typename XLEN>
@@ -343,36 +359,36 @@ namespace pegasus
         static_assert(std::is_same_v<XLEN, RV64> || std::is_same_v<XLEN, RV32>);
 
         inst_handlers.emplace(
-            "vle8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<8, true>,
+            "vle8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<8, true>,
                                                     RvvLoadStoreInsts>(nullptr, "vle8.v",
                                                                        ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vle16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<16, true>,
+            "vle16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<16, true>,
                                                      RvvLoadStoreInsts>(nullptr, "vle16.v",
                                                                         ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vle32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<32, true>,
+            "vle32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<32, true>,
                                                      RvvLoadStoreInsts>(nullptr, "vle32.v",
                                                                         ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vle64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<64, true>,
+            "vle64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<64, true>,
                                                      RvvLoadStoreInsts>(nullptr, "vle64.v",
                                                                         ActionTags::EXECUTE_TAG));
 
         inst_handlers.emplace(
-            "vse8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<8, false>,
+            "vse8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<8, false>,
                                                     RvvLoadStoreInsts>(nullptr, "vse8.v",
                                                                        ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vse16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<16, false>,
+            "vse16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<16, false>,
                                                      RvvLoadStoreInsts>(nullptr, "vse16.v",
                                                                         ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vse32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<32, false>,
+            "vse32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<32, false>,
                                                      RvvLoadStoreInsts>(nullptr, "vse32.v",
                                                                         ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vse64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<64, false>,
+            "vse64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<64, false>,
                                                      RvvLoadStoreInsts>(nullptr, "vse64.v",
                                                                         ActionTags::EXECUTE_TAG));
 
@@ -420,93 +436,109 @@ namespace pegasus
                                                                          ActionTags::EXECUTE_TAG));
 
         inst_handlers.emplace(
-            "vloxei8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                       RvvLoadStoreInsts>(nullptr, "vloxei8.v",
-                                                                          ActionTags::EXECUTE_TAG));
+            "vloxei8.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<8, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vloxei8.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vloxei16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vloxei16.v", ActionTags::EXECUTE_TAG));
+            "vloxei16.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<16, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vloxei16.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vloxei32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vloxei32.v", ActionTags::EXECUTE_TAG));
+            "vloxei32.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<32, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vloxei32.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vloxei64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vloxei64.v", ActionTags::EXECUTE_TAG));
+            "vloxei64.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<64, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vloxei64.v",
+                                                             ActionTags::EXECUTE_TAG));
 
         inst_handlers.emplace(
-            "vluxei8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                       RvvLoadStoreInsts>(nullptr, "vluxei8.v",
-                                                                          ActionTags::EXECUTE_TAG));
+            "vluxei8.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<8, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vluxei8.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vluxei16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vluxei16.v", ActionTags::EXECUTE_TAG));
+            "vluxei16.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<16, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vluxei16.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vluxei32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vluxei32.v", ActionTags::EXECUTE_TAG));
+            "vluxei32.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<32, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vluxei32.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vluxei64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<true>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vluxei64.v", ActionTags::EXECUTE_TAG));
+            "vluxei64.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<64, true>,
+                                          RvvLoadStoreInsts>(nullptr, "vluxei64.v",
+                                                             ActionTags::EXECUTE_TAG));
 
         inst_handlers.emplace(
             "vle8ff.v",
-            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<8, true, true>,
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<8, true, true>,
                                           RvvLoadStoreInsts>(nullptr, "vle8ff.v",
                                                              ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
             "vle16ff.v",
-            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<16, true, true>,
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<16, true, true>,
                                           RvvLoadStoreInsts>(nullptr, "vle16ff.v",
                                                              ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
             "vle32ff.v",
-            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<32, true, true>,
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<32, true, true>,
                                           RvvLoadStoreInsts>(nullptr, "vle32ff.v",
                                                              ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
             "vle64ff.v",
-            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseHandler_<64, true, true>,
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vleHandler_<64, true, true>,
                                           RvvLoadStoreInsts>(nullptr, "vle64ff.v",
                                                              ActionTags::EXECUTE_TAG));
 
         inst_handlers.emplace(
-            "vsoxei8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                       RvvLoadStoreInsts>(nullptr, "vsoxei8.v",
-                                                                          ActionTags::EXECUTE_TAG));
+            "vsoxei8.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<8, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsoxei8.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vsoxei16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vsoxei16.v", ActionTags::EXECUTE_TAG));
+            "vsoxei16.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<16, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsoxei16.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vsoxei32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vsoxei32.v", ActionTags::EXECUTE_TAG));
+            "vsoxei32.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<32, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsoxei32.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vsoxei64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vsoxei64.v", ActionTags::EXECUTE_TAG));
+            "vsoxei64.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<64, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsoxei64.v",
+                                                             ActionTags::EXECUTE_TAG));
 
         inst_handlers.emplace(
-            "vsuxei8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                       RvvLoadStoreInsts>(nullptr, "vsuxei8.v",
-                                                                          ActionTags::EXECUTE_TAG));
+            "vsuxei8.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<8, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsuxei8.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vsuxei16.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vsuxei16.v", ActionTags::EXECUTE_TAG));
+            "vsuxei16.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<16, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsuxei16.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vsuxei32.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vsuxei32.v", ActionTags::EXECUTE_TAG));
+            "vsuxei32.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<32, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsuxei32.v",
+                                                             ActionTags::EXECUTE_TAG));
         inst_handlers.emplace(
-            "vsuxei64.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<false>,
-                                                        RvvLoadStoreInsts>(
-                              nullptr, "vsuxei64.v", ActionTags::EXECUTE_TAG));
+            "vsuxei64.v",
+            pegasus::Action::createAction<&RvvLoadStoreInsts::vlseIdxHandler_<64, false>,
+                                          RvvLoadStoreInsts>(nullptr, "vsuxei64.v",
+                                                             ActionTags::EXECUTE_TAG));
 
         inst_handlers.emplace(
             "vl1re8.v", pegasus::Action::createAction<&RvvLoadStoreInsts::vlsreHandler_<8, true>,
@@ -596,6 +628,99 @@ namespace pegasus
             pegasus::Action::createAction<&RvvLoadStoreInsts::vlsreHandler_<VLEN_MIN, false>,
                                           RvvLoadStoreInsts>(nullptr, "vs8r.v",
                                                              ActionTags::EXECUTE_TAG));
+
+        // Segment loads and stores with 2 to 8 fields
+        [&]<size_t... N>(std::index_sequence<N...>)
+        {
+            (getSegmentHandlers_<N + 2, 8>(inst_handlers), ...);
+            (getSegmentHandlers_<N + 2, 16>(inst_handlers), ...);
+            (getSegmentHandlers_<N + 2, 32>(inst_handlers), ...);
+            (getSegmentHandlers_<N + 2, 64>(inst_handlers), ...);
+        }(std::make_index_sequence<7>{});
+    }
+
+    // Segment mnemonics are generated, the Action only keeps a pointer to its name
+    template <auto HandlerT>
+    void addSegmentHandler(std::map<std::string, Action> & inst_handlers,
+                           const std::string & mnemonic, const ActionTagType tag)
+    {
+        static std::set<std::string> names;
+        const char* name = names.insert(mnemonic).first->c_str();
+        inst_handlers.emplace(mnemonic, pegasus::Action::createAction<HandlerT, RvvLoadStoreInsts>(
+                                            nullptr, name, tag));
+    }
+
+    template <typename XLEN, size_t nfields, size_t elemWidth>
+    void RvvLoadStoreInsts::getSegmentComputeAddressHandlers_(
+        std::map<std::string, Action> & inst_handlers)
+    {
+        const std::string seg = "seg" + std::to_string(nfields);
+        const std::string eew = std::to_string(elemWidth);
+        const ActionTagType tag = ActionTags::COMPUTE_ADDR_TAG;
+
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::UNIT>>(inst_handlers,
+                                                             "vl" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::UNIT>>(inst_handlers,
+                                                             "vs" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::UNIT, true>>(
+            inst_handlers, "vl" + seg + "e" + eew + "ff.v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::STRIDED>>(
+            inst_handlers, "vls" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::STRIDED>>(
+            inst_handlers, "vss" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::IDX_ORDERED>>(
+            inst_handlers, "vlox" + seg + "ei" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::IDX_UNORDERED>>(
+            inst_handlers, "vlux" + seg + "ei" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::IDX_ORDERED>>(
+            inst_handlers, "vsox" + seg + "ei" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegComputeAddressHandler_<
+            XLEN, elemWidth, nfields, AddressingMode::IDX_UNORDERED>>(
+            inst_handlers, "vsux" + seg + "ei" + eew + ".v", tag);
+    }
+
+    template <size_t nfields, size_t elemWidth>
+    void RvvLoadStoreInsts::getSegmentHandlers_(std::map<std::string, Action> & inst_handlers)
+    {
+        const std::string seg = "seg" + std::to_string(nfields);
+        const std::string eew = std::to_string(elemWidth);
+        const ActionTagType tag = ActionTags::EXECUTE_TAG;
+
+        addSegmentHandler<
+            &RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields, AddressingMode::UNIT, true>>(
+            inst_handlers, "vl" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<
+            &RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields, AddressingMode::UNIT, false>>(
+            inst_handlers, "vs" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields,
+                                                            AddressingMode::UNIT, true, true>>(
+            inst_handlers, "vl" + seg + "e" + eew + "ff.v", tag);
+        addSegmentHandler<
+            &RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields, AddressingMode::STRIDED, true>>(
+            inst_handlers, "vls" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<
+            &RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields, AddressingMode::STRIDED, false>>(
+            inst_handlers, "vss" + seg + "e" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields,
+                                                            AddressingMode::IDX_ORDERED, true>>(
+            inst_handlers, "vlox" + seg + "ei" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields,
+                                                            AddressingMode::IDX_UNORDERED, true>>(
+            inst_handlers, "vlux" + seg + "ei" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields,
+                                                            AddressingMode::IDX_ORDERED, false>>(
+            inst_handlers, "vsox" + seg + "ei" + eew + ".v", tag);
+        addSegmentHandler<&RvvLoadStoreInsts::vlsegHandler_<elemWidth, nfields,
+                                                            AddressingMode::IDX_UNORDERED, false>>(
+            inst_handlers, "vsux" + seg + "ei" + eew + ".v", tag);
     }
 
     template void
@@ -605,84 +730,739 @@ namespace pegasus
     template void RvvLoadStoreInsts::getInstHandlers<RV32>(std::map<std::string, Action> &);
     template void RvvLoadStoreInsts::getInstHandlers<RV64>(std::map<std::string, Action> &);
 
-    template <typename XLEN, size_t elemWidth, RvvLoadStoreInsts::AddressingMode addrMode,
-              bool ffirst>
-    Action::ItrType RvvLoadStoreInsts::vlseComputeAddressHandler_(pegasus::PegasusState* state,
-                                                                  Action::ItrType action_it)
+    // Vector memory accesses are translated a page at a time instead of an element at a time.
+    // Unit-stride and whole register accesses are also copied a page at a time if possible.
+    constexpr Addr VEC_MEM_PAGE_SIZE = 0x1000;
+
+    // Part of a unit-stride access within one page
+    struct UnitStridePage
     {
-        static_assert(std::is_same<XLEN, RV64>::value || std::is_same<XLEN, RV32>::value);
+        Addr start;
+        Addr end;
+        // All elements in the page are active
+        bool dense;
+    };
 
-        const PegasusInstPtr & inst = state->getCurrentInst();
-        VectorConfig* config = inst->getVecConfig();
-        const size_t eewb = elemWidth / 8;
-        const XLEN rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
+    // A register group (VREG_GROUP_MAX_BYTES) is smaller than a page, so it spans at most two
+    using UnitStridePages =
+        std::array<UnitStridePage, VREG_GROUP_MAX_BYTES / VEC_MEM_PAGE_SIZE + 2>;
 
-        Addr stride;
-        if constexpr (addrMode == AddressingMode::UNIT)
+    // Mask bit of element idx, mask is nullptr for unmasked accesses
+    inline bool isElemActive(const uint8_t* mask, const size_t idx)
+    {
+        return (mask == nullptr) || ((mask[idx / 8] >> (idx % 8)) & 1);
+    }
+
+    using MaskBits = std::array<uint8_t, VLEN_MAX / 8>;
+
+    // Mask bits of the elements [0, vl) of a masked access, nullptr for unmasked accesses
+    inline const uint8_t* readMask(PegasusState* state, const bool masked, const size_t vl,
+                                   MaskBits & mask)
+    {
+        if (!masked)
         {
-            stride = eewb;
+            return nullptr;
         }
-        else if constexpr (addrMode == AddressingMode::STRIDED)
+        readVecRegGroup(state, pegasus::V0, mask.data(), (vl + 7) / 8);
+        return mask.data();
+    }
+
+    // Pages touched by the active elements [vstart, vl) of a unit-stride access at base, clipped
+    // to the access. Returns the number of pages.
+    template <size_t elemWidth>
+    size_t getUnitStridePages(const Addr base, const size_t vstart, const size_t vl,
+                              const uint8_t* mask, UnitStridePages & pages)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        const Addr end = base + vl * eewb;
+        size_t num_pages = 0;
+        for (Addr start = base + vstart * eewb; start < end;)
         {
-            stride = READ_INT_REG<XLEN>(state, inst->getRs2());
+            const Addr page_end =
+                std::min(end, (start & ~(VEC_MEM_PAGE_SIZE - 1)) + VEC_MEM_PAGE_SIZE);
+            size_t num_active = 0;
+            size_t num_elems = 0;
+            for (size_t idx = (start - base) / eewb; (base + idx * eewb) < page_end; ++idx)
+            {
+                num_active += isElemActive(mask, idx);
+                ++num_elems;
+            }
+
+            if (num_active > 0)
+            {
+                sparta_assert(num_pages < pages.size());
+                pages[num_pages++] = {start, page_end, num_active == num_elems};
+            }
+            start = page_end;
         }
-        if (inst->getVM())
+        return num_pages;
+    }
+
+    // Base address or stride, the execute Actions do not know XLEN
+    inline Addr readAddrReg(PegasusState* state, const uint32_t reg_num)
+    {
+        return (state->getXlen() == 64) ? READ_INT_REG<RV64>(state, reg_num)
+                                        : READ_INT_REG<RV32>(state, reg_num);
+    }
+
+    // End of the first active element [vstart, vl) of a unit-stride access at base, base if no
+    // element is active. Elements of segment accesses are fields, the end is the end of the
+    // segment of the first active field.
+    template <size_t elemWidth, size_t nfields = 1>
+    Addr getFirstActiveElemEnd(const Addr base, const size_t vstart, const size_t vl,
+                               const uint8_t* mask)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        for (size_t idx = vstart; idx < vl; ++idx)
         {
-            for (size_t i = config->getVSTART(); i < config->getVL(); ++i)
+            if (isElemActive(mask, idx))
             {
-                const bool throw_fault = ffirst && (i == 0);
-                inst->getTranslationState()->makeRequest(rs1_val + i * stride, eewb, throw_fault);
+                return base + (idx / nfields + 1) * nfields * eewb;
             }
         }
-        else // masked
+        return base;
+    }
+
+    // Request one translation per page of a unit-stride access. The translate Action resolves
+    // the most recent request first, so pages are requested last to first to be translated (and
+    // to fault) in element order. For fault-only-first loads only the pages of the first active
+    // element (or segment) can trap, it may straddle two pages: a fault on a later page drops the
+    // remaining requests and the load is cut short there.
+    template <size_t elemWidth, bool ffirst = false, size_t nfields = 1>
+    void makeUnitStrideRequests(PegasusState* state, const Addr base, const size_t vstart,
+                                const size_t vl, const uint8_t* mask)
+    {
+        UnitStridePages pages;
+        const size_t num_pages = getUnitStridePages<elemWidth>(base, vstart, vl, mask, pages);
+        const Addr first_elem_end =
+            ffirst ? getFirstActiveElemEnd<elemWidth, nfields>(base, vstart, vl, mask) : base;
+        PegasusTranslationState* translation_state =
+            state->getCurrentInst()->getTranslationState();
+        for (size_t i = num_pages; i-- > 0;)
         {
-            const MaskElements mask_elems{state, config, pegasus::V0};
-            for (auto mask_iter = mask_elems.maskBitIterBegin();
-                 mask_iter != mask_elems.maskBitIterEnd(); ++mask_iter)
+            const bool nothrow = ffirst && (pages[i].start >= first_elem_end);
+            translation_state->makeRequest(pages[i].start, pages[i].end - pages[i].start,
+                                           nothrow);
+        }
+    }
+
+    template <typename T, bool isLoad>
+    void accessMemory(PegasusState* state,
+                      const PegasusTranslationState::TranslationResult & result, uint8_t* data)
+    {
+        T value;
+        if constexpr (isLoad)
+        {
+            value = state->readMemory<T>(result, MemAccessSource::INSTRUCTION);
+            memcpy(data, &value, sizeof(T));
+        }
+        else
+        {
+            memcpy(&value, data, sizeof(T));
+            state->writeMemory<T>(result, value, MemAccessSource::INSTRUCTION);
+        }
+    }
+
+    // Access the active elements of one page through readMemory/writeMemory, so observers see
+    // every element. Elements split across two pages are accessed a byte at a time. Element idx
+    // is at byte idx * eewb of elems.
+    template <size_t elemWidth, bool isLoad>
+    void accessUnitStridePage(PegasusState* state, const UnitStridePage & page, const Addr paddr,
+                              const Addr base, const uint8_t* mask, uint8_t* elems)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        for (Addr vaddr = page.start; vaddr < page.end;)
+        {
+            const size_t idx = (vaddr - base) / eewb;
+            const Addr elem_start = base + idx * eewb;
+            const bool whole_elem = (vaddr == elem_start) && ((elem_start + eewb) <= page.end);
+            const size_t size = whole_elem ? eewb : 1;
+            if (isElemActive(mask, idx))
             {
-                const auto i = mask_iter.getIndex();
-                if (ffirst && i == 0)
+                const PegasusTranslationState::TranslationResult result{
+                    vaddr, paddr + (vaddr - page.start), size};
+                uint8_t* data = elems + (vaddr - base);
+                if (whole_elem)
                 {
-                    inst->getTranslationState()->makeRequest(rs1_val + i * stride, eewb, true);
+                    accessMemory<UintType<elemWidth>, isLoad>(state, result, data);
                 }
                 else
                 {
-                    inst->getTranslationState()->makeRequest(rs1_val + i * stride, eewb);
+                    accessMemory<uint8_t, isLoad>(state, result, data);
                 }
             }
+            vaddr += size;
         }
-        return ++action_it;
     }
 
-    template <typename XLEN, size_t elemWidth, RvvLoadStoreInsts::AddressingMode addrMode>
-    Action::ItrType RvvLoadStoreInsts::vlseIdxComputeAddressHandler_(pegasus::PegasusState* state,
-                                                                     Action::ItrType action_it)
+    // Execute a unit-stride access translated by makeUnitStrideRequests, elems holds element idx
+    // at byte idx * eewb. Each page is copied with a single memcpy between memory and elems,
+    // unless the memory must go through the memory map (e.g. observers are watching it) or some
+    // elements in the page are masked off. Returns the new vl, which is less than vl if a
+    // fault-only-first load was cut short.
+    template <size_t elemWidth, bool isLoad, bool ffirst = false>
+    size_t copyUnitStride(PegasusState* state, const Addr base, const size_t vstart, size_t vl,
+                          const uint8_t* mask, uint8_t* elems)
     {
-        static_assert(std::is_same<XLEN, RV64>::value || std::is_same<XLEN, RV32>::value);
+        constexpr size_t eewb = elemWidth / 8;
+        UnitStridePages pages;
+        const size_t num_pages = getUnitStridePages<elemWidth>(base, vstart, vl, mask, pages);
 
-        const PegasusInstPtr & inst = state->getCurrentInst();
-        const VectorConfig* vector_config = inst->getVecConfig();
-        const size_t sewb = vector_config->getSEW() / 8;
-        const XLEN rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
-        Elements<Element<elemWidth>, false> elems_vs2{state, inst->getVecConfig(), inst->getRs2()};
+        // The last page translated is on top
+        PegasusTranslationState* translation_state =
+            state->getCurrentInst()->getTranslationState();
+        const size_t num_translated = translation_state->getNumResults();
+        sparta_assert(num_translated == num_pages || (ffirst && num_translated < num_pages),
+                      "Expected " << num_pages << " translated pages, got " << num_translated);
+        std::array<Addr, std::tuple_size_v<UnitStridePages>> paddrs;
+        for (size_t i = num_translated; i-- > 0;)
+        {
+            paddrs[i] = translation_state->getResult().getPAddr();
+            translation_state->popResult();
+        }
+
+        if (num_translated < num_pages)
+        {
+            // Stop at the first element that is not entirely in a translated page
+            vl = (num_translated == 0) ? vstart : (pages[num_translated - 1].end - base) / eewb;
+        }
 
-        if (inst->getVM())
+        for (size_t i = 0; i < num_translated; ++i)
         {
-            for (auto stride : elems_vs2)
+            const UnitStridePage & page = pages[i];
+            const size_t offset = page.start - base;
+            const size_t size = page.end - page.start;
+            if constexpr (isLoad)
             {
-                inst->getTranslationState()->makeRequest(rs1_val + stride.getVal(), sewb);
+                if (page.dense && state->readMemoryBlock(paddrs[i], elems + offset, size))
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                if (page.dense && state->writeMemoryBlock(paddrs[i], elems + offset, size))
+                {
+                    continue;
+                }
+            }
+            accessUnitStridePage<elemWidth, isLoad>(state, page, paddrs[i], base, mask, elems);
+        }
+        return vl;
+    }
+
+    // Unit-stride access of the register group at reg_id, returns the new vl
+    template <size_t elemWidth, bool isLoad, bool ffirst = false>
+    size_t unitStrideAccess(PegasusState* state, const uint32_t reg_id, const Addr base,
+                            const size_t vstart, const size_t vl, const bool masked)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        MaskBits mask;
+        const uint8_t* mask_ptr = readMask(state, masked, vl, mask);
+
+        sparta_assert((vl * eewb) <= VREG_GROUP_MAX_BYTES);
+        alignas(64) std::array<uint8_t, VREG_GROUP_MAX_BYTES> group;
+        if (!isLoad || masked || (vstart > 0))
+        {
+            // Elements that are not loaded keep their value
+            readVecRegGroup(state, reg_id, group.data(), vl * eewb);
+        }
+
+        const size_t new_vl =
+            copyUnitStride<elemWidth, isLoad, ffirst>(state, base, vstart, vl, mask_ptr,
+                                                      group.data());
+        if constexpr (isLoad)
+        {
+            writeVecRegGroup(state, reg_id, group.data(), new_vl * eewb);
+        }
+        return new_vl;
+    }
+
+    // Pages touched by the active elements of a strided or indexed access, in the order they are
+    // first touched. Each page is translated once, through the first address that touched it. An
+    // access that touches more pages than can be translated at once is split into batches.
+    class ElemPageTable
+    {
+      public:
+        static constexpr uint32_t MAX_PAGES = PegasusTranslationState::MAX_TRANSLATION;
+
+        // An element, or a segment of contiguous fields, touches at most two pages
+        bool isFull() const { return (num_pages_ + 2) > MAX_PAGES; }
+
+        // Add the page containing vaddr if it is not in the table yet
+        void addPage(const Addr vaddr)
+        {
+            uint32_t & slot = slots_[findSlot_(vaddr)];
+            if (slot == 0)
+            {
+                sparta_assert(num_pages_ < MAX_PAGES);
+                vaddrs_[num_pages_++] = vaddr;
+                slot = num_pages_;
             }
         }
+
+        // Index of the page containing vaddr, which must have been added
+        uint32_t getPageIndex(const Addr vaddr) const
+        {
+            const uint32_t slot = slots_[findSlot_(vaddr)];
+            sparta_assert(slot != 0);
+            return slot - 1;
+        }
+
+        uint32_t getNumPages() const { return num_pages_; }
+
+        // Address the page is translated through
+        Addr getVAddr(const uint32_t page_idx) const { return vaddrs_[page_idx]; }
+
+      private:
+        // Open addressing hash table of page numbers, a slot holds the page index + 1
+        static constexpr uint32_t NUM_SLOTS = 2 * MAX_PAGES;
+
+        uint32_t findSlot_(const Addr vaddr) const
+        {
+            const Addr page = vaddr / VEC_MEM_PAGE_SIZE;
+            uint32_t hash = (page * 0x9e3779b97f4a7c15ull) >> 32;
+            while (true)
+            {
+                const uint32_t slot_idx = hash % NUM_SLOTS;
+                const uint32_t slot = slots_[slot_idx];
+                if ((slot == 0) || ((vaddrs_[slot - 1] / VEC_MEM_PAGE_SIZE) == page))
+                {
+                    return slot_idx;
+                }
+                ++hash;
+            }
+        }
+
+        std::array<Addr, MAX_PAGES> vaddrs_;
+        std::array<uint32_t, NUM_SLOTS> slots_{};
+        uint32_t num_pages_ = 0;
+    };
+
+    // Build the page table of the active elements [vstart, vl), elem_vaddr(idx) is the address of
+    // element idx. An element split across two pages adds both. Returns the end of the batch: the
+    // first element (or segment of nfields fields) whose pages may not fit in the table, vl if
+    // all of them fit.
+    template <size_t elemWidth, size_t nfields = 1, typename ElemVAddrFunc>
+    size_t getElemPages(const size_t vstart, const size_t vl, const uint8_t* mask,
+                        const ElemVAddrFunc & elem_vaddr, ElemPageTable & pages)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        for (size_t idx = vstart; idx < vl; ++idx)
+        {
+            if (SPARTA_EXPECT_FALSE(((idx % nfields) == 0) && pages.isFull()))
+            {
+                return idx;
+            }
+
+            if (isElemActive(mask, idx))
+            {
+                const Addr vaddr = elem_vaddr(idx);
+                pages.addPage(vaddr);
+                const Addr last_vaddr = vaddr + eewb - 1;
+                if (SPARTA_EXPECT_FALSE((last_vaddr / VEC_MEM_PAGE_SIZE)
+                                        != (vaddr / VEC_MEM_PAGE_SIZE)))
+                {
+                    pages.addPage(last_vaddr & ~(VEC_MEM_PAGE_SIZE - 1));
+                }
+            }
+        }
+        return vl;
+    }
+
+    // Request one translation per page touched by the batch of a strided or indexed access that
+    // starts at element vstart. Like unit-stride accesses, pages are requested last to first to
+    // be translated in element order.
+    template <size_t elemWidth, size_t nfields = 1, typename ElemVAddrFunc>
+    void makeElemPageRequests(PegasusState* state, const size_t vstart, const size_t vl,
+                              const uint8_t* mask, const ElemVAddrFunc & elem_vaddr)
+    {
+        ElemPageTable pages;
+        getElemPages<elemWidth, nfields>(vstart, vl, mask, elem_vaddr, pages);
+        PegasusTranslationState* translation_state =
+            state->getCurrentInst()->getTranslationState();
+        translation_state->setBatchStart(vstart);
+        for (uint32_t i = pages.getNumPages(); i-- > 0;)
+        {
+            // Only the page number matters, a byte never crosses a page
+            translation_state->makeRequest(pages.getVAddr(i), 1);
+        }
+    }
+
+    // Execute the batch of a strided or indexed access translated by makeElemPageRequests, elems
+    // holds element idx at byte idx * eewb. Elements are accessed in element order, which is what
+    // ordered indexed stores require, directly through a host pointer per page when there is one
+    // and through readMemory/writeMemory otherwise. Returns the end of the batch, if it is less
+    // than vl the next batch has been requested and must be translated (see retranslate). The
+    // hart's vstart is set to the next batch, so a fault in it restarts the access there, and
+    // cleared after the last batch.
+    template <size_t elemWidth, bool isLoad, size_t nfields = 1, typename ElemVAddrFunc>
+    size_t copyElemPages(PegasusState* state, const size_t vstart, const size_t vl,
+                         const uint8_t* mask, const ElemVAddrFunc & elem_vaddr, uint8_t* elems)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        constexpr Addr PAGE_OFFSET_MASK = VEC_MEM_PAGE_SIZE - 1;
+        PegasusTranslationState* translation_state =
+            state->getCurrentInst()->getTranslationState();
+        const size_t batch_start = std::max(vstart, translation_state->getBatchStart());
+        ElemPageTable pages;
+        const size_t batch_end =
+            getElemPages<elemWidth, nfields>(batch_start, vl, mask, elem_vaddr, pages);
+
+        // The last page translated is on top
+        const uint32_t num_pages = pages.getNumPages();
+        sparta_assert(translation_state->getNumResults() == num_pages,
+                      "Expected " << num_pages << " translated pages, got "
+                                  << translation_state->getNumResults());
+        std::array<Addr, ElemPageTable::MAX_PAGES> page_paddrs;
+        std::array<uint8_t*, ElemPageTable::MAX_PAGES> page_host_ptrs;
+        for (uint32_t i = num_pages; i-- > 0;)
+        {
+            page_paddrs[i] = translation_state->getResult().getPAddr() & ~PAGE_OFFSET_MASK;
+            page_host_ptrs[i] = state->getHostMemory(page_paddrs[i], VEC_MEM_PAGE_SIZE);
+            translation_state->popResult();
+        }
+
+        for (size_t idx = batch_start; idx < batch_end; ++idx)
+        {
+            if (!isElemActive(mask, idx))
+            {
+                continue;
+            }
+
+            const Addr vaddr = elem_vaddr(idx);
+            uint8_t* data = elems + idx * eewb;
+            const size_t page_offset = vaddr & PAGE_OFFSET_MASK;
+            if (SPARTA_EXPECT_TRUE((page_offset + eewb) <= VEC_MEM_PAGE_SIZE))
+            {
+                const uint32_t page_idx = pages.getPageIndex(vaddr);
+                const Addr paddr = page_paddrs[page_idx] + page_offset;
+                uint8_t* host_ptr = page_host_ptrs[page_idx];
+                if (host_ptr == nullptr)
+                {
+                    accessMemory<UintType<elemWidth>, isLoad>(state, {vaddr, paddr, eewb}, data);
+                }
+                else if constexpr (isLoad)
+                {
+                    memcpy(data, host_ptr + page_offset, eewb);
+                }
+                else
+                {
+                    memcpy(host_ptr + page_offset, data, eewb);
+                    state->hostMemoryWritten(paddr, eewb);
+                }
+                continue;
+            }
+
+            // Split across two pages
+            for (size_t i = 0; i < eewb; ++i)
+            {
+                const Addr byte_vaddr = vaddr + i;
+                const Addr paddr = page_paddrs[pages.getPageIndex(byte_vaddr)]
+                                   + (byte_vaddr & PAGE_OFFSET_MASK);
+                accessMemory<uint8_t, isLoad>(state, {byte_vaddr, paddr, 1}, data + i);
+            }
+        }
+
+        // Segment accesses count vstart in segments
+        if (batch_end < vl)
+        {
+            state->getVectorConfig()->setVSTART(batch_end / nfields);
+            makeElemPageRequests<elemWidth, nfields>(state, batch_end, vl, mask, elem_vaddr);
+        }
         else
         {
-            const MaskElements mask_elems{state, inst->getVecConfig(), pegasus::V0};
-            for (auto mask_iter = mask_elems.maskBitIterBegin();
-                 mask_iter != mask_elems.maskBitIterEnd(); ++mask_iter)
+            state->getVectorConfig()->setVSTART(0);
+        }
+        return batch_end;
+    }
+
+    // Run the translate Actions, which follow the compute address Action, again for the next
+    // batch of an access. Called from the execute Action.
+    inline Action::ItrType retranslate(Action::ItrType action_it)
+    {
+        while (!(action_it - 1)->hasTag(ActionTags::COMPUTE_ADDR_TAG))
+        {
+            --action_it;
+        }
+        return action_it;
+    }
+
+    // Strided or indexed access of the register group at reg_id. Returns the end of the batch
+    // that was accessed (see copyElemPages).
+    template <size_t elemWidth, bool isLoad, typename ElemVAddrFunc>
+    size_t elemPageAccess(PegasusState* state, const uint32_t reg_id, const size_t vstart,
+                          const size_t vl, const bool masked, const ElemVAddrFunc & elem_vaddr)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        MaskBits mask;
+        const uint8_t* mask_ptr = readMask(state, masked, vl, mask);
+
+        const size_t num_bytes = vl * eewb;
+        sparta_assert(num_bytes <= VREG_GROUP_MAX_BYTES);
+        alignas(64) std::array<uint8_t, VREG_GROUP_MAX_BYTES> group;
+        // Elements that are not loaded keep their value
+        readVecRegGroup(state, reg_id, group.data(), num_bytes);
+
+        const size_t batch_end = copyElemPages<elemWidth, isLoad>(state, vstart, vl, mask_ptr,
+                                                                  elem_vaddr, group.data());
+
+        if constexpr (isLoad)
+        {
+            writeVecRegGroup(state, reg_id, group.data(), num_bytes);
+        }
+        return batch_end;
+    }
+
+    // Segment accesses are done on the fields in memory order: field f of segment seg is element
+    // seg * nfields + f. Field f of all segments is the register group at reg_id + f * field_regs.
+
+    // Mask of the fields of a segment access, the fields of an active segment are active
+    template <size_t nfields>
+    const uint8_t* readFieldMask(PegasusState* state, const bool masked, const size_t vl,
+                                 MaskBits & field_mask)
+    {
+        if constexpr (nfields == 1)
+        {
+            return readMask(state, masked, vl, field_mask);
+        }
+
+        MaskBits mask;
+        const uint8_t* seg_mask = readMask(state, masked, vl, mask);
+        if (seg_mask == nullptr)
+        {
+            return nullptr;
+        }
+
+        field_mask.fill(0);
+        for (size_t seg = 0; seg < vl; ++seg)
+        {
+            if (isElemActive(seg_mask, seg))
             {
-                inst->getTranslationState()->makeRequest(
-                    rs1_val + elems_vs2.getElement(mask_iter.getIndex()).getVal(), sewb);
+                for (size_t idx = seg * nfields; idx < (seg + 1) * nfields; ++idx)
+                {
+                    field_mask[idx / 8] |= 1 << (idx % 8);
+                }
             }
         }
+        return field_mask.data();
+    }
+
+    // Address of field idx, seg_vaddr(seg) is the address of segment seg
+    template <size_t elemWidth, size_t nfields, typename SegVAddrFunc>
+    auto getFieldVAddrFunc(const SegVAddrFunc & seg_vaddr)
+    {
+        return [=](size_t idx)
+        { return seg_vaddr(idx / nfields) + (idx % nfields) * (elemWidth / 8); };
+    }
+
+    // Registers per field, EMUL = EEW / SEW * LMUL rounded up to a whole register. Returns 0 if
+    // all fields take more than 8 registers.
+    inline uint32_t getFieldRegs(const VectorConfig* config, const size_t field_width,
+                                 const size_t nfields)
+    {
+        // LMUL is in eighths
+        const size_t field_regs =
+            std::max<size_t>(field_width * config->getLMUL() / config->getSEW() / 8, 1);
+        return ((nfields * field_regs) <= 8) ? field_regs : 0;
+    }
+
+    // Copy the fields of the segments [vstart, vl) from the register groups to fields
+    template <size_t elemWidth, size_t nfields>
+    void interleaveFields(PegasusState* state, const uint32_t reg_id, const uint32_t field_regs,
+                          const size_t vstart, const size_t vl, uint8_t* fields)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        alignas(64) std::array<uint8_t, VREG_GROUP_MAX_BYTES> group;
+        for (size_t f = 0; f < nfields; ++f)
+        {
+            readVecRegGroup(state, reg_id + f * field_regs, group.data(), vl * eewb);
+            for (size_t seg = vstart; seg < vl; ++seg)
+            {
+                memcpy(fields + (seg * nfields + f) * eewb, group.data() + seg * eewb, eewb);
+            }
+        }
+    }
+
+    // Copy the fields of the active segments [vstart, vl) from fields to the register groups
+    template <size_t elemWidth, size_t nfields>
+    void deinterleaveFields(PegasusState* state, const uint32_t reg_id, const uint32_t field_regs,
+                            const size_t vstart, const size_t vl, const uint8_t* mask,
+                            const uint8_t* fields)
+    {
+        constexpr size_t eewb = elemWidth / 8;
+        alignas(64) std::array<uint8_t, VREG_GROUP_MAX_BYTES> group;
+        for (size_t f = 0; f < nfields; ++f)
+        {
+            const uint32_t field_reg = reg_id + f * field_regs;
+            if ((mask != nullptr) || (vstart > 0))
+            {
+                // Fields that are not loaded keep their value
+                readVecRegGroup(state, field_reg, group.data(), vl * eewb);
+            }
+            for (size_t seg = vstart; seg < vl; ++seg)
+            {
+                if (isElemActive(mask, seg * nfields))
+                {
+                    memcpy(group.data() + seg * eewb, fields + (seg * nfields + f) * eewb, eewb);
+                }
+            }
+            writeVecRegGroup(state, field_reg, group.data(), vl * eewb);
+        }
+    }
+
+    // Execute a segment access with elemWidth wide fields. access(vstart, vl, mask, fields)
+    // copies the fields [vstart, vl) between memory and fields and returns the end of the fields
+    // it copied, which is less than vl if a fault-only-first load was cut short or only a batch
+    // of a strided or indexed access was copied. Memory is accessed in one pass over the fields
+    // and the fields are transposed to or from the register groups in bulk. Returns the end
+    // segment.
+    template <size_t elemWidth, size_t nfields, bool isLoad, typename AccessFunc>
+    size_t segmentAccess(PegasusState* state, const uint32_t reg_id, const uint32_t field_regs,
+                         const AccessFunc & access)
+    {
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const VectorConfig* config = inst->getVecConfig();
+        const size_t vl = config->getVL();
+        sparta_assert((vl * nfields * elemWidth / 8) <= VREG_GROUP_MAX_BYTES);
+
+        // Later batches of strided and indexed accesses start past vstart, at a whole segment
+        const size_t vstart =
+            std::max(config->getVSTART(), inst->getTranslationState()->getBatchStart() / nfields);
+
+        MaskBits mask;
+        const uint8_t* mask_ptr = readFieldMask<nfields>(state, !inst->getVM(), vl, mask);
+        alignas(64) std::array<uint8_t, VREG_GROUP_MAX_BYTES> fields;
+        if constexpr (!isLoad)
+        {
+            interleaveFields<elemWidth, nfields>(state, reg_id, field_regs, vstart, vl,
+                                                 fields.data());
+        }
+
+        const size_t end =
+            access(vstart * nfields, vl * nfields, mask_ptr, fields.data()) / nfields;
+
+        if constexpr (isLoad)
+        {
+            deinterleaveFields<elemWidth, nfields>(state, reg_id, field_regs, vstart, end,
+                                                   mask_ptr, fields.data());
+        }
+        return end;
+    }
+
+    // Data of indexed accesses is SEW wide, indices are indexWidth wide. Segment accesses
+    // request the pages of all fields.
+    template <size_t indexWidth, size_t elemWidth, size_t nfields = 1>
+    void makeIndexedRequests(PegasusState* state, const Addr base)
+    {
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const VectorConfig* config = inst->getVecConfig();
+        const size_t vl = config->getVL();
+        using IndexType = UintType<indexWidth>;
+        alignas(64) std::array<IndexType, VREG_GROUP_MAX_BYTES / sizeof(IndexType)> indices;
+        readVecRegGroup(state, inst->getRs2(), indices.data(), vl * sizeof(IndexType));
+
+        MaskBits mask;
+        makeElemPageRequests<elemWidth, nfields>(
+            state, config->getVSTART() * nfields, vl * nfields,
+            readFieldMask<nfields>(state, !inst->getVM(), vl, mask),
+            getFieldVAddrFunc<elemWidth, nfields>([&](size_t idx) { return base + indices[idx]; }));
+    }
+
+    // Returns the end of the batch that was accessed (see copyElemPages)
+    template <size_t indexWidth, size_t elemWidth, bool isLoad>
+    size_t indexedAccess(PegasusState* state)
+    {
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const VectorConfig* config = inst->getVecConfig();
+        const size_t vl = config->getVL();
+        using IndexType = UintType<indexWidth>;
+        alignas(64) std::array<IndexType, VREG_GROUP_MAX_BYTES / sizeof(IndexType)> indices;
+        readVecRegGroup(state, inst->getRs2(), indices.data(), vl * sizeof(IndexType));
+
+        const Addr base = readAddrReg(state, inst->getRs1());
+        return elemPageAccess<elemWidth, isLoad>(state, isLoad ? inst->getRd() : inst->getRs3(),
+                                                 config->getVSTART(), vl, !inst->getVM(),
+                                                 [&](size_t idx) { return base + indices[idx]; });
+    }
+
+    // Returns the end segment of the batch that was accessed (see copyElemPages)
+    template <size_t indexWidth, size_t elemWidth, size_t nfields, bool isLoad>
+    size_t indexedSegmentAccess(PegasusState* state, const uint32_t reg_id,
+                                const uint32_t field_regs)
+    {
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const size_t vl = inst->getVecConfig()->getVL();
+        using IndexType = UintType<indexWidth>;
+        alignas(64) std::array<IndexType, VREG_GROUP_MAX_BYTES / sizeof(IndexType)> indices;
+        readVecRegGroup(state, inst->getRs2(), indices.data(), vl * sizeof(IndexType));
+
+        const Addr base = readAddrReg(state, inst->getRs1());
+        const auto field_vaddr = getFieldVAddrFunc<elemWidth, nfields>(
+            [&](size_t seg) { return base + indices[seg]; });
+        return segmentAccess<elemWidth, nfields, isLoad>(
+            state, reg_id, field_regs,
+            [&](size_t vstart, size_t num_fields, const uint8_t* mask, uint8_t* fields)
+            {
+                return copyElemPages<elemWidth, isLoad, nfields>(state, vstart, num_fields, mask,
+                                                                 field_vaddr, fields);
+            });
+    }
+
+    template <typename XLEN, size_t elemWidth, RvvLoadStoreInsts::AddressingMode addrMode,
+              bool ffirst>
+    Action::ItrType RvvLoadStoreInsts::vlseComputeAddressHandler_(pegasus::PegasusState* state,
+                                                                  Action::ItrType action_it)
+    {
+        static_assert(std::is_same<XLEN, RV64>::value || std::is_same<XLEN, RV32>::value);
+
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        VectorConfig* config = inst->getVecConfig();
+        const XLEN rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
+
+        MaskBits mask;
+        const uint8_t* mask_ptr = readMask(state, !inst->getVM(), config->getVL(), mask);
+
+        if constexpr (addrMode == AddressingMode::UNIT)
+        {
+            makeUnitStrideRequests<elemWidth, ffirst>(state, rs1_val, config->getVSTART(),
+                                                      config->getVL(), mask_ptr);
+            return ++action_it;
+        }
+
+        const Addr base = rs1_val;
+        const Addr stride = READ_INT_REG<XLEN>(state, inst->getRs2());
+        makeElemPageRequests<elemWidth>(state, config->getVSTART(), config->getVL(), mask_ptr,
+                                        [=](size_t idx) { return base + idx * stride; });
+        return ++action_it;
+    }
+
+    template <typename XLEN, size_t elemWidth, RvvLoadStoreInsts::AddressingMode addrMode>
+    Action::ItrType RvvLoadStoreInsts::vlseIdxComputeAddressHandler_(pegasus::PegasusState* state,
+                                                                     Action::ItrType action_it)
+    {
+        static_assert(std::is_same<XLEN, RV64>::value || std::is_same<XLEN, RV32>::value);
+
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const XLEN rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
+        switch (inst->getVecConfig()->getSEW())
+        {
+            case 8:
+                makeIndexedRequests<elemWidth, 8>(state, rs1_val);
+                break;
+            case 16:
+                makeIndexedRequests<elemWidth, 16>(state, rs1_val);
+                break;
+            case 32:
+                makeIndexedRequests<elemWidth, 32>(state, rs1_val);
+                break;
+            case 64:
+                makeIndexedRequests<elemWidth, 64>(state, rs1_val);
+                break;
+            default:
+                sparta_assert(false, "Unsupported SEW value");
+                break;
+        }
 
         return ++action_it;
     }
@@ -695,15 +1475,10 @@ namespace pegasus
 
         const PegasusInstPtr & inst = state->getCurrentInst();
         const VectorConfig* vector_config = inst->getVecConfig();
-        const size_t vl = vector_config->getVL();
-        const size_t eewb = elemWidth / 8;
-        const Addr stride = elemWidth / 8;
         const XLEN rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
 
-        for (size_t i = vector_config->getVSTART(); i < vl; ++i)
-        {
-            inst->getTranslationState()->makeRequest(rs1_val + i * stride, eewb);
-        }
+        makeUnitStrideRequests<elemWidth>(state, rs1_val, vector_config->getVSTART(),
+                                          vector_config->getVL(), nullptr);
 
         return ++action_it;
     }
@@ -720,83 +1495,69 @@ namespace pegasus
         const size_t vl = (vector_config->getVL() + BYTESIZE - 1) / BYTESIZE;
         const XLEN rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
 
-        for (size_t i = vector_config->getVSTART(); i < vl; ++i)
-        {
-            inst->getTranslationState()->makeRequest(rs1_val + i, 1);
-        }
+        makeUnitStrideRequests<BYTESIZE>(state, rs1_val, vector_config->getVSTART(), vl, nullptr);
 
         return ++action_it;
     }
 
     template <size_t elemWidth, bool isLoad, bool ffirst>
-    Action::ItrType RvvLoadStoreInsts::vlseHandler_(pegasus::PegasusState* state,
-                                                    Action::ItrType action_it)
+    Action::ItrType RvvLoadStoreInsts::vleHandler_(pegasus::PegasusState* state,
+                                                   Action::ItrType action_it)
     {
         const PegasusInstPtr & inst = state->getCurrentInst();
-        Elements<Element<elemWidth>, false> elems{state, inst->getVecConfig(),
-                                                  isLoad ? inst->getRd() : inst->getRs3()};
-
-        auto execute = [&]<typename Iterator>(const Iterator & begin, const Iterator & end)
-        {
-            for (auto iter = begin; iter != end; ++iter)
-            {
-                auto transtate = inst->getTranslationState();
-                if (ffirst && !transtate->getNumResults())
-                {
-                    sparta_assert(!iter.getIndex(), "fault first should take trap on element 0.");
-                    inst->getVecConfig()->setVL(iter.getIndex());
-                    return;
-                }
-                if constexpr (isLoad)
-                {
-                    UintType<elemWidth> value = state->readMemory<UintType<elemWidth>>(
-                        transtate->getResult(), MemAccessSource::INSTRUCTION);
-                    elems.getElement(iter.getIndex()).setVal(value);
-                }
-                else
-                {
-                    UintType<elemWidth> value = elems.getElement(iter.getIndex()).getVal();
-                    state->writeMemory<UintType<elemWidth>>(transtate->getResult(), value,
-                                                            MemAccessSource::INSTRUCTION);
-                }
-                transtate->popResult();
-            }
-        };
-
-        if (inst->getVM()) // unmasked
-        {
-            execute(elems.begin(), elems.end());
-        }
-        else // masked
+        VectorConfig* config = inst->getVecConfig();
+        const size_t vl = unitStrideAccess<elemWidth, isLoad, ffirst>(
+            state, isLoad ? inst->getRd() : inst->getRs3(), readAddrReg(state, inst->getRs1()),
+            config->getVSTART(), config->getVL(), !inst->getVM());
+        if constexpr (ffirst)
         {
-            const MaskElements mask_elems{state, inst->getVecConfig(), pegasus::V0};
-            execute(mask_elems.maskBitIterBegin(), mask_elems.maskBitIterEnd());
+            config->setVL(vl);
         }
 
         return ++action_it;
     }
 
-    template <bool isLoad>
+    template <size_t elemWidth, bool isLoad>
+    Action::ItrType RvvLoadStoreInsts::vlseHandler_(pegasus::PegasusState* state,
+                                                    Action::ItrType action_it)
+    {
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const VectorConfig* config = inst->getVecConfig();
+        const Addr base = readAddrReg(state, inst->getRs1());
+        const Addr stride = readAddrReg(state, inst->getRs2());
+        const size_t batch_end = elemPageAccess<elemWidth, isLoad>(
+            state, isLoad ? inst->getRd() : inst->getRs3(), config->getVSTART(), config->getVL(),
+            !inst->getVM(), [=](size_t idx) { return base + idx * stride; });
+
+        return (batch_end < config->getVL()) ? retranslate(action_it) : ++action_it;
+    }
+
+    template <size_t indexWidth, bool isLoad>
     Action::ItrType RvvLoadStoreInsts::vlseIdxHandler_(pegasus::PegasusState* state,
                                                        Action::ItrType action_it)
     {
         const PegasusInstPtr & inst = state->getCurrentInst();
         const VectorConfig* vector_config = inst->getVecConfig();
+        size_t batch_end = 0;
         switch (vector_config->getSEW())
         {
             case 8:
-                return vlseHandler_<8, isLoad>(state, action_it);
+                batch_end = indexedAccess<indexWidth, 8, isLoad>(state);
+                break;
             case 16:
-                return vlseHandler_<16, isLoad>(state, action_it);
+                batch_end = indexedAccess<indexWidth, 16, isLoad>(state);
+                break;
             case 32:
-                return vlseHandler_<32, isLoad>(state, action_it);
+                batch_end = indexedAccess<indexWidth, 32, isLoad>(state);
+                break;
             case 64:
-                return vlseHandler_<64, isLoad>(state, action_it);
+                batch_end = indexedAccess<indexWidth, 64, isLoad>(state);
+                break;
             default:
                 sparta_assert(false, "Unsupported SEW value");
                 break;
         }
-        return ++action_it;
+        return (batch_end < vector_config->getVL()) ? retranslate(action_it) : ++action_it;
     }
 
     template <size_t elemWidth, bool isLoad>
@@ -804,26 +1565,11 @@ namespace pegasus
                                                      Action::ItrType action_it)
     {
         const PegasusInstPtr & inst = state->getCurrentInst();
-        VectorConfig* config = inst->getVecConfig();
-        Elements<Element<elemWidth>, false> elems{state, config,
-                                                  isLoad ? inst->getRd() : inst->getRs3()};
-
-        for (auto iter = elems.begin(); iter != elems.end(); ++iter)
-        {
-            if constexpr (isLoad)
-            {
-                UintType<elemWidth> value = state->readMemory<UintType<elemWidth>>(
-                    inst->getTranslationState()->getResult(), MemAccessSource::INSTRUCTION);
-                elems.getElement(iter.getIndex()).setVal(value);
-            }
-            else
-            {
-                UintType<elemWidth> value = elems.getElement(iter.getIndex()).getVal();
-                state->writeMemory<UintType<elemWidth>>(inst->getTranslationState()->getResult(),
-                                                        value, MemAccessSource::INSTRUCTION);
-            }
-            inst->getTranslationState()->popResult();
-        }
+        const VectorConfig* config = inst->getVecConfig();
+        const bool MASKED = false;
+        unitStrideAccess<elemWidth, isLoad>(state, isLoad ? inst->getRd() : inst->getRs3(),
+                                            readAddrReg(state, inst->getRs1()),
+                                            config->getVSTART(), config->getVL(), MASKED);
 
         return ++action_it;
     }
@@ -837,26 +1583,157 @@ namespace pegasus
         VectorConfig* config = inst->getVecConfig();
         config->setLMUL(1 * 8);
         config->setVL((config->getVL() + BYTESIZE - 1) / BYTESIZE);
-        Elements<Element<BYTESIZE>, false> elems{state, config,
-                                                 isLoad ? inst->getRd() : inst->getRs3()};
+        const bool MASKED = false;
+        unitStrideAccess<BYTESIZE, isLoad>(state, isLoad ? inst->getRd() : inst->getRs3(),
+                                           readAddrReg(state, inst->getRs1()),
+                                           config->getVSTART(), config->getVL(), MASKED);
+
+        return ++action_it;
+    }
+
+    template <typename XLEN, size_t elemWidth, size_t nfields,
+              RvvLoadStoreInsts::AddressingMode addrMode, bool ffirst>
+    Action::ItrType RvvLoadStoreInsts::vlsegComputeAddressHandler_(pegasus::PegasusState* state,
+                                                                   Action::ItrType action_it)
+    {
+        static_assert(std::is_same<XLEN, RV64>::value || std::is_same<XLEN, RV32>::value);
 
-        for (auto iter = elems.begin(); iter != elems.end(); ++iter)
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        const VectorConfig* config = inst->getVecConfig();
+        constexpr bool INDEXED = (addrMode == AddressingMode::IDX_ORDERED)
+                                 || (addrMode == AddressingMode::IDX_UNORDERED);
+        // Fields of indexed accesses are SEW wide. The register group is vd for loads and vs3
+        // for stores, both are in bits 11:7.
+        const uint32_t field_regs =
+            getFieldRegs(config, INDEXED ? config->getSEW() : elemWidth, nfields);
+        const uint32_t reg_id = (inst->getOpcode() >> 7) & 0x1f;
+        if ((field_regs == 0) || ((reg_id + nfields * field_regs) > VecRegFile::NUM_REGS))
         {
-            if constexpr (isLoad)
+            THROW_ILLEGAL_INST;
+        }
+
+        const XLEN rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
+        if constexpr (INDEXED)
+        {
+            switch (config->getSEW())
             {
-                UintType<BYTESIZE> value = state->readMemory<UintType<BYTESIZE>>(
-                    inst->getTranslationState()->getResult(), MemAccessSource::INSTRUCTION);
-                elems.getElement(iter.getIndex()).setVal(value);
+                case 8:
+                    makeIndexedRequests<elemWidth, 8, nfields>(state, rs1_val);
+                    break;
+                case 16:
+                    makeIndexedRequests<elemWidth, 16, nfields>(state, rs1_val);
+                    break;
+                case 32:
+                    makeIndexedRequests<elemWidth, 32, nfields>(state, rs1_val);
+                    break;
+                case 64:
+                    makeIndexedRequests<elemWidth, 64, nfields>(state, rs1_val);
+                    break;
+                default:
+                    sparta_assert(false, "Unsupported SEW value");
+                    break;
             }
-            else
+            return ++action_it;
+        }
+
+        const size_t vstart = config->getVSTART();
+        const size_t vl = config->getVL();
+        MaskBits mask;
+        const uint8_t* mask_ptr = readFieldMask<nfields>(state, !inst->getVM(), vl, mask);
+        if constexpr (addrMode == AddressingMode::UNIT)
+        {
+            makeUnitStrideRequests<elemWidth, ffirst, nfields>(state, rs1_val, vstart * nfields,
+                                                               vl * nfields, mask_ptr);
+        }
+        else
+        {
+            const Addr base = rs1_val;
+            const Addr stride = READ_INT_REG<XLEN>(state, inst->getRs2());
+            makeElemPageRequests<elemWidth, nfields>(
+                state, vstart * nfields, vl * nfields, mask_ptr,
+                getFieldVAddrFunc<elemWidth, nfields>([=](size_t seg)
+                                                      { return base + seg * stride; }));
+        }
+        return ++action_it;
+    }
+
+    template <size_t elemWidth, size_t nfields, RvvLoadStoreInsts::AddressingMode addrMode,
+              bool isLoad, bool ffirst>
+    Action::ItrType RvvLoadStoreInsts::vlsegHandler_(pegasus::PegasusState* state,
+                                                     Action::ItrType action_it)
+    {
+        const PegasusInstPtr & inst = state->getCurrentInst();
+        VectorConfig* config = inst->getVecConfig();
+        constexpr bool INDEXED = (addrMode == AddressingMode::IDX_ORDERED)
+                                 || (addrMode == AddressingMode::IDX_UNORDERED);
+        const uint32_t reg_id = isLoad ? inst->getRd() : inst->getRs3();
+        const uint32_t field_regs =
+            getFieldRegs(config, INDEXED ? config->getSEW() : elemWidth, nfields);
+        if ((field_regs == 0) || ((reg_id + nfields * field_regs) > VecRegFile::NUM_REGS))
+        {
+            THROW_ILLEGAL_INST;
+        }
+
+        if constexpr (INDEXED)
+        {
+            size_t seg_end = 0;
+            switch (config->getSEW())
             {
-                UintType<BYTESIZE> value = elems.getElement(iter.getIndex()).getVal();
-                state->writeMemory<UintType<BYTESIZE>>(inst->getTranslationState()->getResult(),
-                                                       value, MemAccessSource::INSTRUCTION);
+                case 8:
+                    seg_end = indexedSegmentAccess<elemWidth, 8, nfields, isLoad>(state, reg_id,
+                                                                                  field_regs);
+                    break;
+                case 16:
+                    seg_end = indexedSegmentAccess<elemWidth, 16, nfields, isLoad>(state, reg_id,
+                                                                                   field_regs);
+                    break;
+                case 32:
+                    seg_end = indexedSegmentAccess<elemWidth, 32, nfields, isLoad>(state, reg_id,
+                                                                                   field_regs);
+                    break;
+                case 64:
+                    seg_end = indexedSegmentAccess<elemWidth, 64, nfields, isLoad>(state, reg_id,
+                                                                                   field_regs);
+                    break;
+                default:
+                    sparta_assert(false, "Unsupported SEW value");
+                    break;
             }
-            inst->getTranslationState()->popResult();
+            return (seg_end < config->getVL()) ? retranslate(action_it) : ++action_it;
         }
 
+        const Addr base = readAddrReg(state, inst->getRs1());
+        if constexpr (addrMode == AddressingMode::UNIT)
+        {
+            const size_t vl = segmentAccess<elemWidth, nfields, isLoad>(
+                state, reg_id, field_regs,
+                [&](size_t vstart, size_t num_fields, const uint8_t* mask, uint8_t* fields)
+                {
+                    return copyUnitStride<elemWidth, isLoad, ffirst>(state, base, vstart,
+                                                                     num_fields, mask, fields);
+                });
+            if constexpr (ffirst)
+            {
+                config->setVL(vl);
+            }
+        }
+        else
+        {
+            const Addr stride = readAddrReg(state, inst->getRs2());
+            const auto field_vaddr = getFieldVAddrFunc<elemWidth, nfields>(
+                [=](size_t seg) { return base + seg * stride; });
+            const size_t seg_end = segmentAccess<elemWidth, nfields, isLoad>(
+                state, reg_id, field_regs,
+                [&](size_t vstart, size_t num_fields, const uint8_t* mask, uint8_t* fields)
+                {
+                    return copyElemPages<elemWidth, isLoad, nfields>(state, vstart, num_fields,
+                                                                     mask, field_vaddr, fields);
+                });
+            if (seg_end < config->getVL())
+            {
+                return retranslate(action_it);
+            }
+        }
         return ++action_it;
     }
 } // namespace pegasus
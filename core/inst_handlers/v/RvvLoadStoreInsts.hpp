@@ -31,6 +31,14 @@ namespace pegasus
         static void getInstHandlers(std::map<std::string, Action> & inst_handlers);
 
       private:
+        // Segment loads and stores with nfields fields of elemWidth bits (index width for
+        // indexed accesses)
+        template <typename XLEN, size_t nfields, size_t elemWidth>
+        static void
+        getSegmentComputeAddressHandlers_(std::map<std::string, Action> & inst_handlers);
+        template <size_t nfields, size_t elemWidth>
+        static void getSegmentHandlers_(std::map<std::string, Action> & inst_handlers);
+
         template <typename XLEN, size_t elemWidth, AddressingMode addrMode, bool ffirst = false>
         Action::ItrType vlseComputeAddressHandler_(pegasus::PegasusState* state,
                                                    Action::ItrType action_it);
@@ -43,14 +51,23 @@ namespace pegasus
         template <typename XLEN>
         Action::ItrType vlsmComputeAddressHandler_(pegasus::PegasusState* state,
                                                    Action::ItrType action_it);
+        template <typename XLEN, size_t elemWidth, size_t nfields, AddressingMode addrMode,
+                  bool ffirst = false>
+        Action::ItrType vlsegComputeAddressHandler_(pegasus::PegasusState* state,
+                                                    Action::ItrType action_it);
 
         template <size_t elemWidth, bool isLoad, bool ffirst = false>
+        Action::ItrType vleHandler_(pegasus::PegasusState* state, Action::ItrType action_it);
+        template <size_t elemWidth, bool isLoad>
         Action::ItrType vlseHandler_(pegasus::PegasusState* state, Action::ItrType action_it);
-        template <bool isLoad>
+        template <size_t indexWidth, bool isLoad>
         Action::ItrType vlseIdxHandler_(pegasus::PegasusState* state, Action::ItrType action_it);
         template <size_t elemWidth, bool isLoad>
         Action::ItrType vlsreHandler_(pegasus::PegasusState* state, Action::ItrType action_it);
         template <bool isLoad>
         Action::ItrType vlsmHandler_(pegasus::PegasusState* state, Action::ItrType action_it);
+        template <size_t elemWidth, size_t nfields, AddressingMode addrMode, bool isLoad,
+                  bool ffirst = false>
+        Action::ItrType vlsegHandler_(pegasus::PegasusState* state, Action::ItrType action_it);
     };
 } // namespace pegasus
@@ -313,23 +313,23 @@ namespace pegasus
                                                      Action::ItrType action_it)
     {
         // FFLAGS
-        const XLEN nx_val = READ_CSR_FIELD<XLEN>(state, FCSR, "NX");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "NX", nx_val);
+        const XLEN nx_val = READ_CSR_FIELD<XLEN>(state, CSR::FCSR::NX);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FFLAGS::NX, nx_val);
 
-        const XLEN uf_val = READ_CSR_FIELD<XLEN>(state, FCSR, "UF");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "UF", uf_val);
+        const XLEN uf_val = READ_CSR_FIELD<XLEN>(state, CSR::FCSR::UF);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FFLAGS::UF, uf_val);
 
-        const XLEN of_val = READ_CSR_FIELD<XLEN>(state, FCSR, "OF");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "OF", of_val);
+        const XLEN of_val = READ_CSR_FIELD<XLEN>(state, CSR::FCSR::OF);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FFLAGS::OF, of_val);
 
-        const XLEN dz_val = READ_CSR_FIELD<XLEN>(state, FCSR, "DZ");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "DZ", dz_val);
+        const XLEN dz_val = READ_CSR_FIELD<XLEN>(state, CSR::FCSR::DZ);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FFLAGS::DZ, dz_val);
 
-        const XLEN nv_val = READ_CSR_FIELD<XLEN>(state, FCSR, "NV");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "NV", nv_val);
+        const XLEN nv_val = READ_CSR_FIELD<XLEN>(state, CSR::FCSR::NV);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FFLAGS::NV, nv_val);
 
         // FRM
-        const XLEN frm_val = READ_CSR_FIELD<XLEN>(state, FCSR, "frm");
+        const XLEN frm_val = READ_CSR_FIELD<XLEN>(state, CSR::FCSR::FRM);
         WRITE_CSR_REG<XLEN>(state, FRM, frm_val);
 
         set_softfloat_excpetionFlags<XLEN>(state);
@@ -342,20 +342,20 @@ namespace pegasus
                                                        Action::ItrType action_it)
     {
         // FCSR
-        const XLEN nx_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "NX");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "NX", nx_val);
+        const XLEN nx_val = READ_CSR_FIELD<XLEN>(state, CSR::FFLAGS::NX);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FCSR::NX, nx_val);
 
-        const XLEN uf_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "UF");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "UF", uf_val);
+        const XLEN uf_val = READ_CSR_FIELD<XLEN>(state, CSR::FFLAGS::UF);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FCSR::UF, uf_val);
 
-        const XLEN of_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "OF");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "OF", of_val);
+        const XLEN of_val = READ_CSR_FIELD<XLEN>(state, CSR::FFLAGS::OF);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FCSR::OF, of_val);
 
-        const XLEN dz_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "DZ");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "DZ", dz_val);
+        const XLEN dz_val = READ_CSR_FIELD<XLEN>(state, CSR::FFLAGS::DZ);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FCSR::DZ, dz_val);
 
-        const XLEN nv_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "NV");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "NV", nv_val);
+        const XLEN nv_val = READ_CSR_FIELD<XLEN>(state, CSR::FFLAGS::NV);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FCSR::NV, nv_val);
 
         set_softfloat_excpetionFlags<XLEN>(state);
 
@@ -367,7 +367,7 @@ namespace pegasus
     {
         // FCSR
         const XLEN frm_val = READ_CSR_REG<XLEN>(state, FRM);
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "frm", frm_val);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::FCSR::FRM, frm_val);
 
         return ++action_it;
     }
@@ -377,41 +377,41 @@ namespace pegasus
                                                         Action::ItrType action_it)
     {
         // Update shared fields only
-        const XLEN sie_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "sie");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sie", sie_val);
+        const XLEN sie_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SIE);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SIE, sie_val);
 
-        const XLEN spie_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "spie");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "spie", spie_val);
+        const XLEN spie_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SPIE);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SPIE, spie_val);
 
-        const XLEN ube_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "ube");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "ube", ube_val);
+        const XLEN ube_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::UBE);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::UBE, ube_val);
 
-        const XLEN spp_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "spp");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "spp", spp_val);
+        const XLEN spp_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SPP);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SPP, spp_val);
 
-        const XLEN vs_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "vs");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "vs", vs_val);
+        const XLEN vs_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::VS);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::VS, vs_val);
 
-        const XLEN fs_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "fs");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "fs", fs_val);
+        const XLEN fs_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::FS);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::FS, fs_val);
 
-        const XLEN xs_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "xs");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "xs", xs_val);
+        const XLEN xs_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::XS);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::XS, xs_val);
 
-        const XLEN sum_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "sum");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sum", sum_val);
+        const XLEN sum_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SUM);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SUM, sum_val);
 
-        const XLEN mxr_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "mxr");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mxr", mxr_val);
+        const XLEN mxr_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::MXR);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::MXR, mxr_val);
 
         if constexpr (std::is_same_v<XLEN, RV64>)
         {
-            const XLEN uxl_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "uxl");
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "uxl", uxl_val);
+            const XLEN uxl_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::UXL);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::UXL, uxl_val);
         }
 
-        const XLEN sd_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "sd");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sd", sd_val);
+        const XLEN sd_val = READ_CSR_FIELD<XLEN>(state, CSR::SSTATUS::SD);
+        WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SD, sd_val);
 
         return mstatusUpdateHandler_<XLEN>(state, action_it);
     }
@@ -446,14 +446,14 @@ namespace pegasus
 
         if (mstatus_val & mstatus_fast_check_mask)
         {
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sd", 0b1);
+            WRITE_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SD, 0b1);
         }
 
         auto & ext_manager = state->getCore()->getExtensionManager();
         bool change_mavis_ctx = false;
 
         // If FS is set to 0 (off), all floating point extensions are disabled
-        const uint32_t fs_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "fs");
+        const uint32_t fs_val = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::FS);
         if (fs_val == 0)
         {
             std::vector<std::string> disabled_exts;
@@ -471,14 +471,14 @@ namespace pegasus
         else
         {
             std::vector<std::string> enabled_exts;
-            if (READ_CSR_FIELD<XLEN>(state, MISA, "f") == 0x1)
+            if (READ_CSR_FIELD<XLEN>(state, CSR::MISA::F) == 0x1)
             {
                 if (!ext_manager.isEnabled("f"))
                 {
                     enabled_exts.emplace_back("f");
                 }
             }
-            if (READ_CSR_FIELD<XLEN>(state, MISA, "d") == 0x1)
+            if (READ_CSR_FIELD<XLEN>(state, CSR::MISA::D) == 0x1)
             {
                 if (!ext_manager.isEnabled("d"))
                 {
@@ -532,7 +532,7 @@ namespace pegasus
                     // misalignment exception. Check if the next PC is not 32-bit aligned.
                     if ((ext == 'c') && ((state->getNextPc() & 0x3) != 0))
                     {
-                        WRITE_CSR_FIELD<XLEN>(state, MISA, "c", 0x1);
+                        WRITE_CSR_FIELD<XLEN>(state, CSR::MISA::C, 0x1);
                     }
                     else
                     {
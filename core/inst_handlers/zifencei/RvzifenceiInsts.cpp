@@ -3,6 +3,7 @@
 #include "core/ActionGroup.hpp"
 #include "core/PegasusState.hpp"
 #include "core/PegasusInst.hpp"
+#include "core/Fetch.hpp"
 
 namespace pegasus
 {
@@ -24,8 +25,7 @@ namespace pegasus
     Action::ItrType RvzifenceiInsts::fence_iHandler_(pegasus::PegasusState* state,
                                                      Action::ItrType action_it)
     {
-        // TODO: Flush any TLBs and instruction/block caches in the future
-        (void)state;
+        state->getFetchUnit()->getDecodeCache()->flush();
 
         return ++action_it;
     }
@@ -0,0 +1,91 @@
+#include "core/observers/AsyncSTFWriter.hpp"
+
+#include <algorithm>
+
+namespace pegasus
+{
+    AsyncSTFWriter::AsyncSTFWriter(stf::STFWriter & stf_writer, uint32_t capacity) :
+        stf_writer_(stf_writer),
+        capacity_(capacity),
+        batches_(std::max<uint64_t>(capacity, 1))
+    {
+        if (capacity_ > 0)
+        {
+            writer_thread_ = std::thread(&AsyncSTFWriter::run_, this);
+        }
+    }
+
+    AsyncSTFWriter::Batch & AsyncSTFWriter::beginBatch()
+    {
+        if (capacity_ == 0)
+        {
+            return batches_.front();
+        }
+
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        while ((head - tail) == capacity_)
+        {
+            // Backpressure: sleep until the writer thread frees a batch
+            tail_.wait(tail, std::memory_order_acquire);
+            tail = tail_.load(std::memory_order_acquire);
+        }
+        return batches_[head % capacity_];
+    }
+
+    void AsyncSTFWriter::commitBatch()
+    {
+        if (capacity_ == 0)
+        {
+            writeBatch_(batches_.front());
+            return;
+        }
+
+        head_.fetch_add(1, std::memory_order_release);
+        head_.notify_one();
+    }
+
+    void AsyncSTFWriter::stop()
+    {
+        if (writer_thread_.joinable())
+        {
+            beginBatch().last_ = true;
+            commitBatch();
+            writer_thread_.join();
+        }
+    }
+
+    void AsyncSTFWriter::run_()
+    {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            head_.wait(tail, std::memory_order_acquire);
+            const uint64_t head = head_.load(std::memory_order_acquire);
+            for (; tail != head; ++tail)
+            {
+                Batch & batch = batches_[tail % capacity_];
+                const bool last = batch.last_;
+                writeBatch_(batch);
+                tail_.store(tail + 1, std::memory_order_release);
+                tail_.notify_one();
+                if (last)
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    void AsyncSTFWriter::writeBatch_(Batch & batch)
+    {
+        for (const Record & record : batch.records_)
+        {
+            std::visit([this](const auto & stf_record) { stf_writer_ << stf_record; }, record);
+        }
+
+        // Keep the capacity for the next instruction
+        batch.records_.clear();
+        batch.last_ = false;
+    }
+} // namespace pegasus
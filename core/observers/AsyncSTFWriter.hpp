@@ -0,0 +1,79 @@
+#pragma once
+
+#include "stf-inc/stf_record_types.hpp"
+#include "stf-inc/stf_writer.hpp"
+
+#include <atomic>
+#include <cinttypes>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace pegasus
+{
+    /*!
+     * \class AsyncSTFWriter
+     * \brief Moves STF compression and file I/O off the simulation thread
+     *
+     * The STF logger collects the records of each instruction in a batch. Batches are handed to
+     * a writer thread through a single producer, single consumer ring of batches allocated up
+     * front. A batch keeps its capacity when it is reused, so tracing does not allocate once the
+     * ring has warmed up (apart from vector register and event data). When the ring is full the
+     * simulation thread waits for the writer thread, which bounds the memory used.
+     */
+    class AsyncSTFWriter
+    {
+      public:
+        using Record = std::variant<stf::InstRegRecord, stf::InstMemAccessRecord,
+                                    stf::InstMemContentRecord, stf::EventRecord,
+                                    stf::EventPCTargetRecord, stf::InstPCTargetRecord,
+                                    stf::InstOpcode16Record, stf::InstOpcode32Record>;
+
+        class Batch
+        {
+          public:
+            template <typename RecordT> Batch & operator<<(RecordT && record)
+            {
+                records_.emplace_back(std::forward<RecordT>(record));
+                return *this;
+            }
+
+          private:
+            std::vector<Record> records_;
+            // Set on the batch that stops the writer thread
+            bool last_ = false;
+
+            friend class AsyncSTFWriter;
+        };
+
+        // With a capacity of 0, batches are written on the simulation thread when committed
+        AsyncSTFWriter(stf::STFWriter & stf_writer, uint32_t capacity);
+
+        ~AsyncSTFWriter() { stop(); }
+
+        // Get the next free batch, waits for the writer thread while the ring is full
+        Batch & beginBatch();
+
+        // Hand the batch from beginBatch to the writer thread
+        void commitBatch();
+
+        // Write all committed batches and stop the writer thread
+        void stop();
+
+      private:
+        void run_();
+
+        void writeBatch_(Batch & batch);
+
+        stf::STFWriter & stf_writer_;
+        const uint64_t capacity_;
+        std::vector<Batch> batches_;
+
+        // Batches committed by the simulation thread and written by the writer thread. They
+        // only ever increase, keep them on separate cache lines.
+        alignas(64) std::atomic<uint64_t> head_{0};
+        alignas(64) std::atomic<uint64_t> tail_{0};
+
+        std::thread writer_thread_;
+    };
+} // namespace pegasus
@@ -39,13 +39,13 @@ namespace pegasus::cosim
         auto & last_event = last_event_.getValue();
         for (auto & src_reg : src_regs_)
         {
-            last_event.register_reads_.emplace_back(src_reg.reg_id,
+            last_event.register_reads_.emplace_back(src_reg.reg_id.getRegId(),
                                                     src_reg.reg_value.getByteVector());
         }
 
         for (auto & dst_reg : dst_regs_)
         {
-            last_event.register_writes_.emplace_back(dst_reg.reg_id,
+            last_event.register_writes_.emplace_back(dst_reg.reg_id.getRegId(),
                                                      dst_reg.reg_value.getByteVector(),
                                                      dst_reg.reg_prev_value.getByteVector());
         }
@@ -53,7 +53,7 @@ namespace pegasus::cosim
         for (auto & [csr_num, csr_write] : csr_writes_)
         {
             (void)csr_num;
-            last_event.register_writes_.emplace_back(csr_write.reg_id,
+            last_event.register_writes_.emplace_back(csr_write.reg_id.getRegId(),
                                                      csr_write.reg_value.getByteVector(),
                                                      csr_write.reg_prev_value.getByteVector());
         }
@@ -76,7 +76,7 @@ namespace pegasus::cosim
         last_event.event_ends_sim_ = state->getSimState()->sim_stopped;
         last_event.sim_state_current_uid_ = state->getSimState()->current_uid;
 
-        if (const auto & reservation = state->getCore()->getReservation(state->getHartId());
+        if (const auto & reservation = state->getCore()->getReservation(state->getCoreHartIdx());
             reservation.isValid())
         {
             last_event.end_reservation_ = reservation;
@@ -127,7 +127,7 @@ namespace pegasus::cosim
         last_event.curr_ldst_priv_ = state->getLdstPrivMode();
         last_event.prev_excp_code_ = state->getCurrentException();
 
-        if (const auto & reservation = state->getCore()->getReservation(state->getHartId());
+        if (const auto & reservation = state->getCore()->getReservation(state->getCoreHartIdx());
             reservation.isValid())
         {
             last_event.start_reservation_ = reservation;
@@ -48,21 +48,21 @@ namespace pegasus
 
         virtual void writeImmediate(const uint64_t imm) { (void)imm; }
 
-        virtual void writeSrcRegister(const std::string &, const Observer::ObservedValue &) {}
+        virtual void writeSrcRegister(std::string_view, const Observer::ObservedValue &) {}
 
-        virtual void writeDstRegister(const std::string &, const Observer::ObservedValue &,
+        virtual void writeDstRegister(std::string_view, const Observer::ObservedValue &,
                                       const Observer::ObservedValue &)
         {
         }
 
-        virtual void writeCsrRead(const std::string &, const Observer::ObservedValue &) {}
+        virtual void writeCsrRead(std::string_view, const Observer::ObservedValue &) {}
 
-        virtual void writeCsrWrite(const std::string &, const Observer::ObservedValue &,
+        virtual void writeCsrWrite(std::string_view, const Observer::ObservedValue &,
                                    const Observer::ObservedValue &)
         {
         }
 
-        virtual void writeDstCSR(const std::string & reg_name, const uint32_t reg_num,
+        virtual void writeDstCSR(std::string_view reg_name, const uint32_t reg_num,
                                  const Observer::ObservedValue & reg_value,
                                  const Observer::ObservedValue & reg_prev_value)
         {
@@ -146,7 +146,7 @@ namespace pegasus
             postExecute_(inst_oss_.str());
         }
 
-        void writeSrcRegister(const std::string & reg_name,
+        void writeSrcRegister(std::string_view reg_name,
                               const Observer::ObservedValue & reg_value) override
         {
             reset_();
@@ -155,7 +155,7 @@ namespace pegasus
             postExecute_(inst_oss_.str());
         }
 
-        void writeDstRegister(const std::string & reg_name,
+        void writeDstRegister(std::string_view reg_name,
                               const Observer::ObservedValue & reg_value,
                               const Observer::ObservedValue & reg_prev_value) override
         {
@@ -165,7 +165,7 @@ namespace pegasus
             postExecute_(inst_oss_.str());
         }
 
-        void writeCsrRead(const std::string & reg_name,
+        void writeCsrRead(std::string_view reg_name,
                           const Observer::ObservedValue & reg_value) override
         {
             reset_();
@@ -174,7 +174,7 @@ namespace pegasus
             postExecute_(inst_oss_.str());
         }
 
-        void writeCsrWrite(const std::string & reg_name, const Observer::ObservedValue & reg_value,
+        void writeCsrWrite(std::string_view reg_name, const Observer::ObservedValue & reg_value,
                            const Observer::ObservedValue & reg_prev_value) override
         {
             reset_();
@@ -252,7 +252,7 @@ namespace pegasus
                       << HEX(state->getPrevPc(), getRegWidth()) << " (" << HEX8(opcode) << ")";
         }
 
-        void writeDstRegister(const std::string & reg_name,
+        void writeDstRegister(std::string_view reg_name,
                               const Observer::ObservedValue & reg_value,
                               const Observer::ObservedValue & reg_prev_value) override
         {
@@ -260,7 +260,7 @@ namespace pegasus
             inst_oss_ << " " << std::setw(4) << std::left << reg_name << " t" << reg_value;
         }
 
-        void writeDstCSR(const std::string & reg_name, const uint32_t reg_num,
+        void writeDstCSR(std::string_view reg_name, const uint32_t reg_num,
                          const Observer::ObservedValue & reg_value,
                          const Observer::ObservedValue & reg_prev_value) override
         {
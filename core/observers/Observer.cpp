@@ -68,7 +68,7 @@ namespace pegasus
                         sparta_assert(false, "Invalid register type!");
                 }
                 sparta_assert(reg != nullptr);
-                dst_reg.reg_value.setValue(readRegister_(reg));
+                dst_reg.reg_value.setValue(reg);
             }
         }
 
@@ -94,28 +94,27 @@ namespace pegasus
                 {
                     const auto reg = state->getSpartaRegister(&src_reg);
 
-                    SrcReg src(getRegId(reg), readRegister_(reg)); // base register value
+                    SrcReg & src = src_regs_.emplace_back(getObservedRegId(reg));
+                    src.reg_value.setValue(reg); // base register value
 
                     // recording inital src register values for LMUL other than m1 cases
                     // (m2,m4,m8,mf2...)
-                    if (getRegId(reg).reg_type == RegType::VECTOR)
+                    if (src.reg_id.reg_type == RegType::VECTOR)
                     {
                         uint32_t encoded_lmul = state->getCurrentInst()->getVecConfig()->getLMUL();
                         uint32_t reg_count =
                             std::max(1u, encoded_lmul / 8); // works well for fractional lmul cases
+                        sparta_assert(reg_count <= SrcReg::MAX_LMUL);
 
-                        uint32_t base = getRegId(reg).reg_num;
+                        uint32_t base = src.reg_id.reg_num;
 
                         for (uint32_t i = 0; i < reg_count; ++i)
                         {
                             uint32_t phys = base + i;
-
-                            src.lmul_values.push_back(makeVectorRegValue(readVectorRegister_(
-                                state, RegId{RegType::VECTOR, phys, "V" + std::to_string(phys)})));
+                            src.lmul_values[i].setValue(state->getVecRegister(phys));
                         }
+                        src.num_lmul_values = reg_count;
                     }
-
-                    src_regs_.push_back(std::move(src));
                 }
 
                 // Get value of destination registers
@@ -128,7 +127,8 @@ namespace pegasus
                     {
                         continue;
                     }
-                    dst_regs_.emplace_back(getRegId(reg), readRegister_(reg));
+                    DestReg & dst = dst_regs_.emplace_back(getObservedRegId(reg));
+                    dst.reg_prev_value.setValue(reg);
                 }
             }
         }
@@ -139,26 +139,29 @@ namespace pegasus
     {
         const auto csr_reg = data.reg;
         const auto csr_num = csr_reg->getID();
-        const RegId reg_id{(RegType)csr_reg->getGroupNum(), csr_num, csr_reg->getName()};
 
         const uint64_t final_value = (csr_reg->getNumBits() == 64) ? data.final->read<uint64_t>()
                                                                    : data.final->read<uint32_t>();
         // If this CSR has already been written to, just update the final value
-        if (csr_writes_.find(csr_num) != csr_writes_.end())
+        if (auto csr_write = findCsr_(csr_writes_, csr_num); csr_write != csr_writes_.end())
         {
-            csr_writes_.at(csr_num).reg_value.setValue(final_value);
+            csr_write->second.reg_value.setValue(final_value);
         }
         else
         {
             const uint64_t prior_value = (csr_reg->getNumBits() == 64)
                                              ? data.prior->read<uint64_t>()
                                              : data.prior->read<uint32_t>();
-            csr_writes_.insert({csr_num, DestReg(reg_id, final_value, prior_value)});
+            csr_writes_.emplace_back(csr_num,
+                                     DestReg(getObservedRegId(csr_reg), final_value, prior_value));
         }
 
         // No need to also capture a read if there is a write since the write records the previous
         // value
-        csr_reads_.erase(csr_num);
+        if (auto csr_read = findCsr_(csr_reads_, csr_num); csr_read != csr_reads_.end())
+        {
+            csr_reads_.erase(csr_read);
+        }
     }
 
     void Observer::postCsrRead_(const sparta::TreeNode &, const sparta::TreeNode &,
@@ -166,13 +169,12 @@ namespace pegasus
     {
         const auto csr_reg = data.reg;
         const auto csr_num = csr_reg->getID();
-        const RegId reg_id{(RegType)csr_reg->getGroupNum(), csr_num, csr_reg->getName()};
-        if ((csr_reads_.find(csr_num) == csr_reads_.end())
-            && (csr_writes_.find(csr_num) == csr_writes_.end()))
+        if ((findCsr_(csr_reads_, csr_num) == csr_reads_.end())
+            && (findCsr_(csr_writes_, csr_num) == csr_writes_.end()))
         {
             const uint64_t value = (csr_reg->getNumBits() == 64) ? data.value->read<uint64_t>()
                                                                  : data.value->read<uint32_t>();
-            csr_reads_.insert({csr_num, SrcReg(reg_id, value)});
+            csr_reads_.emplace_back(csr_num, SrcReg(getObservedRegId(csr_reg), value));
         }
     }
 
@@ -220,53 +222,19 @@ namespace pegasus
                                 supplement->source);
     }
 
-    std::vector<uint8_t> Observer::makeVectorRegValue(const std::vector<uint64_t> & words)
+    Observer::ObservedRegId Observer::getObservedRegId(const sparta::RegisterBase* reg)
     {
-        std::vector<uint8_t> bytes;
-        bytes.resize(words.size() * sizeof(uint64_t));
-        memcpy(bytes.data(), words.data(), bytes.size());
-        return (bytes);
+        return ObservedRegId{getRegType(reg), static_cast<uint32_t>(reg->getID()),
+                             reg->getName()};
     }
 
-    std::vector<uint64_t> Observer::readVectorRegister_(PegasusState* state, RegId reg_id) const
+    std::vector<uint64_t> Observer::readVectorRegister_(PegasusState* state,
+                                                        uint32_t reg_num) const
     {
-        const uint32_t vlen_bits = state->getVectorConfig()->getVLEN();
-
-        std::vector<uint64_t> raw;
-        switch (vlen_bits)
-        {
-            case 128:
-                {
-                    using VLEN = std::array<uint64_t, 2>;
-                    auto vec = READ_VEC_REG<VLEN>(state, reg_id.reg_num);
-                    raw.assign(vec.begin(), vec.end());
-                    break;
-                }
-            case 256:
-                {
-                    using VLEN = std::array<uint64_t, 4>;
-                    auto vec = READ_VEC_REG<VLEN>(state, reg_id.reg_num);
-                    raw.assign(vec.begin(), vec.end());
-                    break;
-                }
-            case 512:
-                {
-                    using VLEN = std::array<uint64_t, 8>;
-                    auto vec = READ_VEC_REG<VLEN>(state, reg_id.reg_num);
-                    raw.assign(vec.begin(), vec.end());
-                    break;
-                }
-            case 1024:
-                {
-                    using VLEN = std::array<uint64_t, 16>;
-                    auto vec = READ_VEC_REG<VLEN>(state, reg_id.reg_num);
-                    raw.assign(vec.begin(), vec.end());
-                    break;
-                }
-            default:
-                sparta_assert(false, "Unsupported VLEN size: " + std::to_string(vlen_bits));
-        }
-
+        const sparta::Register* reg = state->getVecRegister(reg_num);
+        std::vector<uint64_t> raw(reg->getNumBytes() / sizeof(uint64_t));
+        const uint32_t offset = 0;
+        reg->peek(raw.data(), reg->getNumBytes(), offset);
         return raw;
     }
 
@@ -282,7 +250,7 @@ namespace pegasus
 
     std::ostream & operator<<(std::ostream & os, const Observer::ObservedValue & value)
     {
-        os << "0x" << sparta::utils::bin_to_hexstr(value.getByteVector().data(), value.size(), "");
+        os << "0x" << sparta::utils::bin_to_hexstr(value.data(), value.size(), "");
         return os;
     }
 
@@ -6,6 +6,10 @@
 #include "core/Trap.hpp"
 #include "include/PegasusTypes.hpp"
 
+#include <algorithm>
+#include <array>
+#include <string_view>
+
 namespace pegasus
 {
     class PegasusState;
@@ -56,36 +60,61 @@ namespace pegasus
 
         virtual ~Observer() = default;
 
-        // Holds a register's value as a byte vector
+        // Holds a register or memory value. Values up to a full vector register are stored
+        // inline so observing an instruction does not allocate.
         class ObservedValue
         {
           public:
+            // VLEN is at most 2048 bits
+            static constexpr size_t MAX_BYTES = 256;
+
             ObservedValue() = default;
 
-            ObservedValue(const std::vector<uint8_t> & value) : value_(value) {}
+            ObservedValue(const uint8_t* value, const size_t size) { setValue(value, size); }
 
             template <typename TYPE> ObservedValue(TYPE value) { setValue<TYPE>(value); }
 
-            ObservedValue(const ObservedValue & other) : value_(other.value_) {}
+            ObservedValue(const ObservedValue & other) { setValue(other.data(), other.size()); }
+
+            ObservedValue & operator=(const ObservedValue & other)
+            {
+                setValue(other.data(), other.size());
+                return *this;
+            }
 
-            void setValue(const std::vector<uint8_t> & value) { value_ = value; }
+            void setValue(const uint8_t* value, const size_t size)
+            {
+                sparta_assert(size <= MAX_BYTES, "Observed value is too large: " << size);
+                size_ = size;
+                memcpy(value_.data(), value, size);
+            }
 
             template <typename TYPE> void setValue(TYPE value)
             {
                 static_assert(std::is_trivial_v<TYPE>);
                 static_assert(std::is_standard_layout_v<TYPE>);
                 static_assert(std::is_integral_v<TYPE>);
-                value_.resize(sizeof(TYPE));
+                size_ = sizeof(TYPE);
                 memcpy(value_.data(), &value, sizeof(TYPE));
             }
 
+            // Peek the register straight into the inline storage
+            void setValue(const sparta::RegisterBase* reg)
+            {
+                const size_t num_bytes = reg->getNumBytes();
+                sparta_assert(num_bytes <= MAX_BYTES, "Register is too large: " << reg->getName());
+                size_ = num_bytes;
+                const uint32_t offset = 0;
+                reg->peek(value_.data(), num_bytes, offset);
+            }
+
             template <typename TYPE> TYPE getValue(uint32_t offset = 0) const
             {
                 static_assert(std::is_trivial_v<TYPE>);
                 static_assert(std::is_standard_layout_v<TYPE>);
                 static_assert(std::is_integral_v<TYPE>);
                 const size_t num_bytes = sizeof(TYPE);
-                assert((offset + num_bytes) <= value_.size());
+                assert((offset + num_bytes) <= size_);
                 TYPE val = 0;
                 for (size_t i = 0; i < num_bytes; ++i)
                 {
@@ -101,12 +130,12 @@ namespace pegasus
                 static_assert(std::is_integral_v<TYPE>);
 
                 const size_t type_size = sizeof(TYPE);
-                assert(value_.size() % type_size == 0);
+                assert(size_ % type_size == 0);
 
                 std::vector<TYPE> result;
-                result.reserve(value_.size() / type_size);
+                result.reserve(size_ / type_size);
 
-                for (size_t offset = 0; offset < value_.size(); offset += type_size)
+                for (size_t offset = 0; offset < size_; offset += type_size)
                 {
                     result.push_back(getValue<TYPE>(offset));
                 }
@@ -114,28 +143,50 @@ namespace pegasus
                 return result;
             }
 
-            size_t size() const { return value_.size(); }
+            size_t size() const { return size_; }
+
+            const uint8_t* data() const { return value_.data(); }
 
-            const std::vector<uint8_t> & getByteVector() const { return value_; }
+            // Copy of the value for consumers that keep it past the instruction (cosim events)
+            std::vector<uint8_t> getByteVector() const
+            {
+                return std::vector<uint8_t>(value_.begin(), value_.begin() + size_);
+            }
 
           private:
-            std::vector<uint8_t> value_;
+            // Only the first size_ bytes are valid
+            std::array<uint8_t, MAX_BYTES> value_;
+            size_t size_ = 0;
 
             friend std::ostream & operator<<(std::ostream & os, const ObservedValue & value);
         };
 
+        // Identifies an observed register. The name is interned: it views the name of the Sparta
+        // register, which lives as long as the simulation, so no string is built per instruction.
+        struct ObservedRegId
+        {
+            RegType reg_type;
+            uint32_t reg_num;
+            std::string_view reg_name;
+
+            // Owning copy for consumers that keep it past the instruction (cosim events)
+            RegId getRegId() const { return RegId{reg_type, reg_num, std::string(reg_name)}; }
+        };
+
+        static ObservedRegId getObservedRegId(const sparta::RegisterBase* reg);
+
         struct ObservedReg
         {
-            ObservedReg(const RegId id) : reg_id(id) {}
+            ObservedReg(const ObservedRegId & id) : reg_id(id) {}
 
             template <typename TYPE>
-            ObservedReg(const RegId id, TYPE value) : reg_id(id), reg_value(value)
+            ObservedReg(const ObservedRegId & id, TYPE value) : reg_id(id), reg_value(value)
             {
             }
 
             template <typename TYPE> TYPE getRegValue() const { return reg_value.getValue<TYPE>(); }
 
-            const RegId reg_id;
+            ObservedRegId reg_id;
             ObservedValue reg_value;
         };
 
@@ -144,18 +195,17 @@ namespace pegasus
             using ObservedReg::ObservedReg;
 
             // store LMUL-wide register values // only for sources
-            std::vector<ObservedValue> lmul_values;
+            static constexpr uint32_t MAX_LMUL = 8;
+            std::array<ObservedValue, MAX_LMUL> lmul_values;
+            uint32_t num_lmul_values = 0;
         };
 
         struct DestReg : ObservedReg
         {
-            template <typename TYPE>
-            DestReg(const RegId id, TYPE prev_value) : ObservedReg(id), reg_prev_value(prev_value)
-            {
-            }
+            DestReg(const ObservedRegId & id) : ObservedReg(id) {}
 
             template <typename TYPE>
-            DestReg(const RegId id, TYPE value, TYPE prev_value) :
+            DestReg(const ObservedRegId & id, TYPE value, TYPE prev_value) :
                 ObservedReg(id, value),
                 reg_prev_value(prev_value)
             {
@@ -256,6 +306,9 @@ namespace pegasus
             }
         }
 
+        // Does this observer register callbacks for memory reads and writes?
+        bool hasMemoryCallbacks() const { return arch_.isValid(); }
+
         void registerReadWriteMemCallbacks(sparta::memory::BlockingMemoryIFNode* m)
         {
             if (arch_.isValid())
@@ -278,13 +331,16 @@ namespace pegasus
         // Mavis pointer for getting the disassembly string
         mavis::OpcodeInfo::PtrType opcode_info_;
 
-        // Instruction source and destination registers
+        // Instruction source and destination registers. The containers below are cleared
+        // before every instruction but keep their capacity, so they stop allocating once they
+        // have seen the largest instruction.
         std::vector<SrcReg> src_regs_;
         std::vector<DestReg> dst_regs_;
 
-        // Implicit CSR reads and writes
-        std::unordered_map<uint32_t, SrcReg> csr_reads_;
-        std::unordered_map<uint32_t, DestReg> csr_writes_;
+        // Implicit CSR reads and writes by CSR number. An instruction only touches a few CSRs,
+        // searching a flat vector is cheaper than hashing.
+        std::vector<std::pair<uint32_t, SrcReg>> csr_reads_;
+        std::vector<std::pair<uint32_t, DestReg>> csr_writes_;
 
         // Memory reads and writes
         std::vector<MemRead> mem_reads_;
@@ -294,7 +350,8 @@ namespace pegasus
         sparta::utils::ValidValue<FaultCause> fault_cause_;
         sparta::utils::ValidValue<InterruptCause> interrupt_cause_;
 
-        template <typename T> T readScalarRegister_(PegasusState* state, RegId reg_id) const
+        template <typename T>
+        T readScalarRegister_(PegasusState* state, const ObservedRegId & reg_id) const
         {
             switch (reg_id.reg_type)
             {
@@ -312,9 +369,7 @@ namespace pegasus
             }
         }
 
-        std::vector<uint8_t> makeVectorRegValue(const std::vector<uint64_t> & words);
-
-        std::vector<uint64_t> readVectorRegister_(PegasusState* state, RegId reg_id) const;
+        std::vector<uint64_t> readVectorRegister_(PegasusState* state, uint32_t reg_num) const;
 
         std::string formatVectorHex(const std::vector<uint64_t> & vec);
 
@@ -345,13 +400,11 @@ namespace pegasus
             mem_writes_.clear();
         }
 
-        std::vector<uint8_t> readRegister_(const sparta::Register* reg) const
+        template <typename CsrAccessesT>
+        static auto findCsr_(CsrAccessesT & csr_accesses, const uint32_t csr_num)
         {
-            const size_t num_bytes = reg->getNumBytes();
-            std::vector<uint8_t> value(num_bytes, 0);
-            const uint32_t offset = 0;
-            reg->peek(value.data(), num_bytes, offset);
-            return value;
+            return std::find_if(csr_accesses.begin(), csr_accesses.end(),
+                                [csr_num](const auto & access) { return access.first == csr_num; });
         }
 
         // Callbacks
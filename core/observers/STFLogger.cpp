@@ -8,7 +8,7 @@
 namespace pegasus
 {
     STFLogger::STFLogger(const uint32_t reg_width, uint64_t inital_pc, const std::string & filename,
-                         PegasusState* state) :
+                         PegasusState* state, uint32_t buffer_size) :
         Observer((reg_width == 32) ? ObserverMode::RV32 : ObserverMode::RV64)
     {
         try
@@ -57,19 +57,33 @@ namespace pegasus
         {
             recordRegState_<uint64_t>(state);
         }
+
+        // The header and initial state are written, the writer thread owns the STFWriter now
+        async_writer_ = std::make_unique<AsyncSTFWriter>(stf_writer_, buffer_size);
+    }
+
+    void STFLogger::close()
+    {
+        if (!closed_)
+        {
+            async_writer_->stop();
+            stf_writer_.close();
+            closed_ = true;
+        }
     }
 
     template <typename XLEN, typename F>
-    void STFLogger::writeInstRegRecord_(PegasusState* state, F get_stf_reg_type)
+    void STFLogger::writeInstRegRecord_(AsyncSTFWriter::Batch & batch, PegasusState* state,
+                                        F get_stf_reg_type)
     {
         for (const auto & src_reg : src_regs_)
         {
             const auto stf_reg_type = get_stf_reg_type(src_reg.reg_id.reg_type);
             if (src_reg.reg_id.reg_type != RegType::VECTOR)
             {
-                stf_writer_ << stf::InstRegRecord(src_reg.reg_id.reg_num, stf_reg_type,
-                                                  stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
-                                                  src_reg.reg_value.getValue<XLEN>());
+                batch << stf::InstRegRecord(src_reg.reg_id.reg_num, stf_reg_type,
+                                            stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
+                                            src_reg.reg_value.getValue<XLEN>());
             }
             else
             {
@@ -78,7 +92,7 @@ namespace pegasus
                 for (uint32_t i = 0; i < reg_count; ++i)
                 {
                     uint32_t phys = src_reg.reg_id.reg_num + i;
-                    stf_writer_ << stf::InstRegRecord(
+                    batch << stf::InstRegRecord(
                         phys, stf_reg_type, stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
                         src_reg.lmul_values[i].getValueVector<uint64_t>());
                 }
@@ -87,16 +101,16 @@ namespace pegasus
 
         for (const auto & [csr_num, csr_read] : csr_reads_)
         {
-            stf_writer_ << stf::InstRegRecord(csr_num, stf::Registers::STF_REG_TYPE::CSR,
-                                              stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
-                                              csr_read.template getRegValue<XLEN>());
+            batch << stf::InstRegRecord(csr_num, stf::Registers::STF_REG_TYPE::CSR,
+                                        stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
+                                        csr_read.template getRegValue<XLEN>());
         }
 
         for (const auto & [csr_num, csr_write] : csr_writes_)
         {
-            stf_writer_ << stf::InstRegRecord(csr_num, stf::Registers::STF_REG_TYPE::CSR,
-                                              stf::Registers::STF_REG_OPERAND_TYPE::REG_DEST,
-                                              csr_write.template getRegValue<XLEN>());
+            batch << stf::InstRegRecord(csr_num, stf::Registers::STF_REG_TYPE::CSR,
+                                        stf::Registers::STF_REG_OPERAND_TYPE::REG_DEST,
+                                        csr_write.template getRegValue<XLEN>());
         }
 
         for (const auto & dst_reg : dst_regs_)
@@ -104,9 +118,9 @@ namespace pegasus
             const auto stf_reg_type = get_stf_reg_type(dst_reg.reg_id.reg_type);
             if (dst_reg.reg_id.reg_type != RegType::VECTOR)
             {
-                stf_writer_ << stf::InstRegRecord(dst_reg.reg_id.reg_num, stf_reg_type,
-                                                  stf::Registers::STF_REG_OPERAND_TYPE::REG_DEST,
-                                                  readScalarRegister_<XLEN>(state, dst_reg.reg_id));
+                batch << stf::InstRegRecord(dst_reg.reg_id.reg_num, stf_reg_type,
+                                            stf::Registers::STF_REG_OPERAND_TYPE::REG_DEST,
+                                            readScalarRegister_<XLEN>(state, dst_reg.reg_id));
             }
             else
             {
@@ -115,10 +129,9 @@ namespace pegasus
                 for (uint32_t i = 0; i < reg_count; ++i)
                 {
                     uint32_t phys = dst_reg.reg_id.reg_num + i;
-                    stf_writer_ << stf::InstRegRecord(
+                    batch << stf::InstRegRecord(
                         phys, stf_reg_type, stf::Registers::STF_REG_OPERAND_TYPE::REG_DEST,
-                        readVectorRegister_(
-                            state, RegId{RegType::VECTOR, phys, "V" + std::to_string(phys)}));
+                        readVectorRegister_(state, phys));
                 }
             }
         }
@@ -128,45 +141,45 @@ namespace pegasus
         {
             if (state->getCurrentInst()->isVectorInstMasked())
             {
-                stf_writer_ << stf::InstRegRecord(
-                    pegasus::V0, stf::Registers::STF_REG_TYPE::VECTOR,
-                    stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
-                    readVectorRegister_(state, RegId{RegType::VECTOR, pegasus::V0, "V0"}));
+                batch << stf::InstRegRecord(pegasus::V0, stf::Registers::STF_REG_TYPE::VECTOR,
+                                            stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
+                                            readVectorRegister_(state, pegasus::V0));
             }
 
-            stf_writer_ << stf::InstRegRecord(VL, stf::Registers::STF_REG_TYPE::CSR,
-                                              stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
-                                              READ_CSR_REG<XLEN>(state, VL));
+            batch << stf::InstRegRecord(VL, stf::Registers::STF_REG_TYPE::CSR,
+                                        stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
+                                        READ_CSR_REG<XLEN>(state, VL));
 
-            stf_writer_ << stf::InstRegRecord(VTYPE, stf::Registers::STF_REG_TYPE::CSR,
-                                              stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
-                                              READ_CSR_REG<XLEN>(state, VTYPE));
+            batch << stf::InstRegRecord(VTYPE, stf::Registers::STF_REG_TYPE::CSR,
+                                        stf::Registers::STF_REG_OPERAND_TYPE::REG_SOURCE,
+                                        READ_CSR_REG<XLEN>(state, VTYPE));
         }
     }
 
     template <typename XLEN>
-    void STFLogger::writeEventRecord_(PegasusState* state, bool & invalid_opcode)
+    void STFLogger::writeEventRecord_(AsyncSTFWriter::Batch & batch, PegasusState* state,
+                                      bool & invalid_opcode)
     {
         if (fault_cause_.isValid())
         {
             switch (fault_cause_.getValue())
             {
                 case FaultCause::INST_ADDR_MISALIGNED:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::INST_ADDR_MISALIGN,
                         static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)));
                     invalid_opcode = true;
                     break;
 
                 case FaultCause::INST_ACCESS:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::INST_ADDR_FAULT,
                         static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)));
                     invalid_opcode = true;
                     break;
 
                 case FaultCause::INST_PAGE_FAULT:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::INST_PAGE_FAULT,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(state->getXlen())});
@@ -174,7 +187,7 @@ namespace pegasus
                     break;
 
                 case FaultCause::LOAD_ADDR_MISALIGNED:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::LOAD_ADDR_MISALIGN,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(state->getXlen()),
@@ -182,7 +195,7 @@ namespace pegasus
                     break;
 
                 case FaultCause::LOAD_ACCESS:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::LOAD_ACCESS_FAULT,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(state->getXlen()),
@@ -190,7 +203,7 @@ namespace pegasus
                     break;
 
                 case FaultCause::STORE_AMO_ADDR_MISALIGNED:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::STORE_ADDR_MISALIGN,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(state->getXlen()),
@@ -198,7 +211,7 @@ namespace pegasus
                     break;
 
                 case FaultCause::STORE_AMO_ACCESS:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::STORE_ACCESS_FAULT,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(state->getXlen()),
@@ -206,7 +219,7 @@ namespace pegasus
                     break;
 
                 case FaultCause::LOAD_PAGE_FAULT:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::LOAD_PAGE_FAULT,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(state->getXlen()),
@@ -214,7 +227,7 @@ namespace pegasus
                     break;
 
                 case FaultCause::STORE_AMO_PAGE_FAULT:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::STORE_PAGE_FAULT,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(state->getXlen()),
@@ -222,7 +235,7 @@ namespace pegasus
                     return; // tied to invalid opcode
 
                 case FaultCause::ILLEGAL_INST:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::ILLEGAL_INST,
                         {static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)),
                          static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MTVAL)),
@@ -231,25 +244,25 @@ namespace pegasus
                     break;
 
                 case FaultCause::BREAKPOINT:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::BREAKPOINT,
                         static_cast<XLEN>(READ_CSR_REG<XLEN>(state, MEPC)));
                     break;
 
                 case FaultCause::USER_ECALL:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::USER_ECALL,
                         static_cast<XLEN>(READ_INT_REG<XLEN>(state, 17)));
                     break;
 
                 case FaultCause::SUPERVISOR_ECALL:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::SUPERVISOR_ECALL,
                         static_cast<XLEN>(READ_INT_REG<XLEN>(state, 17)));
                     break;
 
                 case FaultCause::MACHINE_ECALL:
-                    stf_writer_ << stf::EventRecord(
+                    batch << stf::EventRecord(
                         stf::EventRecord::TYPE::MACHINE_ECALL,
                         static_cast<XLEN>(READ_INT_REG<XLEN>(state, 17)));
                     break;
@@ -258,7 +271,7 @@ namespace pegasus
                     sparta_assert(false, "STFLogger: Unknown fault cause");
             }
 
-            stf_writer_ << stf::EventPCTargetRecord(
+            batch << stf::EventPCTargetRecord(
                 static_cast<uint64_t>(READ_CSR_REG<XLEN>(state, MTVEC)));
         }
         else if (interrupt_cause_.isValid())
@@ -266,72 +279,74 @@ namespace pegasus
             switch (interrupt_cause_.getValue())
             {
                 case InterruptCause::SUPERVISOR_SOFTWARE:
-                    stf_writer_ << stf::EventRecord(stf::EventRecord::TYPE::INT_SUPERVISOR_SOFTWARE,
-                                                    {static_cast<XLEN>(0)});
+                    batch << stf::EventRecord(stf::EventRecord::TYPE::INT_SUPERVISOR_SOFTWARE,
+                                              {static_cast<XLEN>(0)});
                     break;
 
                 case InterruptCause::MACHINE_SOFTWARE:
-                    stf_writer_ << stf::EventRecord(stf::EventRecord::TYPE::INT_MACHINE_SOFTWARE,
-                                                    {static_cast<XLEN>(0)});
+                    batch << stf::EventRecord(stf::EventRecord::TYPE::INT_MACHINE_SOFTWARE,
+                                              {static_cast<XLEN>(0)});
                     break;
 
                 case InterruptCause::SUPERVISOR_TIMER:
-                    stf_writer_ << stf::EventRecord(stf::EventRecord::TYPE::INT_SUPERVISOR_TIMER,
-                                                    {static_cast<XLEN>(0)});
+                    batch << stf::EventRecord(stf::EventRecord::TYPE::INT_SUPERVISOR_TIMER,
+                                              {static_cast<XLEN>(0)});
                     break;
 
                 case InterruptCause::MACHINE_TIMER:
-                    stf_writer_ << stf::EventRecord(stf::EventRecord::TYPE::INT_MACHINE_TIMER,
-                                                    {static_cast<XLEN>(0)});
+                    batch << stf::EventRecord(stf::EventRecord::TYPE::INT_MACHINE_TIMER,
+                                              {static_cast<XLEN>(0)});
                     break;
 
                 case InterruptCause::SUPERVISOR_EXTERNAL:
-                    stf_writer_ << stf::EventRecord(stf::EventRecord::TYPE::INT_USER_EXT,
-                                                    {static_cast<XLEN>(0)});
+                    batch << stf::EventRecord(stf::EventRecord::TYPE::INT_USER_EXT,
+                                              {static_cast<XLEN>(0)});
                     break;
 
                 case InterruptCause::MACHINE_EXTERNAL:
-                    stf_writer_ << stf::EventRecord(stf::EventRecord::TYPE::INT_MACHINE_EXT,
-                                                    {static_cast<XLEN>(0)});
+                    batch << stf::EventRecord(stf::EventRecord::TYPE::INT_MACHINE_EXT,
+                                              {static_cast<XLEN>(0)});
                     break;
 
                 case InterruptCause::COUNTER_OVERFLOW:
-                    stf_writer_ << stf::EventRecord(stf::EventRecord::TYPE::INT_USER_SOFTWARE,
-                                                    {static_cast<XLEN>(0)});
+                    batch << stf::EventRecord(stf::EventRecord::TYPE::INT_USER_SOFTWARE,
+                                              {static_cast<XLEN>(0)});
                     break;
 
                 default:
                     sparta_assert(false, "STFLogger: Unknown interrupt");
             }
 
-            stf_writer_ << stf::EventPCTargetRecord(
+            batch << stf::EventPCTargetRecord(
                 static_cast<uint64_t>(READ_CSR_REG<XLEN>(state, MTVEC)));
         }
         else if (state->getCurrentInst()->isChangeOfFlowInst())
         {
-            stf_writer_ << stf::InstPCTargetRecord(state->getNextPc());
+            batch << stf::InstPCTargetRecord(state->getNextPc());
         }
     }
 
     void STFLogger::postExecute_(PegasusState* state)
     {
-        if (state->getCurrentInst() == nullptr)
+        if (closed_ || (state->getCurrentInst() == nullptr))
         {
             return;
         }
 
+        AsyncSTFWriter::Batch & batch = async_writer_->beginBatch();
+
         for (const auto & mem_write : mem_writes_)
         {
-            stf_writer_ << stf::InstMemAccessRecord(mem_write.paddr, mem_write.size, 0,
-                                                    stf::INST_MEM_ACCESS::WRITE);
-            stf_writer_ << stf::InstMemContentRecord(mem_write.mem_value.getValue<uint64_t>());
+            batch << stf::InstMemAccessRecord(mem_write.paddr, mem_write.size, 0,
+                                              stf::INST_MEM_ACCESS::WRITE);
+            batch << stf::InstMemContentRecord(mem_write.mem_value.getValue<uint64_t>());
         }
 
         for (const auto & mem_read : mem_reads_)
         {
-            stf_writer_ << stf::InstMemAccessRecord(mem_read.paddr, mem_read.size, 0,
-                                                    stf::INST_MEM_ACCESS::READ);
-            stf_writer_ << stf::InstMemContentRecord(mem_read.mem_value.getValue<uint64_t>());
+            batch << stf::InstMemAccessRecord(mem_read.paddr, mem_read.size, 0,
+                                              stf::INST_MEM_ACCESS::READ);
+            batch << stf::InstMemContentRecord(mem_read.mem_value.getValue<uint64_t>());
         }
 
         auto get_stf_reg_type = [](const RegType reg_type)
@@ -361,13 +376,13 @@ namespace pegasus
 
         if (state->getXlen() == 32)
         {
-            writeInstRegRecord_<uint32_t>(state, get_stf_reg_type);
-            writeEventRecord_<uint32_t>(state, invalid_opcode);
+            writeInstRegRecord_<uint32_t>(batch, state, get_stf_reg_type);
+            writeEventRecord_<uint32_t>(batch, state, invalid_opcode);
         }
         else
         {
-            writeInstRegRecord_<uint64_t>(state, get_stf_reg_type);
-            writeEventRecord_<uint64_t>(state, invalid_opcode);
+            writeInstRegRecord_<uint64_t>(batch, state, get_stf_reg_type);
+            writeEventRecord_<uint64_t>(batch, state, invalid_opcode);
         }
 
         uint64_t opcode = state->getCurrentInst()->getOpcode();
@@ -379,12 +394,13 @@ namespace pegasus
 
         if (state->getCurrentInst()->getOpcodeSize() == 2)
         {
-            stf_writer_ << stf::InstOpcode16Record(opcode);
+            batch << stf::InstOpcode16Record(opcode);
         }
         else
         {
-            stf_writer_ << stf::InstOpcode32Record(opcode);
+            batch << stf::InstOpcode32Record(opcode);
         }
+        async_writer_->commitBatch();
     }
 
     template <typename XLEN> void STFLogger::recordRegState_(PegasusState* state)
@@ -406,10 +422,9 @@ namespace pegasus
         // Recording vector registers
         for (uint32_t i = 0; i < state->getVecRegisterSet()->getNumRegisters(); ++i)
         {
-            stf_writer_ << stf::InstRegRecord(
-                i, stf::Registers::STF_REG_TYPE::VECTOR,
-                stf::Registers::STF_REG_OPERAND_TYPE::REG_STATE,
-                readVectorRegister_(state, RegId{RegType::VECTOR, i, "V" + std::to_string(i)}));
+            stf_writer_ << stf::InstRegRecord(i, stf::Registers::STF_REG_TYPE::VECTOR,
+                                              stf::Registers::STF_REG_OPERAND_TYPE::REG_STATE,
+                                              readVectorRegister_(state, i));
         }
         // Recording csr Registers
         auto csr_rset = state->getCsrRegisterSet();
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "core/observers/Observer.hpp"
+#include "core/observers/AsyncSTFWriter.hpp"
 #include "stf-inc/stf_record_types.hpp"
 #include "stf-inc/stf_writer.hpp"
 #include "core/PegasusInst.hpp"
 
+#include <memory>
+
 namespace pegasus
 {
     class STFLogger : public Observer
@@ -17,19 +20,30 @@ namespace pegasus
          * \param initial_pc Initial program counter
          * \param filename Name of the file the trace will be written to
          * \param state PegasusState used to populate initial register values
+         * \param buffer_size Instructions buffered for the writer thread (0 writes the trace on
+         *                    the simulation thread)
          */
         STFLogger(const uint32_t reg_width, uint64_t initial_pc, const std::string & filename,
-                  PegasusState* state);
+                  PegasusState* state, uint32_t buffer_size);
+
+        // End the trace, nothing is recorded afterwards
+        void close();
 
       private:
         stf::STFWriter stf_writer_;
+        bool closed_ = false;
+
+        // Declared after the STFWriter so the writer thread is stopped before the file closes
+        std::unique_ptr<AsyncSTFWriter> async_writer_;
         void postExecute_(PegasusState* state) override;
         template <typename XLEN> void recordRegState_(PegasusState* state);
         void writeInstruction_(const PegasusInst* inst);
 
         template <typename XLEN, typename F>
-        void writeInstRegRecord_(PegasusState* state, F get_stf_reg_type);
+        void writeInstRegRecord_(AsyncSTFWriter::Batch & batch, PegasusState* state,
+                                 F get_stf_reg_type);
         template <typename XLEN>
-        void writeEventRecord_(PegasusState* state, bool & is_invalid_opcode);
+        void writeEventRecord_(AsyncSTFWriter::Batch & batch, PegasusState* state,
+                               bool & is_invalid_opcode);
     };
 } // namespace pegasus
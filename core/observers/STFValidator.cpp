@@ -127,7 +127,7 @@ namespace pegasus
                     }
                     else
                     {
-                        std::vector<uint64_t> reg_val = readVectorRegister_(state, dst_reg.reg_id);
+                        std::vector<uint64_t> reg_val = readVectorRegister_(state, reg_num);
                         const stf::InstRegRecord::VectorType & stf_reg_val_temp =
                             stf_dst_reg.getVectorValue();
                         std::vector<uint64_t> stf_reg_val(stf_reg_val_temp.begin(),
@@ -51,7 +51,7 @@ namespace pegasus
                 sendString_("pre_execute");
                 if (ActionGroup* fail_action_group = enterLoop_(state))
                 {
-                    throw ActionException(fail_action_group);
+                    state->redirectActionGroup(fail_action_group);
                 }
             }
         }
@@ -63,7 +63,7 @@ namespace pegasus
                 sendString_("pre_exception");
                 if (ActionGroup* fail_action_group = enterLoop_(state))
                 {
-                    throw ActionException(fail_action_group);
+                    state->redirectActionGroup(fail_action_group);
                 }
             }
         }
@@ -78,7 +78,7 @@ namespace pegasus
                 sendString_("post_execute");
                 if (ActionGroup* fail_action_group = enterLoop_(state))
                 {
-                    throw ActionException(fail_action_group);
+                    state->redirectActionGroup(fail_action_group);
                 }
             }
         }
@@ -634,6 +634,10 @@ namespace pegasus
                         ss >> val;
 
                         reg->write(val);
+                        if (getRegType(reg) == RegType::VECTOR)
+                        {
+                            state->syncVecRegsFromSparta();
+                        }
                         sendAck_();
                         return true;
                     }
@@ -658,6 +662,10 @@ namespace pegasus
                         ss >> val;
 
                         reg->dmiWrite(val);
+                        if (getRegType(reg) == RegType::VECTOR)
+                        {
+                            state->syncVecRegsFromSparta();
+                        }
                         sendAck_();
                         return true;
                     }
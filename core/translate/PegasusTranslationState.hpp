@@ -137,10 +137,17 @@ namespace pegasus
             --results_cnt_;
         }
 
+        // Requesters that need more than MAX_TRANSLATION translations translate in batches and
+        // keep track of where the current batch starts here
+        size_t getBatchStart() const { return batch_start_; }
+
+        void setBatchStart(const size_t batch_start) { batch_start_ = batch_start; }
+
         void reset()
         {
             requests_cnt_ = 0;
             results_cnt_ = 0;
+            batch_start_ = 0;
         }
 
       private:
@@ -151,5 +158,7 @@ namespace pegasus
         // Translation result
         std::array<TranslationResult, MAX_TRANSLATION> results_;
         uint32_t results_cnt_ = 0;
+
+        size_t batch_start_ = 0;
     };
 } // namespace pegasus
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include "include/PegasusTypes.hpp"
+#include "include/PegasusTranslateTypes.hpp"
+
+namespace pegasus
+{
+    // Direct-mapped software TLB for a single translation stage. Entries are
+    // indexed by the 4K VPN of the virtual address. Superpage entries carry
+    // their own page offset mask so that a hit on any 4K slice of the
+    // superpage produces the correct physical address.
+    //
+    // Entries are tagged with an ASID (S-stage and VS-stage) and a VMID
+    // (VS-stage and G-stage). Stages that do not use one of the tags should
+    // always pass 0 for it.
+    class TLB
+    {
+      public:
+        static constexpr uint32_t PAGESHIFT = 12;
+
+        struct Entry
+        {
+            // Returns true if this entry maps the given address in the given address space
+            bool matches(const Addr vaddr, const uint32_t asid, const uint32_t vmid) const
+            {
+                return valid && ((vaddr & ~page_offset_mask) == vbase) && (vmid == this->vmid)
+                       && (global || (asid == this->asid));
+            }
+
+            Addr translate(const Addr vaddr) const { return pbase | (vaddr & page_offset_mask); }
+
+            // Leaf PTE value (after any A/D update) used to recheck permissions on a hit
+            uint64_t pte = 0;
+            Addr vbase = 0;
+            Addr pbase = 0;
+            Addr page_offset_mask = 0;
+            uint32_t asid = 0;
+            uint32_t vmid = 0;
+            // Page walk level the leaf PTE was found at (1 == 4K page)
+            uint32_t level = 0;
+            bool global = false;
+            bool valid = false;
+        };
+
+        explicit TLB(const uint32_t num_entries = 256) : entries_(num_entries)
+        {
+            sparta_assert((num_entries != 0) && ((num_entries & (num_entries - 1)) == 0),
+                          "TLB size must be a power of 2: " << num_entries);
+            index_mask_ = num_entries - 1;
+        }
+
+        const Entry* lookup(const Addr vaddr, const uint32_t asid, const uint32_t vmid) const
+        {
+            const Entry & entry = entries_[getIndex_(vaddr)];
+            return entry.matches(vaddr, asid, vmid) ? &entry : nullptr;
+        }
+
+        void insert(const Addr vaddr, const Addr paddr, const Addr page_offset_mask,
+                    const uint64_t pte, const uint32_t level, const uint32_t asid,
+                    const uint32_t vmid)
+        {
+            Entry & entry = entries_[getIndex_(vaddr)];
+            entry.pte = pte;
+            entry.vbase = vaddr & ~page_offset_mask;
+            entry.pbase = paddr & ~page_offset_mask;
+            entry.page_offset_mask = page_offset_mask;
+            entry.asid = asid;
+            entry.vmid = vmid;
+            entry.level = level;
+            entry.global = pte & translate_types::Sv32::PteFields::global.bitmask;
+            entry.valid = true;
+        }
+
+        // Invalidate every entry
+        void flushAll()
+        {
+            for (auto & entry : entries_)
+            {
+                entry.valid = false;
+            }
+        }
+
+        // Invalidate entries following SFENCE.VMA/HFENCE semantics. An unset vaddr matches
+        // every page, an unset ASID matches every address space (including global mappings)
+        // and an unset VMID matches every virtual machine. When an ASID is provided, global
+        // mappings are retained.
+        void flush(const std::optional<Addr> & vaddr, const std::optional<uint32_t> & asid,
+                   const std::optional<uint32_t> & vmid)
+        {
+            for (auto & entry : entries_)
+            {
+                if (!entry.valid)
+                {
+                    continue;
+                }
+                if (vaddr.has_value() && ((vaddr.value() & ~entry.page_offset_mask) != entry.vbase))
+                {
+                    continue;
+                }
+                if (asid.has_value() && (entry.global || (asid.value() != entry.asid)))
+                {
+                    continue;
+                }
+                if (vmid.has_value() && (vmid.value() != entry.vmid))
+                {
+                    continue;
+                }
+                entry.valid = false;
+            }
+        }
+
+        uint32_t getNumEntries() const { return entries_.size(); }
+
+      private:
+        std::vector<Entry> entries_;
+        Addr index_mask_ = 0;
+
+        uint32_t getIndex_(const Addr vaddr) const { return (vaddr >> PAGESHIFT) & index_mask_; }
+    };
+} // namespace pegasus
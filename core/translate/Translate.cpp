@@ -11,9 +11,23 @@
 namespace pegasus
 {
 
-    Translate::Translate(sparta::TreeNode* translate_node, const TranslateParameters*) :
-        sparta::Unit(translate_node)
+    Translate::Translate(sparta::TreeNode* translate_node, const TranslateParameters* p) :
+        sparta::Unit(translate_node),
+        tlb_enabled_(p->enable_tlb),
+        itlb_hits_(getStatisticSet(), "itlb_hits", "Number of instruction TLB hits",
+                   sparta::Counter::COUNT_NORMAL),
+        itlb_misses_(getStatisticSet(), "itlb_misses", "Number of instruction TLB misses",
+                     sparta::Counter::COUNT_NORMAL),
+        dtlb_hits_(getStatisticSet(), "dtlb_hits", "Number of data TLB hits",
+                   sparta::Counter::COUNT_NORMAL),
+        dtlb_misses_(getStatisticSet(), "dtlb_misses", "Number of data TLB misses",
+                     sparta::Counter::COUNT_NORMAL)
     {
+        itlbs_.fill(TLB(p->tlb_num_entries));
+        dtlbs_.fill(TLB(p->tlb_num_entries));
+        mmu_modes_.fill(translate_types::TranslationMode::INVALID);
+        ls_mmu_modes_.fill(translate_types::TranslationMode::INVALID);
+
         registerTranslateActions_<translate_types::TranslationStage::SUPERVISOR>(
             rv32_s_stage_translation_actions_, rv64_s_stage_translation_actions_,
             ActionTags::INST_S_STAGE_TRANSLATE_TAG, ActionTags::DATA_S_STAGE_TRANSLATE_TAG);
@@ -57,12 +71,23 @@ namespace pegasus
     }
 
     template <typename XLEN, translate_types::TranslationStage STAGE>
-    void Translate::updateTranslationMode(const translate_types::TranslationMode mode,
+    bool Translate::updateTranslationMode(const translate_types::TranslationMode mode,
                                           const translate_types::TranslationMode ls_mode)
     {
         sparta_assert(mode != translate_types::TranslationMode::INVALID);
         sparta_assert(ls_mode != translate_types::TranslationMode::INVALID);
 
+        const uint32_t stage_idx = static_cast<uint32_t>(STAGE);
+        const uint32_t xlen = std::is_same_v<XLEN, RV64> ? 64 : 32;
+        if ((mmu_modes_[stage_idx] == mode) && (ls_mmu_modes_[stage_idx] == ls_mode)
+            && (mmu_xlens_[stage_idx] == xlen))
+        {
+            return false;
+        }
+        mmu_modes_[stage_idx] = mode;
+        ls_mmu_modes_[stage_idx] = ls_mode;
+        mmu_xlens_[stage_idx] = xlen;
+
         if constexpr (STAGE == translate_types::TranslationStage::SUPERVISOR)
         {
             execute_translate_action_group_.replaceAction(
@@ -103,23 +128,128 @@ namespace pegasus
         {
             sparta_assert(false, "Translation stage cannot be INVALID!");
         }
+        return true;
+    }
+
+    void Translate::updateAtp(const translate_types::TranslationStage stage,
+                              const translate_types::TranslationMode mode, const uint32_t id,
+                              const uint64_t root_ppn)
+    {
+        AtpState & atp_state = atp_states_.at(static_cast<uint32_t>(stage));
+        const bool flush = (atp_state.mode != mode)
+                           || ((atp_state.root_ppn != root_ppn) && (atp_state.id == id));
+        atp_state.mode = mode;
+        atp_state.id = id;
+        atp_state.root_ppn = root_ppn;
+
+        if (flush)
+        {
+            DLOG("Flushing " << stage << " TLBs");
+            const uint32_t stage_idx = static_cast<uint32_t>(stage);
+            if (stage == translate_types::TranslationStage::SUPERVISOR)
+            {
+                itlbs_[stage_idx].flushAll();
+                dtlbs_[stage_idx].flushAll();
+            }
+            else if (stage == translate_types::TranslationStage::VIRTUAL_SUPERVISOR)
+            {
+                const uint32_t vmid =
+                    getTlbVmid_<translate_types::TranslationStage::VIRTUAL_SUPERVISOR>();
+                itlbs_[stage_idx].flush(std::nullopt, std::nullopt, vmid);
+                dtlbs_[stage_idx].flush(std::nullopt, std::nullopt, vmid);
+            }
+            else
+            {
+                itlbs_[stage_idx].flush(std::nullopt, std::nullopt, id);
+                dtlbs_[stage_idx].flush(std::nullopt, std::nullopt, id);
+            }
+        }
     }
 
-    template void
+    void Translate::fenceVma(const translate_types::TranslationStage stage,
+                             const std::optional<Addr> & vaddr,
+                             const std::optional<uint32_t> & asid)
+    {
+        sparta_assert(stage != translate_types::TranslationStage::GUEST,
+                      "Use fenceGvma to flush G-stage translations");
+        const uint32_t stage_idx = static_cast<uint32_t>(stage);
+        std::optional<uint32_t> vmid;
+        if (stage == translate_types::TranslationStage::VIRTUAL_SUPERVISOR)
+        {
+            vmid = getTlbVmid_<translate_types::TranslationStage::VIRTUAL_SUPERVISOR>();
+        }
+        itlbs_.at(stage_idx).flush(vaddr, asid, vmid);
+        dtlbs_.at(stage_idx).flush(vaddr, asid, vmid);
+    }
+
+    void Translate::fenceGvma(const std::optional<Addr> & gpaddr,
+                              const std::optional<uint32_t> & vmid)
+    {
+        // VS-stage entries hold guest physical addresses so they are unaffected
+        const uint32_t stage_idx = static_cast<uint32_t>(translate_types::TranslationStage::GUEST);
+        itlbs_[stage_idx].flush(gpaddr, std::nullopt, vmid);
+        dtlbs_[stage_idx].flush(gpaddr, std::nullopt, vmid);
+    }
+
+    void Translate::flushTLBs()
+    {
+        for (auto & tlb : itlbs_)
+        {
+            tlb.flushAll();
+        }
+        for (auto & tlb : dtlbs_)
+        {
+            tlb.flushAll();
+        }
+    }
+
+    template <typename XLEN, translate_types::AccessType TYPE>
+    bool Translate::isTlbHitPermitted_(PegasusState* state, const TLB::Entry & entry,
+                                       const PrivMode priv_mode) const
+    {
+        // The PTE bits that matter here are at the same position for every mode. Any
+        // failure is resolved by walking the page table again so faults and A/D
+        // updates are handled in one place.
+        namespace PteFields = translate_types::Sv32::PteFields;
+        const uint64_t pte = entry.pte;
+
+        if (((pte & PteFields::user.bitmask) == 0) && (priv_mode != PrivMode::SUPERVISOR)
+            && (READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SUM) == 0))
+        {
+            return false;
+        }
+
+        uint64_t required_bits = PteFields::accessed.bitmask;
+        if constexpr (TYPE == translate_types::AccessType::EXECUTE)
+        {
+            required_bits |= PteFields::execute.bitmask;
+        }
+        else if constexpr (TYPE == translate_types::AccessType::LOAD)
+        {
+            required_bits |= PteFields::read.bitmask;
+        }
+        else
+        {
+            required_bits |= PteFields::write.bitmask | PteFields::dirty.bitmask;
+        }
+        return (pte & required_bits) == required_bits;
+    }
+
+    template bool
     Translate::updateTranslationMode<RV32, translate_types::TranslationStage::SUPERVISOR>(
         const translate_types::TranslationMode, const translate_types::TranslationMode);
-    template void
+    template bool
     Translate::updateTranslationMode<RV64, translate_types::TranslationStage::SUPERVISOR>(
         const translate_types::TranslationMode, const translate_types::TranslationMode);
-    template void
+    template bool
     Translate::updateTranslationMode<RV32, translate_types::TranslationStage::VIRTUAL_SUPERVISOR>(
         const translate_types::TranslationMode, const translate_types::TranslationMode);
-    template void
+    template bool
     Translate::updateTranslationMode<RV64, translate_types::TranslationStage::VIRTUAL_SUPERVISOR>(
         const translate_types::TranslationMode, const translate_types::TranslationMode);
-    template void Translate::updateTranslationMode<RV32, translate_types::TranslationStage::GUEST>(
+    template bool Translate::updateTranslationMode<RV32, translate_types::TranslationStage::GUEST>(
         const translate_types::TranslationMode, const translate_types::TranslationMode);
-    template void Translate::updateTranslationMode<RV64, translate_types::TranslationStage::GUEST>(
+    template bool Translate::updateTranslationMode<RV64, translate_types::TranslationStage::GUEST>(
         const translate_types::TranslationMode, const translate_types::TranslationMode);
 
     template <typename XLEN, translate_types::TranslationStage STAGE,
@@ -166,10 +296,40 @@ namespace pegasus
             return setResult_<XLEN, STAGE, MODE, TYPE>(translation_state, action_it, vaddr);
         }
 
+        if (SPARTA_EXPECT_TRUE(tlb_enabled_))
+        {
+            const TLB::Entry* entry =
+                getTLB_<STAGE, TYPE>().lookup(vaddr, getTlbAsid_<STAGE>(), getTlbVmid_<STAGE>());
+            if (entry && isTlbHitPermitted_<XLEN, TYPE>(state, *entry, priv_mode))
+            {
+                if constexpr (TYPE == translate_types::AccessType::EXECUTE)
+                {
+                    ++itlb_hits_;
+                }
+                else
+                {
+                    ++dtlb_hits_;
+                }
+                DLOG("TLB hit, PTE: " << HEX(entry->pte, width));
+                return setResult_<XLEN, STAGE, MODE, TYPE>(translation_state, action_it,
+                                                           entry->translate(vaddr), entry->level);
+            }
+
+            if constexpr (TYPE == translate_types::AccessType::EXECUTE)
+            {
+                ++itlb_misses_;
+            }
+            else
+            {
+                ++dtlb_misses_;
+            }
+        }
+
         // Smallest page size is 4K for both RV32 and RV64
         constexpr uint64_t PAGESHIFT = 12; // 4096
         const uint32_t ATP_CSR = getAtpCsr(STAGE);
-        uint64_t ppn = READ_CSR_FIELD<XLEN>(state, ATP_CSR, "ppn") << PAGESHIFT;
+        // The PPN field is in the same place in satp, vsatp and hgatp
+        uint64_t ppn = READ_CSR_FIELD<XLEN>(state, ATP_CSR, CSR::SATP::PPN) << PAGESHIFT;
         while (level > 0)
         {
             // Read PTE from memory
@@ -224,7 +384,7 @@ namespace pegasus
 
                 // If the SUM bit is set, Supervisor mode software is allowed to access User mode
                 // pages
-                const uint32_t sum_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "sum");
+                const uint32_t sum_val = READ_CSR_FIELD<XLEN>(state, CSR::MSTATUS::SUM);
                 if ((sum_val == 0) && (false == pte.isUserMode())
                     && (priv_mode != PrivMode::SUPERVISOR))
                 {
@@ -257,7 +417,7 @@ namespace pegasus
                 if (false == pte.isAccessable(is_store))
                 {
                     // See if we're required to update access bits in the PTE
-                    if (READ_CSR_FIELD<XLEN>(state, MENVCFG, "adue"))
+                    if (READ_CSR_FIELD<XLEN>(state, CSR::MENVCFG::ADUE))
                     {
                         if constexpr (is_store)
                         {
@@ -285,6 +445,13 @@ namespace pegasus
                     translate_types::getPageOffsetMask<MODE>(indexed_level);
                 paddr |= page_offset_mask & vaddr;
 
+                if (SPARTA_EXPECT_TRUE(tlb_enabled_))
+                {
+                    getTLB_<STAGE, TYPE>().insert(vaddr, paddr, page_offset_mask, pte.getPte(),
+                                                  level, getTlbAsid_<STAGE>(),
+                                                  getTlbVmid_<STAGE>());
+                }
+
                 // Set result and determine whether to keep going or perform translation again
                 return setResult_<XLEN, STAGE, MODE, TYPE>(translation_state, action_it, paddr,
                                                            level);
@@ -306,7 +473,7 @@ namespace pegasus
             translation_state->clearRequest();
             return ++action_it;
         }
-        // We throw at this point.
+        // Raise the page fault
         switch (TYPE)
         {
             case translate_types::AccessType::EXECUTE:
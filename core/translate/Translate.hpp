@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/ActionGroup.hpp"
+#include "core/translate/TLB.hpp"
 #include "include/PegasusTypes.hpp"
 
 #include "include/PegasusTranslateTypes.hpp"
@@ -10,6 +11,9 @@
 #include "sparta/simulation/ParameterSet.hpp"
 #include "sparta/simulation/TreeNode.hpp"
 #include "sparta/simulation/Unit.hpp"
+#include "sparta/statistics/Counter.hpp"
+
+#include <optional>
 
 class PegasusTranslateTester;
 
@@ -29,6 +33,10 @@ namespace pegasus
         {
           public:
             TranslateParameters(sparta::TreeNode* node) : sparta::ParameterSet(node) {}
+
+            PARAMETER(bool, enable_tlb, true, "Cache page table walk results in a software TLB")
+            PARAMETER(uint32_t, tlb_num_entries, 256,
+                      "Number of entries in each instruction and data TLB (must be a power of 2)")
         };
 
         Translate(sparta::TreeNode* translate_node, const TranslateParameters* p);
@@ -60,8 +68,9 @@ namespace pegasus
             return &store_translate_action_group_;
         }
 
+        // Returns true if the translate Actions for the stage were replaced
         template <typename XLEN, translate_types::TranslationStage STAGE>
-        void updateTranslationMode(const translate_types::TranslationMode mode,
+        bool updateTranslationMode(const translate_types::TranslationMode mode,
                                    const translate_types::TranslationMode ls_mode);
 
         inline static int32_t getAtpCsr(const translate_types::TranslationStage stage)
@@ -71,10 +80,92 @@ namespace pegasus
             return atp_csrs.at(static_cast<uint32_t>(stage));
         }
 
+        // Called whenever the translation mode of a stage is (re)evaluated. The id is the ASID
+        // for the S-stage and VS-stage or the VMID for the G-stage. Cached translations for the
+        // stage are dropped if the mode changes or if the root page table changes without a
+        // change of address space id.
+        void updateAtp(const translate_types::TranslationStage stage,
+                       const translate_types::TranslationMode mode, const uint32_t id,
+                       const uint64_t root_ppn);
+
+        // SFENCE.VMA (S-stage) and HFENCE.VVMA (VS-stage of the current VMID)
+        void fenceVma(const translate_types::TranslationStage stage,
+                      const std::optional<Addr> & vaddr, const std::optional<uint32_t> & asid);
+
+        // HFENCE.GVMA, the guest physical address has already been shifted back into place
+        void fenceGvma(const std::optional<Addr> & gpaddr, const std::optional<uint32_t> & vmid);
+
+        // Invalidate every cached translation
+        void flushTLBs();
+
       private:
+        // Software TLBs, one per translation stage
+        const bool tlb_enabled_;
+        std::array<TLB, translate_types::N_TRANS_STAGES> itlbs_;
+        std::array<TLB, translate_types::N_TRANS_STAGES> dtlbs_;
+
+        struct AtpState
+        {
+            translate_types::TranslationMode mode = translate_types::TranslationMode::INVALID;
+            uint32_t id = 0;
+            uint64_t root_ppn = 0;
+        };
+
+        std::array<AtpState, translate_types::N_TRANS_STAGES> atp_states_;
+
+        sparta::Counter itlb_hits_;
+        sparta::Counter itlb_misses_;
+        sparta::Counter dtlb_hits_;
+        sparta::Counter dtlb_misses_;
+
+        template <translate_types::TranslationStage STAGE, translate_types::AccessType TYPE>
+        TLB & getTLB_()
+        {
+            if constexpr (TYPE == translate_types::AccessType::EXECUTE)
+            {
+                return itlbs_[static_cast<uint32_t>(STAGE)];
+            }
+            else
+            {
+                return dtlbs_[static_cast<uint32_t>(STAGE)];
+            }
+        }
+
+        // S-stage and VS-stage entries are tagged with the ASID of their atp CSR
+        template <translate_types::TranslationStage STAGE> uint32_t getTlbAsid_() const
+        {
+            if constexpr (STAGE == translate_types::TranslationStage::GUEST)
+            {
+                return 0;
+            }
+            else
+            {
+                return atp_states_[static_cast<uint32_t>(STAGE)].id;
+            }
+        }
+
+        // VS-stage and G-stage entries are tagged with the VMID from hgatp
+        template <translate_types::TranslationStage STAGE> uint32_t getTlbVmid_() const
+        {
+            if constexpr (STAGE == translate_types::TranslationStage::SUPERVISOR)
+            {
+                return 0;
+            }
+            else
+            {
+                return atp_states_[static_cast<uint32_t>(translate_types::TranslationStage::GUEST)]
+                    .id;
+            }
+        }
+
+        template <typename XLEN, translate_types::AccessType TYPE>
+        bool isTlbHitPermitted_(PegasusState* state, const TLB::Entry & entry,
+                                const PrivMode priv_mode) const;
+
         // Translation Modes for each stage (S-Stage, HS-Stage and G-Stage)
         std::array<translate_types::TranslationMode, translate_types::N_TRANS_STAGES> mmu_modes_;
         std::array<translate_types::TranslationMode, translate_types::N_TRANS_STAGES> ls_mmu_modes_;
+        std::array<uint32_t, translate_types::N_TRANS_STAGES> mmu_xlens_{};
 
         // Translate ActionGroups
         ActionGroup execute_translate_action_group_{"Execute (Inst) Translate"};
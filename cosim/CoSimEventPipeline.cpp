@@ -490,14 +490,7 @@ namespace pegasus::cosim
             state->setPrivMode(evt.getPrivilegeMode(), state->getVirtualMode());
             state->setCurrentException(evt.getPrevExceptionCode());
 
-            if (evt.getStartReservation().isValid())
-            {
-                state->getCore()->getReservation(hart_id_) = evt.getStartReservation();
-            }
-            else
-            {
-                state->getCore()->getReservation(hart_id_).clearValid();
-            }
+            state->getCore()->setReservation(hart_id_, evt.getStartReservation());
 
             softfloat_roundingMode = evt.start_softfloat_flags_.softfloat_roundingMode;
             softfloat_detectTininess = evt.start_softfloat_flags_.softfloat_detectTininess;
@@ -586,6 +579,7 @@ namespace pegasus::cosim
             auto euid = reload_evt.getEuid();
             auto checkpointer = observer->getCheckpointer();
             checkpointer->getFastCheckpointer().loadCheckpoint(euid);
+            state->syncVecRegsFromSparta();
 
             last_event_uid_ = euid;
             sim_stopped_ = reload_evt.isLastEvent();
@@ -593,14 +587,7 @@ namespace pegasus::cosim
             state->setPc(reload_evt.getNextPc());
             state->setPrivMode(reload_evt.getNextPrivilegeMode(), state->getVirtualMode());
 
-            if (reload_evt.getEndReservation().isValid())
-            {
-                state->getCore()->getReservation(hart_id_) = reload_evt.getEndReservation();
-            }
-            else
-            {
-                state->getCore()->getReservation(hart_id_).clearValid();
-            }
+            state->getCore()->setReservation(hart_id_, reload_evt.getEndReservation());
 
             softfloat_roundingMode = reload_evt.end_softfloat_flags_.softfloat_roundingMode;
             softfloat_detectTininess = reload_evt.end_softfloat_flags_.softfloat_detectTininess;
@@ -307,7 +307,7 @@ namespace pegasus::cosim
     {
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         sparta::Register* reg = state->findRegister(reg_id);
-        readRegister_(reg, buffer);
+        readRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::peekRegister(CoreId core_id, HartId hart_id, RegId reg_id,
@@ -315,7 +315,7 @@ namespace pegasus::cosim
     {
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         sparta::Register* reg = state->findRegister(reg_id);
-        peekRegister_(reg, buffer);
+        peekRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::writeRegister(CoreId core_id, HartId hart_id, RegId reg_id,
@@ -323,7 +323,7 @@ namespace pegasus::cosim
     {
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         sparta::Register* reg = state->findRegister(reg_id);
-        writeRegister_(reg, buffer);
+        writeRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::pokeRegister(CoreId core_id, HartId hart_id, RegId reg_id,
@@ -331,7 +331,7 @@ namespace pegasus::cosim
     {
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         sparta::Register* reg = state->findRegister(reg_id);
-        pokeRegister_(reg, buffer);
+        pokeRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::readRegister(CoreId core_id, HartId hart_id, const std::string reg_name,
@@ -340,7 +340,7 @@ namespace pegasus::cosim
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         constexpr bool MUST_EXIST = true;
         sparta::Register* reg = state->findRegister(reg_name, MUST_EXIST);
-        readRegister_(reg, buffer);
+        readRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::peekRegister(CoreId core_id, HartId hart_id, const std::string reg_name,
@@ -349,7 +349,7 @@ namespace pegasus::cosim
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         constexpr bool MUST_EXIST = true;
         sparta::Register* reg = state->findRegister(reg_name, MUST_EXIST);
-        peekRegister_(reg, buffer);
+        peekRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::writeRegister(CoreId core_id, HartId hart_id, const std::string reg_name,
@@ -358,7 +358,7 @@ namespace pegasus::cosim
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         constexpr bool MUST_EXIST = true;
         sparta::Register* reg = state->findRegister(reg_name, MUST_EXIST);
-        writeRegister_(reg, buffer);
+        writeRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::pokeRegister(CoreId core_id, HartId hart_id, const std::string reg_name,
@@ -367,7 +367,7 @@ namespace pegasus::cosim
         auto state = pegasus_sim_->getPegasusCore(core_id)->getPegasusState(hart_id);
         constexpr bool MUST_EXIST = true;
         sparta::Register* reg = state->findRegister(reg_name, MUST_EXIST);
-        pokeRegister_(reg, buffer);
+        pokeRegister_(state, reg, buffer);
     }
 
     void PegasusCoSim::readRegisterField(CoreId core_id, HartId hart_id, const std::string reg_name,
@@ -499,34 +499,48 @@ namespace pegasus::cosim
         sparta_assert(false, "CoSim method is not implemented!");
     }
 
-    void PegasusCoSim::readRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const
+    void PegasusCoSim::readRegister_(PegasusState* state, sparta::Register* reg,
+                                     std::vector<uint8_t> & buffer) const
     {
         const size_t size = reg->getNumBytes();
         buffer.resize(size);
         const size_t OFFSET = 0;
+        state->syncVecRegsToSparta();
         reg->read(buffer.data(), size, OFFSET);
     }
 
-    void PegasusCoSim::peekRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const
+    void PegasusCoSim::peekRegister_(PegasusState* state, sparta::Register* reg,
+                                     std::vector<uint8_t> & buffer) const
     {
         const size_t size = reg->getNumBytes();
         buffer.resize(size);
         const size_t OFFSET = 0;
+        state->syncVecRegsToSparta();
         reg->peek(buffer.data(), size, OFFSET);
     }
 
-    void PegasusCoSim::writeRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const
+    void PegasusCoSim::writeRegister_(PegasusState* state, sparta::Register* reg,
+                                      std::vector<uint8_t> & buffer) const
     {
         const size_t size = buffer.size();
         const size_t OFFSET = 0;
         reg->write(buffer.data(), size, OFFSET);
+        if (getRegType(reg) == RegType::VECTOR)
+        {
+            state->syncVecRegsFromSparta();
+        }
     }
 
-    void PegasusCoSim::pokeRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const
+    void PegasusCoSim::pokeRegister_(PegasusState* state, sparta::Register* reg,
+                                     std::vector<uint8_t> & buffer) const
     {
         const size_t size = buffer.size();
         const size_t OFFSET = 0;
         reg->poke(buffer.data(), size, OFFSET);
+        if (getRegType(reg) == RegType::VECTOR)
+        {
+            state->syncVecRegsFromSparta();
+        }
     }
 
     std::vector<std::string> PegasusCoSim::getWorkloadArgs_(const std::string & workload)
@@ -10,6 +10,7 @@
 namespace pegasus
 {
     class PegasusSim;
+    class PegasusState;
     class Fetch;
 } // namespace pegasus
 
@@ -152,10 +153,14 @@ namespace pegasus::cosim
         const pegasus::PegasusSim & getPegasusSim() const { return *pegasus_sim_.get(); }
 
       private:
-        void readRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const;
-        void peekRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const;
-        void writeRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const;
-        void pokeRegister_(sparta::Register* reg, std::vector<uint8_t> & buffer) const;
+        void readRegister_(PegasusState* state, sparta::Register* reg,
+                           std::vector<uint8_t> & buffer) const;
+        void peekRegister_(PegasusState* state, sparta::Register* reg,
+                           std::vector<uint8_t> & buffer) const;
+        void writeRegister_(PegasusState* state, sparta::Register* reg,
+                            std::vector<uint8_t> & buffer) const;
+        void pokeRegister_(PegasusState* state, sparta::Register* reg,
+                           std::vector<uint8_t> & buffer) const;
 
         static std::vector<std::string> getWorkloadArgs_(const std::string & workload);
 
@@ -19,6 +19,9 @@ namespace pegasus
         static const ActionTagType DATA_VS_STAGE_TRANSLATE_TAG;
         static const ActionTagType DATA_G_STAGE_TRANSLATE_TAG;
         static const ActionTagType EXCEPTION_TAG;
+        static const ActionTagType INCREMENT_PC_TAG;
+        static const ActionTagType OBSERVER_TAG;
+        static const ActionTagType PROFILE_TAG;
 
         // Stop Simulation
         static const ActionTagType STOP_SIM_TAG;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <cinttypes>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pegasus::snapshot
+{
+    // Snapshots are raw host-endian dumps meant to be restored by the same Pegasus build with the
+    // same configuration, the version is bumped whenever the layout changes
+    static constexpr char MAGIC[8] = {'P', 'E', 'G', 'S', 'N', 'A', 'P', '\0'};
+    static constexpr uint32_t VERSION = 3;
+
+    template <typename T> inline void write(std::ostream & os, const T & value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T> inline T read(std::istream & is)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        is.read(reinterpret_cast<char*>(&value), sizeof(T));
+        sparta_assert(is.good(), "Snapshot is truncated");
+        return value;
+    }
+
+    inline void writeBytes(std::ostream & os, const std::vector<uint8_t> & bytes)
+    {
+        write<uint64_t>(os, bytes.size());
+        os.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    inline std::vector<uint8_t> readBytes(std::istream & is)
+    {
+        std::vector<uint8_t> bytes(read<uint64_t>(is));
+        is.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+        sparta_assert(is.good(), "Snapshot is truncated");
+        return bytes;
+    }
+
+    inline void writeString(std::ostream & os, const std::string & str)
+    {
+        writeBytes(os, std::vector<uint8_t>(str.begin(), str.end()));
+    }
+
+    inline std::string readString(std::istream & is)
+    {
+        const std::vector<uint8_t> bytes = readBytes(is);
+        return std::string(bytes.begin(), bytes.end());
+    }
+
+    // Sections are tagged so a snapshot from a different configuration fails loudly instead of
+    // restoring garbage. Tags are four characters, they read as text in a hex dump.
+    constexpr uint32_t makeTag(const char (&name)[5])
+    {
+        return uint32_t(uint8_t(name[0])) | (uint32_t(uint8_t(name[1])) << 8)
+               | (uint32_t(uint8_t(name[2])) << 16) | (uint32_t(uint8_t(name[3])) << 24);
+    }
+
+    static constexpr uint32_t CORE_TAG = makeTag("CORE");
+    static constexpr uint32_t HART_TAG = makeTag("HART");
+    static constexpr uint32_t SYSCALL_TAG = makeTag("SYSC");
+    static constexpr uint32_t MEMORY_TAG = makeTag("MEMO");
+
+    inline void writeTag(std::ostream & os, const uint32_t tag) { write(os, tag); }
+
+    inline void readTag(std::istream & is, const uint32_t tag)
+    {
+        const uint32_t found_tag = read<uint32_t>(is);
+        sparta_assert(found_tag == tag, "Snapshot section mismatch: expected 0x"
+                                            << std::hex << tag << ", found 0x" << found_tag);
+    }
+} // namespace pegasus::snapshot
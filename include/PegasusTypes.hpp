@@ -34,6 +34,8 @@ namespace pegasus
         INTERRUPT, //! Interrupt
         PAUSE,     //! Pause
         FORK,      //! New thread
+        WFI,       //! Waiting for interrupt
+        FUTEX,     //! Blocked on a futex (system call emulation)
         INVALID    //! Invalid
     };
 
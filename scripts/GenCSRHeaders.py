@@ -170,8 +170,102 @@ def gen_csr_helpers_header():
 
         return '\n'.join(lines)
 
+    def GetFieldDescriptorsCode(RV32_CSR_DEFS, RV64_CSR_DEFS):
+        lines = []
+        lines.append('    // Compile-time description of a CSR field for RV32 and RV64. Fields that do not exist')
+        lines.append('    // for an XLEN have an invalid bit range.')
+        lines.append('    struct CsrFieldBase')
+        lines.append('    {')
+        lines.append('        static constexpr uint32_t INVALID_BIT = 0xffffffff;')
+        lines.append('    };')
+        lines.append('')
+        lines.append('    template <uint32_t CSR_NUM, uint32_t RV32_LSB, uint32_t RV32_MSB, uint32_t RV64_LSB,')
+        lines.append('              uint32_t RV64_MSB>')
+        lines.append('    struct CsrField : CsrFieldBase')
+        lines.append('    {')
+        lines.append('        static constexpr uint32_t csr_num = CSR_NUM;')
+        lines.append('')
+        lines.append('        template <typename XLEN> static constexpr uint32_t lsb()')
+        lines.append('        {')
+        lines.append('            return (sizeof(XLEN) == 8) ? RV64_LSB : RV32_LSB;')
+        lines.append('        }')
+        lines.append('')
+        lines.append('        template <typename XLEN> static constexpr uint32_t msb()')
+        lines.append('        {')
+        lines.append('            return (sizeof(XLEN) == 8) ? RV64_MSB : RV32_MSB;')
+        lines.append('        }')
+        lines.append('')
+        lines.append('        template <typename XLEN> static constexpr bool exists()')
+        lines.append('        {')
+        lines.append('            return lsb<XLEN>() != INVALID_BIT;')
+        lines.append('        }')
+        lines.append('')
+        lines.append('        // Mask of the field bits in place')
+        lines.append('        template <typename XLEN> static constexpr XLEN mask()')
+        lines.append('        {')
+        lines.append('            if constexpr (!exists<XLEN>())')
+        lines.append('            {')
+        lines.append('                return 0;')
+        lines.append('            }')
+        lines.append('            else')
+        lines.append('            {')
+        lines.append('                constexpr uint32_t width = msb<XLEN>() - lsb<XLEN>() + 1;')
+        lines.append('                constexpr XLEN field_mask =')
+        lines.append('                    (width >= (sizeof(XLEN) * 8)) ? ~XLEN(0) : ((XLEN(1) << width) - 1);')
+        lines.append('                return field_mask << lsb<XLEN>();')
+        lines.append('            }')
+        lines.append('        }')
+        lines.append('    };')
+        lines.append('')
+        lines.append('    template <typename FieldT>')
+        lines.append('    concept CsrFieldType = std::is_base_of_v<CsrFieldBase, FieldT>;')
+        lines.append('')
+        lines.append('    // Field descriptors by CSR, e.g. CSR::MSTATUS::MIE')
+        lines.append('    namespace CSR')
+        lines.append('    {')
+
+        csr_nums = sorted(set(RV32_CSR_DEFS.keys()) | set(RV64_CSR_DEFS.keys()))
+        first = True
+        for csr_num in csr_nums:
+            rv32_defn = RV32_CSR_DEFS.get(csr_num)
+            rv64_defn = RV64_CSR_DEFS.get(csr_num)
+            csr_name = (rv64_defn or rv32_defn)['name'].upper()
+
+            # Field names are not consistently capitalized, so they are all upper case here
+            fields = {}
+            for xlen, defn in ((32, rv32_defn), (64, rv64_defn)):
+                if not defn:
+                    continue
+                for field_name, field_defn in defn['fields'].items():
+                    field_name = field_name.upper()
+                    if field_name in ('RESV', 'WPRI'):
+                        continue
+                    fields.setdefault(field_name, {})[xlen] = (field_defn['low_bit'],
+                                                               field_defn['high_bit'])
+            if not fields:
+                continue
+
+            if not first:
+                lines.append('')
+            first = False
+            lines.append('        namespace {}'.format(csr_name))
+            lines.append('        {')
+            for field_name, bit_ranges in fields.items():
+                invalid = ('CsrFieldBase::INVALID_BIT', 'CsrFieldBase::INVALID_BIT')
+                rv32_lsb, rv32_msb = bit_ranges.get(32, invalid)
+                rv64_lsb, rv64_msb = bit_ranges.get(64, invalid)
+                lines.append('            inline constexpr CsrField<0x{:03x}, {}, {}, {}, {}> {}{{}};'.format(
+                    csr_num, rv32_lsb, rv32_msb, rv64_lsb, rv64_msb, field_name))
+            lines.append('        }} // namespace {}'.format(csr_name))
+
+        lines.append('    } // namespace CSR')
+        lines.append('')
+
+        return '\n'.join(lines)
+
     bit_masks_init_code = GetBitMasksInitCode(CSR32_DEFS, CSR64_DEFS)
     bit_ranges_init_code = GetBitRangesInitCode(CSR32_DEFS, CSR64_DEFS)
+    field_descriptors_code = GetFieldDescriptorsCode(CSR32_DEFS, CSR64_DEFS)
 
     code = f"""#pragma once
 
@@ -181,6 +275,7 @@ def gen_csr_helpers_header():
 #include "sparta/utils/SpartaAssert.hpp"
 #include "include/gen/CSRNums.hpp"
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -190,6 +285,8 @@ namespace pegasus
 {bit_masks_init_code}
 
 {bit_ranges_init_code}
+
+{field_descriptors_code}
 }} // namespace pegasus
 
 """
@@ -140,6 +140,55 @@ def run_tests_serially(tests, passing_tests, failing_tests, timeout_tests, outpu
         run_test(testname, wkld, output_dir, passing_tests, failing_tests, timeout_tests, executable)
 
 
+# Run the tests with pegasus' batch mode: one pegasus process per ISA string runs every test of
+# that XLEN in forked workers, the simulator is only built once. Each test gets the same 5 minute
+# timeout as in the serial and parallel modes.
+def run_tests_batched(tests, passing_tests, failing_tests, timeout_tests, output_dir, executable):
+    testnames = {wkld: testname for testname, wkld in tests}
+    for xlen in ["rv32", "rv64"]:
+        batch_tests = [wkld for testname, wkld in tests if (xlen == "rv32") == ("rv32" in testname)]
+        if not batch_tests:
+            continue
+
+        manifest = output_dir + "batch_" + xlen + ".manifest"
+        with open(manifest, "w") as f:
+            f.write("\n".join(batch_tests) + "\n")
+
+        # Logs are named after the workload and its index in the manifest
+        lognames = {wkld: output_dir + os.path.basename(wkld) + "." + str(idx) + ".log"
+                    for idx, wkld in enumerate(batch_tests)}
+
+        isa_string = xlen + "gcbvh_zicsr_zifencei_zicond_zfh"
+        pegasus_cmd = [executable,
+                       "-p", "top.core0.params.isa", isa_string,
+                       "--batch", manifest, "--batch-log-dir", output_dir,
+                       "--batch-timeout", "300"]
+        result = subprocess.run(pegasus_cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        for line in result.stdout.splitlines():
+            fields = line.split()
+            if len(fields) < 2 or fields[0] not in ["PASS", "FAIL", "TIMEOUT"] or fields[1] not in testnames:
+                continue
+
+            wkld = fields[1]
+            testname = testnames[wkld]
+            logname = lognames[wkld]
+            if be_noisy:
+                print(line)
+            if fields[0] == "PASS":
+                os.remove(logname)
+                passing_tests.append(testname)
+            else:
+                if fields[0] == "TIMEOUT":
+                    timeout_tests.append(testname)
+                error = 'UNKNOWN'
+                with open(logname, "r") as log:
+                    for log_line in log:
+                        if log_line.startswith('MAGIC') or log_line.startswith('FAIL'):
+                            error = log_line.strip()
+                            break
+                failing_tests.append([testname, error])
+
+
 def extract_sparta_failures(log_file, failure_dict):
     with open(log_file, 'r') as fin:
         for line in fin.readlines():
@@ -217,6 +266,7 @@ def main():
     parser.add_argument("--tenstorrent", type=str, help="The directory of the built Tenstorrent tests")
     parser.add_argument("--pegasus-exe", type=str, default="./pegasus", help="Path to the Pegasus executable (default: ./pegasus)")
     parser.add_argument("--serial", action='store_true', default=False, help="Run tests serially instead of in parallel")
+    parser.add_argument("--batch", action='store_true', default=False, help="Run tests with the pegasus batch mode (--batch) instead of one pegasus process per test")
     parser.add_argument("--expected-pass-rate", type=float, help="Expected pass rate (for CI purposes only)")
     args = parser.parse_args()
 
@@ -302,6 +352,8 @@ def main():
 
     if args.serial:
         run_tests_serially(tests, passing_tests, failing_tests, timeout_tests, output_dir, args.pegasus_exe)
+    elif args.batch:
+        run_tests_batched(tests, passing_tests, failing_tests, timeout_tests, output_dir, args.pegasus_exe)
     else:
         run_tests_in_parallel(tests, passing_tests, failing_tests, timeout_tests, output_dir, args.pegasus_exe)
 
@@ -49,6 +49,195 @@ RVZVE32X_INST = [
     {'mnemonic': 'vs2r.v', 'handler': 'vs2r.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False, 'veccfg': ['eew32', 'emul2', 'vlmax']},
     {'mnemonic': 'vs4r.v', 'handler': 'vs4r.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False, 'veccfg': ['eew32', 'emul4', 'vlmax']},
     {'mnemonic': 'vs8r.v', 'handler': 'vs8r.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False, 'veccfg': ['eew32', 'emul8', 'vlmax']},
+    {'mnemonic': 'vlseg2e8.v', 'handler': 'vlseg2e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg2e8.v', 'handler': 'vsseg2e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg2e8ff.v', 'handler': 'vlseg2e8ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg2e8.v', 'handler': 'vlsseg2e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg2e8.v', 'handler': 'vssseg2e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg2ei8.v', 'handler': 'vloxseg2ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg2ei8.v', 'handler': 'vluxseg2ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg2ei8.v', 'handler': 'vsoxseg2ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg2ei8.v', 'handler': 'vsuxseg2ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e8.v', 'handler': 'vlseg3e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg3e8.v', 'handler': 'vsseg3e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e8ff.v', 'handler': 'vlseg3e8ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg3e8.v', 'handler': 'vlsseg3e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg3e8.v', 'handler': 'vssseg3e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg3ei8.v', 'handler': 'vloxseg3ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg3ei8.v', 'handler': 'vluxseg3ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg3ei8.v', 'handler': 'vsoxseg3ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg3ei8.v', 'handler': 'vsuxseg3ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e8.v', 'handler': 'vlseg4e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg4e8.v', 'handler': 'vsseg4e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e8ff.v', 'handler': 'vlseg4e8ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg4e8.v', 'handler': 'vlsseg4e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg4e8.v', 'handler': 'vssseg4e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg4ei8.v', 'handler': 'vloxseg4ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg4ei8.v', 'handler': 'vluxseg4ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg4ei8.v', 'handler': 'vsoxseg4ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg4ei8.v', 'handler': 'vsuxseg4ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e8.v', 'handler': 'vlseg5e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg5e8.v', 'handler': 'vsseg5e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e8ff.v', 'handler': 'vlseg5e8ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg5e8.v', 'handler': 'vlsseg5e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg5e8.v', 'handler': 'vssseg5e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg5ei8.v', 'handler': 'vloxseg5ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg5ei8.v', 'handler': 'vluxseg5ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg5ei8.v', 'handler': 'vsoxseg5ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg5ei8.v', 'handler': 'vsuxseg5ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e8.v', 'handler': 'vlseg6e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg6e8.v', 'handler': 'vsseg6e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e8ff.v', 'handler': 'vlseg6e8ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg6e8.v', 'handler': 'vlsseg6e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg6e8.v', 'handler': 'vssseg6e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg6ei8.v', 'handler': 'vloxseg6ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg6ei8.v', 'handler': 'vluxseg6ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg6ei8.v', 'handler': 'vsoxseg6ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg6ei8.v', 'handler': 'vsuxseg6ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e8.v', 'handler': 'vlseg7e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg7e8.v', 'handler': 'vsseg7e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e8ff.v', 'handler': 'vlseg7e8ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg7e8.v', 'handler': 'vlsseg7e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg7e8.v', 'handler': 'vssseg7e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg7ei8.v', 'handler': 'vloxseg7ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg7ei8.v', 'handler': 'vluxseg7ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg7ei8.v', 'handler': 'vsoxseg7ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg7ei8.v', 'handler': 'vsuxseg7ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e8.v', 'handler': 'vlseg8e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg8e8.v', 'handler': 'vsseg8e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e8ff.v', 'handler': 'vlseg8e8ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg8e8.v', 'handler': 'vlsseg8e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg8e8.v', 'handler': 'vssseg8e8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg8ei8.v', 'handler': 'vloxseg8ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg8ei8.v', 'handler': 'vluxseg8ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg8ei8.v', 'handler': 'vsoxseg8ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg8ei8.v', 'handler': 'vsuxseg8ei8.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg2e16.v', 'handler': 'vlseg2e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg2e16.v', 'handler': 'vsseg2e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg2e16ff.v', 'handler': 'vlseg2e16ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg2e16.v', 'handler': 'vlsseg2e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg2e16.v', 'handler': 'vssseg2e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg2ei16.v', 'handler': 'vloxseg2ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg2ei16.v', 'handler': 'vluxseg2ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg2ei16.v', 'handler': 'vsoxseg2ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg2ei16.v', 'handler': 'vsuxseg2ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e16.v', 'handler': 'vlseg3e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg3e16.v', 'handler': 'vsseg3e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e16ff.v', 'handler': 'vlseg3e16ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg3e16.v', 'handler': 'vlsseg3e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg3e16.v', 'handler': 'vssseg3e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg3ei16.v', 'handler': 'vloxseg3ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg3ei16.v', 'handler': 'vluxseg3ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg3ei16.v', 'handler': 'vsoxseg3ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg3ei16.v', 'handler': 'vsuxseg3ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e16.v', 'handler': 'vlseg4e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg4e16.v', 'handler': 'vsseg4e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e16ff.v', 'handler': 'vlseg4e16ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg4e16.v', 'handler': 'vlsseg4e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg4e16.v', 'handler': 'vssseg4e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg4ei16.v', 'handler': 'vloxseg4ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg4ei16.v', 'handler': 'vluxseg4ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg4ei16.v', 'handler': 'vsoxseg4ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg4ei16.v', 'handler': 'vsuxseg4ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e16.v', 'handler': 'vlseg5e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg5e16.v', 'handler': 'vsseg5e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e16ff.v', 'handler': 'vlseg5e16ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg5e16.v', 'handler': 'vlsseg5e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg5e16.v', 'handler': 'vssseg5e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg5ei16.v', 'handler': 'vloxseg5ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg5ei16.v', 'handler': 'vluxseg5ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg5ei16.v', 'handler': 'vsoxseg5ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg5ei16.v', 'handler': 'vsuxseg5ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e16.v', 'handler': 'vlseg6e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg6e16.v', 'handler': 'vsseg6e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e16ff.v', 'handler': 'vlseg6e16ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg6e16.v', 'handler': 'vlsseg6e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg6e16.v', 'handler': 'vssseg6e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg6ei16.v', 'handler': 'vloxseg6ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg6ei16.v', 'handler': 'vluxseg6ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg6ei16.v', 'handler': 'vsoxseg6ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg6ei16.v', 'handler': 'vsuxseg6ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e16.v', 'handler': 'vlseg7e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg7e16.v', 'handler': 'vsseg7e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e16ff.v', 'handler': 'vlseg7e16ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg7e16.v', 'handler': 'vlsseg7e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg7e16.v', 'handler': 'vssseg7e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg7ei16.v', 'handler': 'vloxseg7ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg7ei16.v', 'handler': 'vluxseg7ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg7ei16.v', 'handler': 'vsoxseg7ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg7ei16.v', 'handler': 'vsuxseg7ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e16.v', 'handler': 'vlseg8e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg8e16.v', 'handler': 'vsseg8e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e16ff.v', 'handler': 'vlseg8e16ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg8e16.v', 'handler': 'vlsseg8e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg8e16.v', 'handler': 'vssseg8e16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg8ei16.v', 'handler': 'vloxseg8ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg8ei16.v', 'handler': 'vluxseg8ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg8ei16.v', 'handler': 'vsoxseg8ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg8ei16.v', 'handler': 'vsuxseg8ei16.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg2e32.v', 'handler': 'vlseg2e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg2e32.v', 'handler': 'vsseg2e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg2e32ff.v', 'handler': 'vlseg2e32ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg2e32.v', 'handler': 'vlsseg2e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg2e32.v', 'handler': 'vssseg2e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg2ei32.v', 'handler': 'vloxseg2ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg2ei32.v', 'handler': 'vluxseg2ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg2ei32.v', 'handler': 'vsoxseg2ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg2ei32.v', 'handler': 'vsuxseg2ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e32.v', 'handler': 'vlseg3e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg3e32.v', 'handler': 'vsseg3e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e32ff.v', 'handler': 'vlseg3e32ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg3e32.v', 'handler': 'vlsseg3e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg3e32.v', 'handler': 'vssseg3e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg3ei32.v', 'handler': 'vloxseg3ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg3ei32.v', 'handler': 'vluxseg3ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg3ei32.v', 'handler': 'vsoxseg3ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg3ei32.v', 'handler': 'vsuxseg3ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e32.v', 'handler': 'vlseg4e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg4e32.v', 'handler': 'vsseg4e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e32ff.v', 'handler': 'vlseg4e32ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg4e32.v', 'handler': 'vlsseg4e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg4e32.v', 'handler': 'vssseg4e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg4ei32.v', 'handler': 'vloxseg4ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg4ei32.v', 'handler': 'vluxseg4ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg4ei32.v', 'handler': 'vsoxseg4ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg4ei32.v', 'handler': 'vsuxseg4ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e32.v', 'handler': 'vlseg5e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg5e32.v', 'handler': 'vsseg5e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e32ff.v', 'handler': 'vlseg5e32ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg5e32.v', 'handler': 'vlsseg5e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg5e32.v', 'handler': 'vssseg5e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg5ei32.v', 'handler': 'vloxseg5ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg5ei32.v', 'handler': 'vluxseg5ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg5ei32.v', 'handler': 'vsoxseg5ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg5ei32.v', 'handler': 'vsuxseg5ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e32.v', 'handler': 'vlseg6e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg6e32.v', 'handler': 'vsseg6e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e32ff.v', 'handler': 'vlseg6e32ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg6e32.v', 'handler': 'vlsseg6e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg6e32.v', 'handler': 'vssseg6e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg6ei32.v', 'handler': 'vloxseg6ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg6ei32.v', 'handler': 'vluxseg6ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg6ei32.v', 'handler': 'vsoxseg6ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg6ei32.v', 'handler': 'vsuxseg6ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e32.v', 'handler': 'vlseg7e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg7e32.v', 'handler': 'vsseg7e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e32ff.v', 'handler': 'vlseg7e32ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg7e32.v', 'handler': 'vlsseg7e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg7e32.v', 'handler': 'vssseg7e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg7ei32.v', 'handler': 'vloxseg7ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg7ei32.v', 'handler': 'vluxseg7ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg7ei32.v', 'handler': 'vsoxseg7ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg7ei32.v', 'handler': 'vsuxseg7ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e32.v', 'handler': 'vlseg8e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg8e32.v', 'handler': 'vsseg8e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e32ff.v', 'handler': 'vlseg8e32ff.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg8e32.v', 'handler': 'vlsseg8e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg8e32.v', 'handler': 'vssseg8e32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg8ei32.v', 'handler': 'vloxseg8ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg8ei32.v', 'handler': 'vluxseg8ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg8ei32.v', 'handler': 'vsoxseg8ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg8ei32.v', 'handler': 'vsuxseg8ei32.v', 'cost': 1, 'tags': '.json', 'memory': True, 'cof': False},
     {'mnemonic': 'vadd.vx', 'handler': 'vadd.vx', 'cost': 1, 'tags': '.json', 'memory': False, 'cof': False},
     {'mnemonic': 'vsub.vx', 'handler': 'vsub.vx', 'cost': 1, 'tags': '.json', 'memory': False, 'cof': False},
     {'mnemonic': 'vrsub.vx', 'handler': 'vrsub.vx', 'cost': 1, 'tags': '.json', 'memory': False, 'cof': False},
@@ -380,4 +569,67 @@ RVZVE64X_INST = [
     {'mnemonic': 'vl2re64.v', 'handler': 'vl2re64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False, 'veccfg': ['eew64', 'emul2', 'vlmax']},
     {'mnemonic': 'vl4re64.v', 'handler': 'vl4re64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False, 'veccfg': ['eew64', 'emul4', 'vlmax']},
     {'mnemonic': 'vl8re64.v', 'handler': 'vl8re64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False, 'veccfg': ['eew64', 'emul8', 'vlmax']},
+    {'mnemonic': 'vlseg2e64.v', 'handler': 'vlseg2e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg2e64.v', 'handler': 'vsseg2e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg2e64ff.v', 'handler': 'vlseg2e64ff.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg2e64.v', 'handler': 'vlsseg2e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg2e64.v', 'handler': 'vssseg2e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg2ei64.v', 'handler': 'vloxseg2ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg2ei64.v', 'handler': 'vluxseg2ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg2ei64.v', 'handler': 'vsoxseg2ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg2ei64.v', 'handler': 'vsuxseg2ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e64.v', 'handler': 'vlseg3e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg3e64.v', 'handler': 'vsseg3e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg3e64ff.v', 'handler': 'vlseg3e64ff.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg3e64.v', 'handler': 'vlsseg3e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg3e64.v', 'handler': 'vssseg3e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg3ei64.v', 'handler': 'vloxseg3ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg3ei64.v', 'handler': 'vluxseg3ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg3ei64.v', 'handler': 'vsoxseg3ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg3ei64.v', 'handler': 'vsuxseg3ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e64.v', 'handler': 'vlseg4e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg4e64.v', 'handler': 'vsseg4e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg4e64ff.v', 'handler': 'vlseg4e64ff.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg4e64.v', 'handler': 'vlsseg4e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg4e64.v', 'handler': 'vssseg4e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg4ei64.v', 'handler': 'vloxseg4ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg4ei64.v', 'handler': 'vluxseg4ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg4ei64.v', 'handler': 'vsoxseg4ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg4ei64.v', 'handler': 'vsuxseg4ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e64.v', 'handler': 'vlseg5e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg5e64.v', 'handler': 'vsseg5e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg5e64ff.v', 'handler': 'vlseg5e64ff.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg5e64.v', 'handler': 'vlsseg5e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg5e64.v', 'handler': 'vssseg5e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg5ei64.v', 'handler': 'vloxseg5ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg5ei64.v', 'handler': 'vluxseg5ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg5ei64.v', 'handler': 'vsoxseg5ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg5ei64.v', 'handler': 'vsuxseg5ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e64.v', 'handler': 'vlseg6e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg6e64.v', 'handler': 'vsseg6e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg6e64ff.v', 'handler': 'vlseg6e64ff.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg6e64.v', 'handler': 'vlsseg6e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg6e64.v', 'handler': 'vssseg6e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg6ei64.v', 'handler': 'vloxseg6ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg6ei64.v', 'handler': 'vluxseg6ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg6ei64.v', 'handler': 'vsoxseg6ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg6ei64.v', 'handler': 'vsuxseg6ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e64.v', 'handler': 'vlseg7e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg7e64.v', 'handler': 'vsseg7e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg7e64ff.v', 'handler': 'vlseg7e64ff.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg7e64.v', 'handler': 'vlsseg7e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg7e64.v', 'handler': 'vssseg7e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg7ei64.v', 'handler': 'vloxseg7ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg7ei64.v', 'handler': 'vluxseg7ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg7ei64.v', 'handler': 'vsoxseg7ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg7ei64.v', 'handler': 'vsuxseg7ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e64.v', 'handler': 'vlseg8e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsseg8e64.v', 'handler': 'vsseg8e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlseg8e64ff.v', 'handler': 'vlseg8e64ff.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vlsseg8e64.v', 'handler': 'vlsseg8e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vssseg8e64.v', 'handler': 'vssseg8e64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vloxseg8ei64.v', 'handler': 'vloxseg8ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vluxseg8ei64.v', 'handler': 'vluxseg8ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsoxseg8ei64.v', 'handler': 'vsoxseg8ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
+    {'mnemonic': 'vsuxseg8ei64.v', 'handler': 'vsuxseg8ei64.v', 'cost': 1, 'tags': 'V_EXT_64', 'memory': True, 'cof': False},
 ]
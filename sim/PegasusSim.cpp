@@ -1,7 +1,13 @@
 #include "sim/PegasusSim.hpp"
 #include "include/ActionTags.hpp"
 #include "include/gen/CSRFieldIdxs64.hpp"
+#include "include/PegasusSnapshot.hpp"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
 #include <filesystem>
+#include <fstream>
+#include <thread>
 
 #include "sparta/utils/LogUtils.hpp"
 
@@ -32,13 +38,42 @@ namespace pegasus
             core->boot();
         }
 
+        const std::string restore_snapshot =
+            PegasusSimParameters::getParameter<std::string>(getRoot(), "restore_snapshot");
+        if (!restore_snapshot.empty())
+        {
+            restoreSnapshot(restore_snapshot);
+        }
+
+        for (auto & [core_idx, core] : cores_)
+        {
+            for (auto & [hart_idx, thread] : core->getThreads())
+            {
+                thread->start();
+            }
+        }
+
         getSimulationConfiguration()->scheduler_exacting_run = true;
         getSimulationConfiguration()->scheduler_measure_run_time = false;
         auto start = std::chrono::system_clock::system_clock::now();
-        sparta::app::Simulation::run(run_time);
+        if (PegasusSimParameters::getParameter<bool>(getRoot(), "enable_parallel_cores"))
+        {
+            runParallel_();
+        }
+        else
+        {
+            sparta::app::Simulation::run(run_time);
+        }
         auto end = std::chrono::system_clock::system_clock::now();
         auto sim_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
+        const std::string save_snapshot =
+            PegasusSimParameters::getParameter<std::string>(getRoot(), "save_snapshot");
+        if (!save_snapshot.empty())
+        {
+            saveSnapshot(save_snapshot);
+        }
+
         // FIXME: Only run core 0, hart 0 for now
         const CoreId core_idx = 0;
         const HartId hart_idx = 0;
@@ -51,10 +86,135 @@ namespace pegasus
         std::cout << "Raw time (seconds): " << std::dec << (sim_time / 1000000.0) << std::endl;
         std::cout << "MIPS: " << std::dec << ((inst_count / (sim_time / 1000000.0)) / 1000000.0)
                   << std::endl;
+        const uint64_t trap_count = state->getSimState()->trap_count;
+        std::cout << "Traps taken: " << std::dec << trap_count << std::endl;
+        std::cout << "Traps/sec: " << std::dec << (trap_count / (sim_time / 1000000.0))
+                  << std::endl;
+
+        // Per-hart scheduler utilization for SMP runs
+        if ((cores_.size() > 1) || (cores_.at(core_idx)->getNumThreads() > 1))
+        {
+            std::cout << "Hart utilization:" << std::endl;
+            for (const auto & [core_id, core] : cores_)
+            {
+                core->reportUtilization(std::cout);
+            }
+        }
 
         // TODO: mem usage, workload exit code
     }
 
+    void PegasusSim::saveSnapshot(const std::string & filename)
+    {
+        std::ofstream os(filename, std::ios::binary);
+        sparta_assert(os.is_open(), "Failed to open snapshot " << filename);
+
+        os.write(snapshot::MAGIC, sizeof(snapshot::MAGIC));
+        snapshot::write(os, snapshot::VERSION);
+        snapshot::write<uint32_t>(os, cores_.size());
+        for (auto & [core_idx, core] : cores_)
+        {
+            snapshot::writeTag(os, snapshot::CORE_TAG);
+            core->saveSnapshot(os);
+        }
+        snapshot::writeTag(os, snapshot::SYSCALL_TAG);
+        cores_.at(0)->getSystemCallEmulator()->saveSnapshot(os);
+
+        // Memory goes last, its pages are mapped straight out of the file on restore
+        snapshot::writeTag(os, snapshot::MEMORY_TAG);
+        system_->saveSnapshot(os);
+        sparta_assert(os.good(), "Failed to write snapshot " << filename);
+        std::cout << "Saved snapshot " << filename << std::endl;
+    }
+
+    void PegasusSim::restoreSnapshot(const std::string & filename)
+    {
+        std::ifstream is(filename, std::ios::binary);
+        sparta_assert(is.is_open(), "Failed to open snapshot " << filename);
+
+        char magic[sizeof(snapshot::MAGIC)];
+        is.read(magic, sizeof(magic));
+        sparta_assert(is.good() && std::equal(magic, magic + sizeof(magic), snapshot::MAGIC),
+                      filename << " is not a Pegasus snapshot");
+        const uint32_t version = snapshot::read<uint32_t>(is);
+        sparta_assert(version == snapshot::VERSION, "Snapshot " << filename << " has version "
+                                                                 << version << ", expected "
+                                                                 << snapshot::VERSION);
+        const uint32_t num_cores = snapshot::read<uint32_t>(is);
+        sparta_assert(num_cores == cores_.size(),
+                      "Snapshot was taken with " << num_cores << " cores, not " << cores_.size());
+
+        for (auto & [core_idx, core] : cores_)
+        {
+            snapshot::readTag(is, snapshot::CORE_TAG);
+            core->restoreSnapshot(is);
+        }
+        snapshot::readTag(is, snapshot::SYSCALL_TAG);
+        cores_.at(0)->getSystemCallEmulator()->restoreSnapshot(is);
+        snapshot::readTag(is, snapshot::MEMORY_TAG);
+        system_->restoreSnapshot(is, filename);
+    }
+
+    bool PegasusSim::reloadWorkloads(
+        const PegasusSimParameters::WorkloadsAndArgs & workloads_and_args)
+    {
+        if (!system_->reloadWorkloads(workloads_and_args))
+        {
+            return false;
+        }
+
+        cores_.at(0)->getSystemCallEmulator()->reloadWorkload();
+        for (auto & [core_idx, core] : cores_)
+        {
+            core->reloadWorkloads();
+        }
+        return true;
+    }
+
+    void PegasusSim::runParallel_()
+    {
+        for (auto & [core_idx, core] : cores_)
+        {
+            for (auto & [hart_idx, thread] : core->getThreads())
+            {
+                sparta_assert(thread->getObservers().empty(),
+                              "Observers are not supported with enable_parallel_cores (core"
+                                  << core_idx << ".hart" << hart_idx << ")");
+            }
+        }
+        system_->enableParallelExecution();
+
+        // All cores finish a quantum before any core starts the next one. The completion step
+        // runs on one thread while the others wait, so it sees the state of every core.
+        std::atomic<bool> done = false;
+        auto check_done = [this, &done]() noexcept
+        {
+            done.store(std::none_of(cores_.begin(), cores_.end(),
+                                    [](const auto & core) { return core.second->isRunning(); }),
+                       std::memory_order_relaxed);
+        };
+        std::barrier quantum_barrier(static_cast<std::ptrdiff_t>(cores_.size()), check_done);
+
+        std::vector<std::thread> host_threads;
+        for (auto & [core_idx, core] : cores_)
+        {
+            host_threads.emplace_back(
+                [core, &quantum_barrier, &done]()
+                {
+                    while (!done.load(std::memory_order_relaxed))
+                    {
+                        core->runQuantum();
+                        quantum_barrier.arrive_and_wait();
+                    }
+                });
+        }
+
+        for (auto & host_thread : host_threads)
+        {
+            host_thread.join();
+        }
+    }
+
     bool PegasusSim::step(CoreId core_id, HartId hart_id)
     {
         auto state = getPegasusCore(core_id)->getPegasusState(hart_id);
@@ -144,6 +304,14 @@ namespace pegasus
             tns_to_delete_.emplace_back(
                 core_tn = new sparta::ResourceTreeNode(getRoot(), core_name, "cores", core_idx,
                                                        "Core", &core_factory_));
+
+            // top.core*.allocators
+            // The allocators are not thread safe, so each core gets its own when the cores run on
+            // parallel host threads
+            if (PegasusSimParameters::getParameter<bool>(getRoot(), "enable_parallel_cores"))
+            {
+                tns_to_delete_.emplace_back(new PegasusAllocators(core_tn));
+            }
         }
     }
 
@@ -223,6 +391,7 @@ namespace pegasus
                         old_value = reg->dmiRead<uint32_t>();
                         reg->dmiWrite<uint32_t>(new_reg_value);
                     }
+                    thread->syncVecRegsFromSparta();
                     std::cout << std::hex << std::showbase << std::setfill(' ');
 
                     std::cout << "Setting ";
@@ -27,6 +27,8 @@ namespace pegasus
 
         PegasusCore* getPegasusCore(CoreId core_id = 0) const { return cores_.at(core_id); }
 
+        uint32_t getNumCores() const { return cores_.size(); }
+
         PegasusSystem* getPegasusSystem() const { return system_; }
 
         void enableInteractiveMode();
@@ -37,11 +39,26 @@ namespace pegasus
 
         void endSimulation(int64_t exit_code);
 
+        // Save the architectural state of every core, the emulated process and memory to a file
+        void saveSnapshot(const std::string & filename);
+
+        // Restore a snapshot taken with the same configuration and workload. Memory is mapped
+        // copy-on-write from the file, so many simulators can share one snapshot.
+        void restoreSnapshot(const std::string & filename);
+
+        // Replace the workloads of a simulator that has been built but not run, so one tree can
+        // run many workloads (batch mode). Returns false if the workloads need a different
+        // memory map, the simulator cannot be used then.
+        bool reloadWorkloads(const PegasusSimParameters::WorkloadsAndArgs & workloads_and_args);
+
       private:
         void buildTree_() override;
         void configureTree_() override;
         void bindTree_() override;
 
+        // Run each core on its own host thread until all harts have stopped
+        void runParallel_();
+
         sparta::ResourceFactory<pegasus::PegasusCore, pegasus::PegasusCore::PegasusCoreParameters>
             core_factory_;
         sparta::ResourceFactory<pegasus::PegasusSystem,
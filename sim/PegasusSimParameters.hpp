@@ -38,9 +38,18 @@ namespace pegasus
                 "inst_limit", 0, "Instruction limit for all harts", ps));
             syscall_emulation_.reset(new sparta::Parameter<bool>(
                 "enable_syscall_emulation", false, "System calls (ecall) will be emulated", ps));
+            parallel_cores_.reset(new sparta::Parameter<bool>(
+                "enable_parallel_cores", false,
+                "Run each core on its own host thread, synchronizing at quantum boundaries", ps));
             reg_overrides_.reset(new RegisterOverridesParam(
                 "reg_overrides", {},
                 "Override initial values of registers e.g. \"core0.hart0.sp 0x1000\"", ps));
+            save_snapshot_.reset(new sparta::Parameter<std::string>(
+                "save_snapshot", "", "Save the simulator state to this file when simulation ends",
+                ps));
+            restore_snapshot_.reset(new sparta::Parameter<std::string>(
+                "restore_snapshot", "",
+                "Restore the simulator state from this file before simulation starts", ps));
         }
 
         template <typename T>
@@ -77,6 +86,9 @@ namespace pegasus
         std::unique_ptr<WorkloadsParam> workloads_;
         std::unique_ptr<sparta::Parameter<uint64_t>> inst_limit_;
         std::unique_ptr<sparta::Parameter<bool>> syscall_emulation_;
+        std::unique_ptr<sparta::Parameter<bool>> parallel_cores_;
         std::unique_ptr<RegisterOverridesParam> reg_overrides_;
+        std::unique_ptr<sparta::Parameter<std::string>> save_snapshot_;
+        std::unique_ptr<sparta::Parameter<std::string>> restore_snapshot_;
     };
 } // namespace pegasus
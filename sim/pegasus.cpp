@@ -1,6 +1,16 @@
 
 #include <iomanip>
 #include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <chrono>
+#include <map>
+#include <thread>
+
+#include <csignal>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include "sim/PegasusSim.hpp"
 #include "sparta/app/CommandLineSimulator.hpp"
@@ -8,8 +18,9 @@
 const char USAGE[] = "Usage:\n"
                      "./pegasus [-i inst limit] [--reg \"core*.hart*.name value\"] [--opcode "
                      "opcode] [--interactive] "
-                     "[--spike-formatting] <workloads>"
-                     "\n";
+                     "[--spike-formatting] <workloads>\n"
+                     "./pegasus [options] --batch <manifest> [--batch-jobs N] "
+                     "[--batch-log-dir dir] [--batch-timeout seconds]\n";
 
 struct RegOverride
 {
@@ -27,12 +38,322 @@ static inline std::istream & operator>>(std::istream & is, RegOverride & into)
     return is >> std::skipws >> into.name >> into.value;
 }
 
+// Split workloads given on the command line (or a batch manifest), each one a string with the
+// workload and its arguments
+static pegasus::PegasusSimParameters::WorkloadsAndArgs
+getWorkloadsAndArgs(const std::vector<std::string> & workloads)
+{
+    pegasus::PegasusSimParameters::WorkloadsAndArgs workloads_and_args;
+    for (uint32_t wkld_idx = 0; wkld_idx < workloads.size(); ++wkld_idx)
+    {
+        workloads_and_args.emplace_back();
+        pegasus::PegasusSimParameters::WorkloadAndArgs & workload_and_args =
+            workloads_and_args.back();
+        sparta::utils::tokenize_on_whitespace(workloads[wkld_idx], workload_and_args);
+
+        // Get full path of workload
+        const std::filesystem::path workload_path =
+            std::filesystem::canonical(std::filesystem::absolute(workload_and_args[0]));
+
+        workload_and_args[0] = workload_path.string();
+    }
+    return workloads_and_args;
+}
+
+// Set the workloads parameter
+static void setWorkloads(sparta::app::SimulationConfiguration & sim_cfg,
+                         const std::vector<std::string> & workloads)
+{
+    const std::string wkld_and_args_param_value =
+        pegasus::PegasusSimParameters::convertVectorToStringParam(getWorkloadsAndArgs(workloads));
+    sim_cfg.processParameter("top.extension.sim.workloads", wkld_and_args_param_value);
+}
+
+// Build the simulator tree and apply the command line options
+static void buildSimulation(sparta::app::CommandLineSimulator & cls,
+                            const boost::program_options::variables_map & vm,
+                            pegasus::PegasusSim & sim, const std::string & opcode,
+                            const std::string & eot_mode)
+{
+    cls.populateSimulation(&sim);
+
+    if (vm.count("opcode"))
+    {
+        const pegasus::CoreId core_idx = 0;
+        const pegasus::HartId hart_idx = 0;
+        const uint64_t pc = 0x1000;
+        // Assume opcode is a hex string
+        const uint64_t opcode_val = std::stoull(opcode, nullptr, 16);
+        pegasus::PegasusState* state = sim.getPegasusCore(core_idx)->getPegasusState(hart_idx);
+        state->writeMemory(pc, opcode_val);
+        state->setPc(pc);
+    }
+
+    if (vm.count("interactive"))
+    {
+        sim.enableInteractiveMode();
+    }
+
+    if (vm.count("spike-formatting") > 0)
+    {
+        sim.useSpikeFormatting();
+    }
+
+    if (not eot_mode.empty())
+    {
+        sim.setEOTMode(eot_mode);
+    }
+}
+
+// Run a built simulator. Returns the workload exit code.
+static int finishSimulation(sparta::app::CommandLineSimulator & cls, pegasus::PegasusSim & sim)
+{
+    cls.runSimulator(&sim);
+
+    cls.postProcess(&sim);
+
+    // Get workload exit code
+    const pegasus::CoreId core_idx = 0;
+    const pegasus::HartId hart_idx = 0;
+    const pegasus::PegasusState::SimState* sim_state =
+        sim.getPegasusCore(core_idx)->getPegasusState(hart_idx)->getSimState();
+    const int exit_code = sim_state->workload_exit_code;
+    std::cout << "Workload exit code: " << std::dec << exit_code << std::endl;
+    return exit_code;
+}
+
+// Build, run and tear down a simulator. Returns the workload exit code.
+static int runSimulation(sparta::app::CommandLineSimulator & cls,
+                         const boost::program_options::variables_map & vm,
+                         const std::string & opcode, const std::string & eot_mode)
+{
+    // Create the simulator
+    sparta::Scheduler scheduler;
+    pegasus::PegasusSim sim(&scheduler);
+
+    buildSimulation(cls, vm, sim, opcode, eot_mode);
+    return finishSimulation(cls, sim);
+}
+
+// Replace the running process with a pegasus that runs a single workload of a batch, with the
+// rest of the command line unchanged. Only returns if exec fails.
+static void execSingleWorkload(int argc, char** argv, const std::string & workload)
+{
+    std::vector<std::string> args{argv[0]};
+    for (int arg_idx = 1; arg_idx < argc; ++arg_idx)
+    {
+        const std::string arg = argv[arg_idx];
+        bool batch_option = false;
+        for (const std::string option : {"--batch", "--batch-jobs", "--batch-log-dir",
+                                         "--batch-timeout"})
+        {
+            if (arg == option)
+            {
+                // Skip the option's value too
+                ++arg_idx;
+                batch_option = true;
+            }
+            else if (arg.starts_with(option + "="))
+            {
+                batch_option = true;
+            }
+        }
+        if (!batch_option)
+        {
+            args.emplace_back(arg);
+        }
+    }
+    args.emplace_back("--workloads");
+    args.emplace_back(workload);
+
+    std::vector<char*> exec_argv;
+    for (std::string & arg : args)
+    {
+        exec_argv.emplace_back(arg.data());
+    }
+    exec_argv.emplace_back(nullptr);
+    ::execv("/proc/self/exe", exec_argv.data());
+    std::cerr << "exec failed: " << strerror(errno) << std::endl;
+}
+
+// Run every workload of a manifest (one workload and its arguments per line, # for comments) in
+// its own simulator. The simulator tree is built once for the first workload, then up to
+// num_jobs workloads run at a time in forked worker processes that load their workload into
+// their copy of the tree, so the workers share nothing and only pay for loading the ELF. A
+// workload that needs a different memory map (magic memory) runs in a fresh pegasus instead.
+// Workers running longer than timeout seconds (0: no limit) are killed. The output of each
+// workload goes to <log_dir>/<workload name>.<manifest index>.log. Returns 0 if every workload
+// exited with 0.
+static int runBatch(sparta::app::CommandLineSimulator & cls,
+                    const boost::program_options::variables_map & vm, int argc, char** argv,
+                    const std::string & manifest, uint32_t num_jobs, const std::string & log_dir,
+                    uint32_t timeout, const std::string & opcode, const std::string & eot_mode)
+{
+    std::ifstream manifest_file(manifest);
+    sparta_assert(manifest_file.is_open(), "Failed to open batch manifest: " << manifest);
+
+    std::vector<std::string> batch_workloads;
+    std::string line;
+    while (std::getline(manifest_file, line))
+    {
+        const size_t start = line.find_first_not_of(" \t");
+        if ((start != std::string::npos) && (line[start] != '#'))
+        {
+            batch_workloads.emplace_back(line.substr(start));
+        }
+    }
+
+    if (num_jobs == 0)
+    {
+        num_jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::filesystem::create_directories(log_dir);
+
+    // Build the tree (arch files, Mavis, register JSONs) once, the workers inherit it
+    sparta::Scheduler scheduler;
+    pegasus::PegasusSim sim(&scheduler);
+    if (!batch_workloads.empty())
+    {
+        setWorkloads(cls.getSimulationConfiguration(), {batch_workloads.front()});
+        buildSimulation(cls, vm, sim, opcode, eot_mode);
+    }
+
+    struct Job
+    {
+        std::string workload;
+        std::chrono::steady_clock::time_point start;
+        bool timed_out = false;
+    };
+
+    std::map<pid_t, Job> running_jobs;
+    uint32_t num_passed = 0;
+    const auto batch_start = std::chrono::steady_clock::now();
+
+    // Wait for a worker to finish and report its result, killing workers that ran out of time
+    auto reap_job = [&running_jobs, &num_passed, timeout]()
+    {
+        int status = 0;
+        pid_t pid = 0;
+        while ((pid = ::waitpid(-1, &status, (timeout > 0) ? WNOHANG : 0)) == 0)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            for (auto & [job_pid, job] : running_jobs)
+            {
+                if (!job.timed_out && ((now - job.start) > std::chrono::seconds(timeout)))
+                {
+                    ::kill(job_pid, SIGKILL);
+                    job.timed_out = true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        sparta_assert(pid > 0, "waitpid failed: " << strerror(errno));
+        const Job job = running_jobs.at(pid);
+        running_jobs.erase(pid);
+
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - job.start).count();
+        const bool passed = !job.timed_out && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+        num_passed += passed ? 1 : 0;
+
+        std::cout << (job.timed_out ? "TIMEOUT " : (passed ? "PASS " : "FAIL ")) << job.workload
+                  << " (";
+        if (WIFEXITED(status))
+        {
+            std::cout << "exit code " << std::dec << WEXITSTATUS(status);
+        }
+        else
+        {
+            std::cout << "signal " << std::dec << WTERMSIG(status);
+        }
+        std::cout << ", " << std::fixed << std::setprecision(3) << seconds << "s)"
+                  << std::defaultfloat << std::endl;
+    };
+
+    for (uint32_t wkld_idx = 0; wkld_idx < batch_workloads.size(); ++wkld_idx)
+    {
+        const std::string & workload = batch_workloads[wkld_idx];
+        if (running_jobs.size() == num_jobs)
+        {
+            reap_job();
+        }
+
+        // Don't let the worker inherit buffered output
+        std::cout.flush();
+        std::cerr.flush();
+
+        const pid_t pid = ::fork();
+        sparta_assert(pid >= 0, "fork failed: " << strerror(errno));
+        if (pid == 0)
+        {
+            // Worker: send the output to the workload's log and run the simulation. The index
+            // keeps the logs of workloads with the same file name apart.
+            int exit_code = 1;
+            try
+            {
+                const std::string workload_name =
+                    std::filesystem::path(workload.substr(0, workload.find_first_of(" \t")))
+                        .filename()
+                        .string();
+                const std::string log_filename =
+                    log_dir + "/" + workload_name + "." + std::to_string(wkld_idx) + ".log";
+                const int log_fd = ::open(log_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                sparta_assert(log_fd >= 0, "Failed to open " << log_filename);
+                ::dup2(log_fd, STDOUT_FILENO);
+                ::dup2(log_fd, STDERR_FILENO);
+                ::close(log_fd);
+
+                if (sim.reloadWorkloads(getWorkloadsAndArgs({workload})))
+                {
+                    exit_code = finishSimulation(cls, sim);
+                }
+                else
+                {
+                    std::cout << "Workload needs a different memory map than the batch "
+                                 "simulator, running it in its own simulator"
+                              << std::endl;
+                    std::cout.flush();
+                    execSingleWorkload(argc, argv, workload);
+                }
+            }
+            catch (const std::exception & e)
+            {
+                std::cerr << e.what() << std::endl;
+            }
+            std::cout.flush();
+            std::cerr.flush();
+
+            // Keep failures visible in the 8-bit process exit status
+            ::_exit((exit_code == 0) ? 0 : (((exit_code & 0xff) == 0) ? 1 : (exit_code & 0xff)));
+        }
+
+        running_jobs.emplace(pid, Job{workload, std::chrono::steady_clock::now()});
+    }
+
+    while (!running_jobs.empty())
+    {
+        reap_job();
+    }
+
+    const double batch_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - batch_start).count();
+    std::cout << "Batch: " << std::dec << num_passed << "/" << batch_workloads.size()
+              << " workloads passed in " << std::fixed << std::setprecision(3) << batch_seconds
+              << "s with " << num_jobs << " jobs" << std::defaultfloat << std::endl;
+
+    return (num_passed == batch_workloads.size()) ? 0 : 1;
+}
+
 int main(int argc, char** argv)
 {
     uint64_t ilimit = 0;
     std::string opcode = "";
     std::vector<std::string> workloads;
     std::string eot_mode;
+    std::string batch_manifest;
+    uint32_t batch_jobs = 0;
+    std::string batch_log_dir = ".";
+    uint32_t batch_timeout = 0;
 
     sparta::app::DefaultValues DEFAULTS;
     DEFAULTS.auto_summary_default = "off";
@@ -66,7 +387,11 @@ int main(int argc, char** argv)
             ("interactive", "Enable interactive mode (IDE)")
             ("eot-mode", po::value<std::string>(&eot_mode), "End of testing mode (pass_fail, magic_mem) [currently IGNORED]")
             ("spike-formatting", "Format the Instruction Logger similar to Spike")
-            ("workloads,w", po::value<std::vector<std::string>>(&workloads), "Workload(s) to run with workload arguments");
+            ("workloads,w", po::value<std::vector<std::string>>(&workloads), "Workload(s) to run with workload arguments")
+            ("batch", po::value<std::string>(&batch_manifest), "Run each workload (with arguments) listed in a manifest file in its own simulator")
+            ("batch-jobs", po::value<uint32_t>(&batch_jobs), "Number of batch workloads to run at once (default: number of host CPUs)")
+            ("batch-log-dir", po::value<std::string>(&batch_log_dir), "Directory for the batch workload logs (default: .)")
+            ("batch-timeout", po::value<uint32_t>(&batch_timeout), "Kill batch workloads running longer than this many seconds (default: no limit)");
 
         // Add any positional command-line options
         po::positional_options_description & pos_opts = cls.getPositionalOptions();
@@ -91,26 +416,11 @@ int main(int argc, char** argv)
         auto & sim_cfg = cls.getSimulationConfiguration();
 
         // Workload
-        pegasus::PegasusSimParameters::WorkloadsAndArgs workloads_and_args;
+        sparta_assert(workloads.empty() || batch_manifest.empty(),
+                      "Workloads cannot be given with --batch, list them in the manifest");
         if (workloads.empty() == false)
         {
-            for (uint32_t wkld_idx = 0; wkld_idx < workloads.size(); ++wkld_idx)
-            {
-                workloads_and_args.emplace_back();
-                pegasus::PegasusSimParameters::WorkloadAndArgs & workload_and_args =
-                    workloads_and_args.back();
-                sparta::utils::tokenize_on_whitespace(workloads[wkld_idx], workload_and_args);
-
-                // Get full path of workload
-                const std::filesystem::path workload_path =
-                    std::filesystem::canonical(std::filesystem::absolute(workload_and_args[0]));
-
-                workload_and_args[0] = workload_path.string();
-            }
-
-            const std::string wkld_and_args_param_value =
-                pegasus::PegasusSimParameters::convertVectorToStringParam(workloads_and_args);
-            sim_cfg.processParameter("top.extension.sim.workloads", wkld_and_args_param_value);
+            setWorkloads(sim_cfg, workloads);
         }
 
         // Inst limit
@@ -137,50 +447,15 @@ int main(int argc, char** argv)
             sim_cfg.processParameter("top.extension.sim.reg_overrides", reg_overrides_param_value);
         }
 
-        // Create the simulator
-        sparta::Scheduler scheduler;
-        pegasus::PegasusSim sim(&scheduler);
-
-        cls.populateSimulation(&sim);
-
-        if (vm.count("opcode"))
-        {
-            const pegasus::CoreId core_idx = 0;
-            const pegasus::HartId hart_idx = 0;
-            const uint64_t pc = 0x1000;
-            // Assume opcode is a hex string
-            const uint64_t opcode_val = std::stoull(opcode, nullptr, 16);
-            pegasus::PegasusState* state = sim.getPegasusCore(core_idx)->getPegasusState(hart_idx);
-            state->writeMemory(pc, opcode_val);
-            state->setPc(pc);
-        }
-
-        if (vm.count("interactive"))
+        if (batch_manifest.empty() == false)
         {
-            sim.enableInteractiveMode();
+            exit_code = runBatch(cls, vm, argc, argv, batch_manifest, batch_jobs, batch_log_dir,
+                                 batch_timeout, opcode, eot_mode);
         }
-
-        if (vm.count("spike-formatting") > 0)
+        else
         {
-            sim.useSpikeFormatting();
+            exit_code = runSimulation(cls, vm, opcode, eot_mode);
         }
-
-        if (not eot_mode.empty())
-        {
-            sim.setEOTMode(eot_mode);
-        }
-
-        cls.runSimulator(&sim);
-
-        cls.postProcess(&sim);
-
-        // Get workload exit code
-        const pegasus::CoreId core_idx = 0;
-        const pegasus::HartId hart_idx = 0;
-        const pegasus::PegasusState::SimState* sim_state =
-            sim.getPegasusCore(core_idx)->getPegasusState(hart_idx)->getSimState();
-        exit_code = sim_state->workload_exit_code;
-        std::cout << "Workload exit code: " << std::dec << exit_code << std::endl;
     }
     catch (...)
     {
@@ -0,0 +1,166 @@
+#include "system/FlatMemory.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace pegasus
+{
+    FlatMemory::FlatMemory(sparta::TreeNode* parent, const std::string & name,
+                           const sparta::memory::addr_t block_size,
+                           const sparta::memory::addr_t size) :
+        sparta::memory::BlockingMemoryIFNode(parent, name, sparta::TreeNode::GROUP_NAME_NONE,
+                                             sparta::TreeNode::GROUP_IDX_NONE,
+                                             "Flat mmap-backed memory", nullptr, block_size,
+                                             {0, size, name + "_window"}),
+        size_(size)
+    {
+        void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        sparta_assert(data != MAP_FAILED,
+                      "Failed to reserve 0x" << std::hex << size_ << " bytes for " << name);
+        data_ = static_cast<uint8_t*>(data);
+    }
+
+    FlatMemory::~FlatMemory() { munmap(data_, size_); }
+
+    std::vector<FlatMemory::Range> FlatMemory::getPopulatedRanges() const
+    {
+        // Only pages the guest touched can hold data, skip the rest of the reservation without
+        // reading it
+        const std::vector<bool> touched = getTouchedPages_();
+
+        static const std::vector<uint8_t> zero_page(HOST_PAGE_SIZE, 0);
+        std::vector<Range> ranges;
+        for (sparta::memory::addr_t page = 0; page < touched.size(); ++page)
+        {
+            const sparta::memory::addr_t offset = page * HOST_PAGE_SIZE;
+            if (!touched[page]
+                || (std::memcmp(data_ + offset, zero_page.data(), HOST_PAGE_SIZE) == 0))
+            {
+                continue;
+            }
+
+            if (!ranges.empty() && ((ranges.back().first + ranges.back().second) == offset))
+            {
+                ranges.back().second += HOST_PAGE_SIZE;
+            }
+            else
+            {
+                ranges.emplace_back(offset, HOST_PAGE_SIZE);
+            }
+        }
+        return ranges;
+    }
+
+    std::vector<bool> FlatMemory::getTouchedPages_() const
+    {
+        // A page that was written is either in RAM or swapped out, the kernel reports both in
+        // /proc/self/pagemap. mincore is not enough, it only reports pages that are in RAM.
+        const sparta::memory::addr_t num_pages = size_ / HOST_PAGE_SIZE;
+        const int fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            // Without the page table every page has to be checked
+            return std::vector<bool>(num_pages, true);
+        }
+
+        std::vector<bool> touched(num_pages, false);
+        const uint64_t sys_page_size = sysconf(_SC_PAGESIZE);
+        sparta_assert((sys_page_size % HOST_PAGE_SIZE) == 0,
+                      "Unsupported host page size " << sys_page_size);
+        const uint64_t pages_per_entry = sys_page_size / HOST_PAGE_SIZE;
+        const uint64_t first_entry = reinterpret_cast<uintptr_t>(data_) / sys_page_size;
+        const uint64_t num_entries = (size_ + sys_page_size - 1) / sys_page_size;
+
+        constexpr uint64_t PAGEMAP_PRESENT = 1ull << 63;
+        constexpr uint64_t PAGEMAP_SWAPPED = 1ull << 62;
+        constexpr uint64_t ENTRIES_PER_READ = 512;
+        std::array<uint64_t, ENTRIES_PER_READ> entries;
+        for (uint64_t entry = 0; entry < num_entries; entry += ENTRIES_PER_READ)
+        {
+            const uint64_t count = std::min(ENTRIES_PER_READ, num_entries - entry);
+            const ssize_t bytes = pread(fd, entries.data(), count * sizeof(uint64_t),
+                                        (first_entry + entry) * sizeof(uint64_t));
+            if (bytes != static_cast<ssize_t>(count * sizeof(uint64_t)))
+            {
+                close(fd);
+                return std::vector<bool>(num_pages, true);
+            }
+
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                if ((entries[i] & (PAGEMAP_PRESENT | PAGEMAP_SWAPPED)) != 0)
+                {
+                    const uint64_t first_page = (entry + i) * pages_per_entry;
+                    const uint64_t end_page = std::min(first_page + pages_per_entry, num_pages);
+                    std::fill(touched.begin() + first_page, touched.begin() + end_page, true);
+                }
+            }
+        }
+        close(fd);
+
+        // Pages mapped from a file hold data before they are first accessed
+        for (const auto & [offset, size] : file_ranges_)
+        {
+            std::fill(touched.begin() + offset / HOST_PAGE_SIZE,
+                      touched.begin() + (offset + size + HOST_PAGE_SIZE - 1) / HOST_PAGE_SIZE,
+                      true);
+        }
+        return touched;
+    }
+
+    void FlatMemory::clear()
+    {
+        void* data = mmap(data_, size_, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+        sparta_assert(data == data_, "Failed to clear the flat memory");
+        file_ranges_.clear();
+    }
+
+    void FlatMemory::mapFile(int fd, off_t file_offset, sparta::memory::addr_t offset,
+                             sparta::memory::addr_t size)
+    {
+        sparta_assert(((offset % HOST_PAGE_SIZE) == 0) && ((file_offset % HOST_PAGE_SIZE) == 0)
+                          && ((offset + size) <= size_),
+                      "Bad flat memory file mapping at offset 0x" << std::hex << offset);
+        void* data = mmap(data_ + offset, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                          fd, file_offset);
+        sparta_assert(data == data_ + offset, "Failed to map file over the flat memory");
+        file_ranges_.emplace_back(offset, size);
+    }
+
+    bool FlatMemory::tryRead_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                              uint8_t* buf, const void*, void*)
+    {
+        std::memcpy(buf, data_ + addr, size);
+        return true;
+    }
+
+    bool FlatMemory::tryWrite_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                               const uint8_t* buf, const void*, void*)
+    {
+        std::memcpy(data_ + addr, buf, size);
+        return true;
+    }
+
+    bool FlatMemory::tryPeek_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                              uint8_t* buf) const
+    {
+        std::memcpy(buf, data_ + addr, size);
+        return true;
+    }
+
+    bool FlatMemory::tryPoke_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                              const uint8_t* buf)
+    {
+        std::memcpy(data_ + addr, buf, size);
+        return true;
+    }
+} // namespace pegasus
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "sparta/memory/BlockingMemoryIFNode.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace pegasus
+{
+    /*!
+     * \class FlatMemory
+     * \brief Guest DRAM backed by a single host mmap region
+     *
+     * The whole region is reserved up front with MAP_NORESERVE, host pages are only committed
+     * when the guest first touches them. Offset N of the memory interface is byte N of the host
+     * region, so DRAM can be accessed directly through getHostPointer() as well as through the
+     * BlockingMemoryIF interface used by the memory map, devices and observers.
+     */
+    class FlatMemory : public sparta::memory::BlockingMemoryIFNode
+    {
+      public:
+        FlatMemory(sparta::TreeNode* parent, const std::string & name,
+                   const sparta::memory::addr_t block_size, const sparta::memory::addr_t size);
+
+        ~FlatMemory();
+
+        sparta::memory::addr_t getSize() const { return size_; }
+
+        uint8_t* getHostPointer(const sparta::memory::addr_t offset) { return data_ + offset; }
+
+        static constexpr sparta::memory::addr_t HOST_PAGE_SIZE = 0x1000;
+
+        // Runs of host pages that hold data (touched, whether in RAM or swapped out, and not all
+        // zeroes) as (offset, size) pairs in increasing order
+        using Range = std::pair<sparta::memory::addr_t, sparta::memory::addr_t>;
+        std::vector<Range> getPopulatedRanges() const;
+
+        // Drop every page, the whole region reads as zero again
+        void clear();
+
+        // Map part of a file over the region copy-on-write. The pages are read from the file on
+        // first access and only copied when written, so many simulators can map the same file.
+        void mapFile(int fd, off_t file_offset, sparta::memory::addr_t offset,
+                     sparta::memory::addr_t size);
+
+      private:
+        const sparta::memory::addr_t size_;
+        uint8_t* data_ = nullptr;
+
+        // Ranges mapped from files by mapFile, as (offset, size) pairs
+        std::vector<Range> file_ranges_;
+
+        // Pages that may hold data, indexed by host page
+        std::vector<bool> getTouchedPages_() const;
+
+        bool tryRead_(sparta::memory::addr_t addr, sparta::memory::addr_t size, uint8_t* buf,
+                      const void* in_supplement, void* out_supplement) override final;
+        bool tryWrite_(sparta::memory::addr_t addr, sparta::memory::addr_t size, const uint8_t* buf,
+                       const void* in_supplement, void* out_supplement) override final;
+        bool tryPeek_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                      uint8_t* buf) const override final;
+        bool tryPoke_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                      const uint8_t* buf) override final;
+    };
+} // namespace pegasus
@@ -4,11 +4,17 @@
 #include "sparta/memory/SimpleMemoryMapNode.hpp"
 #include "sparta/memory/MemoryObject.hpp"
 #include "sparta/utils/LogUtils.hpp"
+#include "include/PegasusSnapshot.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace pegasus
 {
     PegasusSystem::PegasusSystem(sparta::TreeNode* sys_node, const PegasusSystemParameters* p) :
         sparta::Unit(sys_node),
+        enable_flat_memory_(p->enable_flat_memory),
+        flat_memory_size_(p->flat_memory_size),
         workloads_and_args_(
             PegasusSimParameters::getParameter<PegasusSimParameters::WorkloadsAndArgs>(sys_node,
                                                                                        "workloads"))
@@ -185,12 +191,15 @@ namespace pegasus
 
     void PegasusSystem::createMemoryMappings_(sparta::TreeNode* sys_node)
     {
-        using BMOIfNode = sparta::memory::BlockingMemoryObjectIFNode;
-        using BMIfNode = sparta::memory::BlockingMemoryIFNode;
-        using MemObj = sparta::memory::MemoryObject;
-
-        BMIfNode* memory_if = nullptr;
-        MemObj* mem_obj = nullptr;
+        if (enable_flat_memory_)
+        {
+            sparta_assert((flat_memory_size_ % PEGASUS_SYSTEM_BLOCK_SIZE) == 0,
+                          "Flat memory size must be a multiple of the block size: 0x"
+                              << std::hex << flat_memory_size_);
+            tree_nodes_.emplace_back(flat_memory_ = new FlatMemory(sys_node, "flat_memory",
+                                                                   PEGASUS_SYSTEM_BLOCK_SIZE,
+                                                                   flat_memory_size_));
+        }
 
         // The allocated memory blocks (Magic Mem, UART, etc)
         struct AllocatedMemoryBlock
@@ -258,7 +267,6 @@ namespace pegasus
         ////////////////////////////////////////////////////////////////////////////////
         // Now fill in the memory "blanks"
         sparta::memory::addr_t addr_block_start = 0;
-        const uint32_t illop = 0;
         uint32_t block_num = 1;
 
         while (false == allocated_blocks.empty())
@@ -271,17 +279,7 @@ namespace pegasus
             if (addr_block_start < alloc_block.start_address)
             {
                 // Add a memory block up to the allocated block
-                const auto block_size = alloc_block.start_address - addr_block_start;
-                memory_objects_.emplace_back(mem_obj =
-                                                 new MemObj(sys_node, PEGASUS_SYSTEM_BLOCK_SIZE,
-                                                            block_size, illop, sizeof(illop)));
-                tree_nodes_.emplace_back(memory_if = new BMOIfNode(
-                                             sys_node, "mb_" + std::to_string(block_num),
-                                             sparta::TreeNode::GROUP_NAME_NONE,
-                                             sparta::TreeNode::GROUP_IDX_NONE,
-                                             "mb_" + std::to_string(block_num), nullptr, *mem_obj));
-                memory_map_->addMapping(addr_block_start, addr_block_start + block_size, memory_if,
-                                        0x0 /* Additional offset */);
+                addDramMapping_(sys_node, addr_block_start, alloc_block.start_address, block_num);
             }
 
             // Determine the next large block of memory
@@ -293,18 +291,44 @@ namespace pegasus
         }
 
         // Add the rest of memory
-        memory_objects_.emplace_back(mem_obj =
-                                         new MemObj(sys_node, PEGASUS_SYSTEM_BLOCK_SIZE,
-                                                    PEGASUS_SYSTEM_TOTAL_MEMORY - addr_block_start,
-                                                    illop, sizeof(illop)));
+        addDramMapping_(sys_node, addr_block_start, PEGASUS_SYSTEM_TOTAL_MEMORY, block_num);
+        memory_map_->dumpMappings(std::cout);
+    }
+
+    void PegasusSystem::addDramMapping_(sparta::TreeNode* sys_node, sparta::memory::addr_t start,
+                                        const sparta::memory::addr_t end, const uint32_t block_num)
+    {
+        using BMOIfNode = sparta::memory::BlockingMemoryObjectIFNode;
+        using BMIfNode = sparta::memory::BlockingMemoryIFNode;
+        using MemObj = sparta::memory::MemoryObject;
+
+        // The part of the range that fits in the flat memory is mapped 1:1 onto it
+        if ((flat_memory_ != nullptr) && (start < flat_memory_size_))
+        {
+            const sparta::memory::addr_t flat_end = std::min(end, flat_memory_size_);
+            memory_map_->addMapping(start, flat_end, flat_memory_,
+                                    start /* Offset into the flat memory */);
+            dram_ranges_.push_back({start, flat_end, flat_memory_->getHostPointer(start), nullptr});
+            start = flat_end;
+            if (start == end)
+            {
+                return;
+            }
+        }
+
+        const uint32_t illop = 0;
+        MemObj* mem_obj = nullptr;
+        BMIfNode* memory_if = nullptr;
+        memory_objects_.emplace_back(
+            mem_obj = new MemObj(sys_node, PEGASUS_SYSTEM_BLOCK_SIZE, end - start, illop,
+                                 sizeof(illop)));
         tree_nodes_.emplace_back(
             memory_if =
                 new BMOIfNode(sys_node, "mb_" + std::to_string(block_num),
                               sparta::TreeNode::GROUP_NAME_NONE, sparta::TreeNode::GROUP_IDX_NONE,
                               "mb_" + std::to_string(block_num), nullptr, *mem_obj));
-        memory_map_->addMapping(addr_block_start, PEGASUS_SYSTEM_TOTAL_MEMORY, memory_if,
-                                0x0 /* Additional offset */);
-        memory_map_->dumpMappings(std::cout);
+        memory_map_->addMapping(start, end, memory_if, 0x0 /* Additional offset */);
+        dram_ranges_.push_back({start, end, nullptr, mem_obj});
     }
 
     void PegasusSystem::initMemoryWithElf_(const std::string & workload)
@@ -347,12 +371,151 @@ namespace pegasus
                 {
                     std::cout << "FAILED!\n";
                 }
+                loaded_segments_.emplace_back(segment->get_physical_address(),
+                                              segment->get_file_size());
+            }
+        }
+    }
+
+    uint8_t* PegasusSystem::getHostBlock(const Addr paddr)
+    {
+        for (const DramRange & range : dram_ranges_)
+        {
+            if ((paddr >= range.start) && (paddr < range.end))
+            {
+                // DRAM ranges start on a block boundary, so each block is one MemoryObject line
+                const sparta::memory::addr_t offset =
+                    (paddr - range.start) & ~(PEGASUS_SYSTEM_BLOCK_SIZE - 1);
+                if (range.host != nullptr)
+                {
+                    return range.host + offset;
+                }
+                return range.mem_obj->getLine(offset).getRawDataPtr(0);
             }
         }
+        return nullptr;
+    }
+
+    void PegasusSystem::saveSnapshot(std::ostream & os)
+    {
+        // Snapshots rely on the flat memory to find the populated pages and map them back in
+        sparta_assert(flat_memory_ != nullptr,
+                      "Snapshots require top.system.params.enable_flat_memory");
+
+        const std::vector<FlatMemory::Range> ranges = flat_memory_->getPopulatedRanges();
+        snapshot::write<uint64_t>(os, ranges.size());
+        for (const auto & [offset, size] : ranges)
+        {
+            snapshot::write<uint64_t>(os, offset);
+            snapshot::write<uint64_t>(os, size);
+        }
+
+        const std::streamoff pos = os.tellp();
+        const std::streamoff data_pos = (pos + FlatMemory::HOST_PAGE_SIZE - 1)
+                                        & ~std::streamoff(FlatMemory::HOST_PAGE_SIZE - 1);
+        os.write(std::vector<char>(data_pos - pos, 0).data(), data_pos - pos);
+        for (const auto & [offset, size] : ranges)
+        {
+            os.write(reinterpret_cast<const char*>(flat_memory_->getHostPointer(offset)), size);
+        }
+    }
+
+    void PegasusSystem::restoreSnapshot(std::istream & is, const std::string & filename)
+    {
+        sparta_assert(flat_memory_ != nullptr,
+                      "Snapshots require top.system.params.enable_flat_memory");
+
+        std::vector<FlatMemory::Range> ranges(snapshot::read<uint64_t>(is));
+        for (auto & [offset, size] : ranges)
+        {
+            offset = snapshot::read<uint64_t>(is);
+            size = snapshot::read<uint64_t>(is);
+        }
+
+        const std::streamoff pos = is.tellg();
+        std::streamoff data_pos = (pos + FlatMemory::HOST_PAGE_SIZE - 1)
+                                  & ~std::streamoff(FlatMemory::HOST_PAGE_SIZE - 1);
+
+        // Drop the ELF contents and anything else loaded while the tree was built, then map the
+        // snapshot pages. The mappings keep the file referenced after it is closed.
+        flat_memory_->clear();
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        sparta_assert(fd >= 0, "Failed to open snapshot " << filename);
+        for (const auto & [offset, size] : ranges)
+        {
+            flat_memory_->mapFile(fd, data_pos, offset, size);
+            data_pos += size;
+        }
+        ::close(fd);
+        std::cout << "Restored " << std::dec << ranges.size() << " memory ranges from snapshot "
+                  << filename << std::endl;
+    }
+
+    bool PegasusSystem::reloadWorkloads(
+        const PegasusSimParameters::WorkloadsAndArgs & workloads_and_args)
+    {
+        const sparta::utils::ValidValue<Addr> built_tohost_addr = tohost_addr_;
+        const sparta::utils::ValidValue<Addr> built_fromhost_addr = fromhost_addr_;
+
+        workloads_and_args_ = workloads_and_args;
+        symbols_.clear();
+        starting_pc_.clearValid();
+        tohost_addr_.clearValid();
+        fromhost_addr_.clearValid();
+        pass_addr_.clearValid();
+        fail_addr_.clearValid();
+        for (auto & wkld_and_args : workloads_and_args_)
+        {
+            loadWorkload_(wkld_and_args.at(0));
+        }
+
+        auto same_addr = [](const sparta::utils::ValidValue<Addr> & lhs,
+                            const sparta::utils::ValidValue<Addr> & rhs)
+        {
+            return (lhs.isValid() == rhs.isValid())
+                   && (!lhs.isValid() || (lhs.getValue() == rhs.getValue()));
+        };
+        if (!same_addr(tohost_addr_, built_tohost_addr)
+            || !same_addr(fromhost_addr_, built_fromhost_addr))
+        {
+            return false;
+        }
+
+        if (starting_pc_.isValid())
+        {
+            std::cout << "Starting PC: 0x" << std::hex << starting_pc_ << std::endl;
+        }
+
+        // Drop the previous ELF contents. The flat memory also drops the program stack, the harts
+        // write their new stack when they reload.
+        if (flat_memory_ != nullptr)
+        {
+            flat_memory_->clear();
+        }
+        for (const auto & [paddr, size] : loaded_segments_)
+        {
+            if ((flat_memory_ == nullptr) || ((paddr + size) > flat_memory_size_))
+            {
+                const std::vector<uint8_t> fill(size, PEGASUS_MEMORY_FILL);
+                memory_map_->tryPoke(paddr, size, fill.data());
+            }
+        }
+        loaded_segments_.clear();
+
+        for (auto & wkld_and_args : workloads_and_args_)
+        {
+            initMemoryWithElf_(wkld_and_args.at(0));
+        }
+        return true;
     }
 
     void PegasusSystem::registerMemoryCallbacks(Observer* observer)
     {
+        if (observer->hasMemoryCallbacks())
+        {
+            has_memory_observers_ = true;
+        }
+
         using BMOIfNode = sparta::memory::BlockingMemoryIFNode;
         for (const auto & n : tree_nodes_)
         {
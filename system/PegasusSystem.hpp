@@ -6,6 +6,8 @@
 #include "sim/PegasusSimParameters.hpp"
 #include "system/SimpleUART.hpp"
 #include "system/MagicMemory.hpp"
+#include "system/FlatMemory.hpp"
+#include "system/ReservationTable.hpp"
 
 #include "sparta/simulation/Unit.hpp"
 #include "sparta/simulation/ParameterSet.hpp"
@@ -13,6 +15,10 @@
 #include "sparta/simulation/ResourceTreeNode.hpp"
 #include "sparta/simulation/ResourceFactory.hpp"
 
+#include <istream>
+#include <mutex>
+#include <ostream>
+
 namespace sparta::memory
 {
     class MemoryObject;
@@ -37,6 +43,11 @@ namespace pegasus
             PegasusSystemParameters(sparta::TreeNode* node) : sparta::ParameterSet(node) {}
 
             PARAMETER(bool, enable_uart, false, "Enable a Uart")
+            PARAMETER(bool, enable_flat_memory, false,
+                      "Back DRAM with a single mmap'd host region instead of sparse MemoryObjects")
+            PARAMETER(uint64_t, flat_memory_size, 0x400000000,
+                      "Size of the flat DRAM region starting at address 0 (the rest of the "
+                      "physical address space is still backed by MemoryObjects)")
         };
 
         // Constructor
@@ -48,6 +59,41 @@ namespace pegasus
         // Give observers their callbacks to read/write memory operations
         void registerMemoryCallbacks(Observer* observer);
 
+        // Have any observers registered callbacks for memory reads/writes?
+        bool hasMemoryObservers() const { return has_memory_observers_; }
+
+        // Host pointer to the start of the DRAM block (PEGASUS_SYSTEM_BLOCK_SIZE) containing
+        // paddr. Returns nullptr if paddr is not backed by plain memory (MagicMemory, UART).
+        uint8_t* getHostBlock(const Addr paddr);
+
+        // LR/SC reservations of every hart in the system
+        ReservationTable* getReservationTable() { return &reservation_table_; }
+
+        // The cores are about to run on parallel host threads (enable_parallel_cores)
+        void enableParallelExecution() { parallel_execution_ = true; }
+
+        // Serialize accesses to shared system state (sparta memory objects, devices, AMOs and
+        // the system call emulator) between cores running on parallel host threads. Does not
+        // lock when the cores run on the sparta scheduler.
+        std::unique_lock<std::recursive_mutex> lockMemory()
+        {
+            return parallel_execution_ ? std::unique_lock(memory_mutex_)
+                                       : std::unique_lock<std::recursive_mutex>();
+        }
+
+        // Save DRAM contents for a snapshot. Must be the last section of the snapshot file, the
+        // pages are stored page aligned so they can be mapped back in.
+        void saveSnapshot(std::ostream & os);
+
+        // Restore DRAM contents by mapping the pages of the snapshot file copy-on-write
+        void restoreSnapshot(std::istream & is, const std::string & filename);
+
+        // Replace the workloads of a system that has not run yet: drop the ELF contents loaded
+        // while the tree was built and load the new ones. Returns false if the new workloads
+        // need a different memory map (magic memory), which cannot change after the tree is
+        // built.
+        bool reloadWorkloads(const PegasusSimParameters::WorkloadsAndArgs & workloads_and_args);
+
         // Get starting PC from ELF
         Addr getStartingPc() const { return starting_pc_.isValid() ? starting_pc_.getValue() : 0; }
 
@@ -83,6 +129,30 @@ namespace pegasus
         std::unique_ptr<sparta::memory::SimpleMemoryMapNode> memory_map_;
         std::vector<std::unique_ptr<sparta::memory::MemoryObject>> memory_objects_;
 
+        // Flat DRAM backend (enable_flat_memory)
+        const bool enable_flat_memory_;
+        const sparta::memory::addr_t flat_memory_size_;
+        FlatMemory* flat_memory_ = nullptr;
+
+        // Physical address ranges backed by plain memory. Backed either by the flat memory (host
+        // pointer to the start of the range) or by a memory object.
+        struct DramRange
+        {
+            sparta::memory::addr_t start = 0;
+            sparta::memory::addr_t end = 0;
+            uint8_t* host = nullptr;
+            sparta::memory::MemoryObject* mem_obj = nullptr;
+        };
+
+        std::vector<DramRange> dram_ranges_;
+
+        bool has_memory_observers_ = false;
+
+        ReservationTable reservation_table_;
+
+        bool parallel_execution_ = false;
+        std::recursive_mutex memory_mutex_;
+
         struct MemorySection
         {
             std::string name = "?";
@@ -109,11 +179,16 @@ namespace pegasus
         sparta::utils::ValidValue<MemorySection> magic_memory_section_;
 
         void createMemoryMappings_(sparta::TreeNode* sys_node);
+        void addDramMapping_(sparta::TreeNode* sys_node, sparta::memory::addr_t start,
+                             sparta::memory::addr_t end, uint32_t block_num);
 
         // Workload and workload arguments
-        const PegasusSimParameters::WorkloadsAndArgs workloads_and_args_;
+        PegasusSimParameters::WorkloadsAndArgs workloads_and_args_;
         void loadWorkload_(const std::string & workload);
         void initMemoryWithElf_(const std::string & workload);
+
+        // Physical address and size of every ELF segment written to memory
+        std::vector<std::pair<Addr, Addr>> loaded_segments_;
         ELFIO::elfio elf_reader_;
         sparta::utils::ValidValue<Addr> starting_pc_;
         std::unordered_map<Addr, std::string> symbols_;
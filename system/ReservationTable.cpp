@@ -0,0 +1,54 @@
+#include "system/ReservationTable.hpp"
+
+#include <bit>
+
+namespace pegasus
+{
+    void ReservationTable::makeReservation(const uint32_t hart_idx, const Addr paddr)
+    {
+        const uint64_t hart_mask = 1ull << hart_idx;
+        const uint32_t bucket = getBucket_(paddr);
+
+        // Publish the bucket bit before the reservation so a store to the line cannot miss it
+        buckets_[bucket].fetch_or(hart_mask, std::memory_order_acq_rel);
+        const Addr old_paddr = slots_[hart_idx].paddr.exchange(paddr, std::memory_order_acq_rel);
+
+        if ((old_paddr != NONE) && (getBucket_(old_paddr) != bucket))
+        {
+            buckets_[getBucket_(old_paddr)].fetch_and(~hart_mask, std::memory_order_release);
+        }
+
+        // Order the reservation before the LR's load of memory. Paired with the fence in
+        // invalidate, a store to the line either is seen by the load or sees the bucket bit.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    bool ReservationTable::consumeReservation(const uint32_t hart_idx, const Addr paddr)
+    {
+        const Addr old_paddr = slots_[hart_idx].paddr.exchange(NONE, std::memory_order_acq_rel);
+        if (old_paddr != NONE)
+        {
+            buckets_[getBucket_(old_paddr)].fetch_and(~(1ull << hart_idx),
+                                                      std::memory_order_release);
+        }
+        return (old_paddr != NONE) && (old_paddr == paddr);
+    }
+
+    void ReservationTable::invalidateLine_(uint64_t harts, const Addr line)
+    {
+        while (harts != 0)
+        {
+            const uint32_t other_hart_idx = std::countr_zero(harts);
+            harts &= harts - 1;
+
+            // Only clear the reservation if it is still on this line, the hart may have moved on
+            Slot & slot = slots_[other_hart_idx];
+            Addr reserved_paddr = slot.paddr.load(std::memory_order_acquire);
+            if ((reserved_paddr != NONE) && ((reserved_paddr / LINE_SIZE) == line))
+            {
+                slot.paddr.compare_exchange_strong(reserved_paddr, NONE,
+                                                   std::memory_order_acq_rel);
+            }
+        }
+    }
+} // namespace pegasus
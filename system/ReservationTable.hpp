@@ -0,0 +1,121 @@
+#pragma once
+
+#include "include/PegasusTypes.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+#include "sparta/utils/ValidValue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+
+namespace pegasus
+{
+    /*!
+     * \class ReservationTable
+     * \brief System-wide LR/SC reservation directory
+     *
+     * Every hart in the system has one reservation slot holding the physical address of its last
+     * LR. Reservations are tracked at cache line granularity: a store from any hart to a reserved
+     * line invalidates the other harts' reservations on that line. To keep stores cheap, each
+     * line hashes to a bucket with a mask of the harts that may hold a reservation in it, so a
+     * store to a line nobody reserved costs one atomic load.
+     *
+     * All table operations are lock-free, SCs are serialized by the caller. A hart's bucket bits
+     * are only ever set or cleared by the hart itself, other harts only clear its slot, so a
+     * bucket bit may be stale (set for a slot that has already been invalidated) but never
+     * missing.
+     *
+     * An LR publishes its reservation and then loads memory, a store writes memory and then
+     * looks for reservations. Both sides have a seq_cst fence between the two steps, so either
+     * the LR sees the stored data or the store sees the reservation and invalidates it.
+     */
+    class ReservationTable
+    {
+      public:
+        using Reservation = sparta::utils::ValidValue<Addr>;
+
+        static constexpr uint32_t MAX_HARTS = 64;
+        static constexpr Addr LINE_SIZE = 64;
+
+        // Allocate a slot for a hart. Not thread safe, called while the tree is built.
+        uint32_t addHart()
+        {
+            sparta_assert(num_harts_ < MAX_HARTS,
+                          "The reservation table supports at most " << MAX_HARTS << " harts");
+            return num_harts_++;
+        }
+
+        // LR: replace the hart's reservation. Must be called before memory is read.
+        void makeReservation(const uint32_t hart_idx, const Addr paddr);
+
+        // SC: take the hart's reservation. Returns true if it was still valid for paddr. The
+        // caller must serialize SCs with each other until the SC's store has invalidated the
+        // other harts (PegasusSystem::lockMemory), otherwise two harts could both succeed.
+        bool consumeReservation(const uint32_t hart_idx, const Addr paddr);
+
+        void clearReservation(const uint32_t hart_idx) { consumeReservation(hart_idx, NONE); }
+
+        Reservation getReservation(const uint32_t hart_idx) const
+        {
+            Reservation reservation;
+            if (const Addr paddr = slots_[hart_idx].paddr.load(std::memory_order_acquire);
+                paddr != NONE)
+            {
+                reservation = paddr;
+            }
+            return reservation;
+        }
+
+        void setReservation(const uint32_t hart_idx, const Reservation & reservation)
+        {
+            if (reservation.isValid())
+            {
+                makeReservation(hart_idx, reservation.getValue());
+            }
+            else
+            {
+                clearReservation(hart_idx);
+            }
+        }
+
+        // A hart stored to [paddr, paddr + size), invalidate the other harts' reservations. Must
+        // be called after the data has been written.
+        void invalidate(const uint32_t hart_idx, const Addr paddr, const size_t size)
+        {
+            // Order the data store before the bucket loads (see makeReservation)
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            const Addr first_line = paddr / LINE_SIZE;
+            const Addr last_line = (paddr + size - 1) / LINE_SIZE;
+            for (Addr line = first_line; line <= last_line; ++line)
+            {
+                const uint64_t harts = buckets_[line % NUM_BUCKETS].load(std::memory_order_acquire)
+                                       & ~(1ull << hart_idx);
+                if (SPARTA_EXPECT_FALSE(harts != 0))
+                {
+                    invalidateLine_(harts, line);
+                }
+            }
+        }
+
+      private:
+        static constexpr Addr NONE = ~Addr(0);
+        static constexpr uint32_t NUM_BUCKETS = 1024;
+
+        // Slots are written by their hart and by harts on other host threads, keep them on
+        // separate cache lines
+        struct alignas(LINE_SIZE) Slot
+        {
+            std::atomic<Addr> paddr{NONE};
+        };
+
+        std::array<Slot, MAX_HARTS> slots_;
+        std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{};
+        uint32_t num_harts_ = 0;
+
+        static uint32_t getBucket_(const Addr paddr) { return (paddr / LINE_SIZE) % NUM_BUCKETS; }
+
+        void invalidateLine_(uint64_t harts, const Addr line);
+    };
+} // namespace pegasus
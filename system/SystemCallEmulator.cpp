@@ -1,10 +1,15 @@
 
 #include <vector>
+#include <list>
+#include <map>
 #include <unordered_map>
 #include <algorithm>
 
 #include "system/SystemCallEmulator.hpp"
 #include "sim/PegasusSim.hpp"
+#include "core/PegasusCore.hpp"
+#include "core/PegasusState.hpp"
+#include "include/PegasusSnapshot.hpp"
 #include "sparta/utils/LogUtils.hpp"
 
 #include <unistd.h>      // for write, etc
@@ -12,11 +17,14 @@
 #include <sys/uio.h>     // for writev
 #include <sys/utsname.h> // for uname
 #include <string.h>
+#include <limits.h> // PATH_MAX
 #include <sys/time.h> // get time of day
 #include <sys/mman.h> // mmap
 #include <sys/types.h>
 #include <sys/stat.h> //fstat, etc
 #include <sys/syscall.h>
+#include <sched.h>       // CLONE_* flags
+#include <linux/futex.h> // FUTEX_* operations
 
 #define SYSCALL_LOG(x)                                                                             \
     if (SPARTA_EXPECT_FALSE(syscall_log_))                                                         \
@@ -76,8 +84,10 @@ namespace pegasus
                  {178, {"getegid", cfp(&SysCallHandlers::getegid_)}},
                  {214, {"brk", cfp(&SysCallHandlers::brk_)}},
                  {215, {"munmap", cfp(&SysCallHandlers::munmap_)}},
+                 {220, {"clone", cfp(&SysCallHandlers::clone_)}},
                  {222, {"mmap", cfp(&SysCallHandlers::mmap_)}},
                  {226, {"mprotect", cfp(&SysCallHandlers::mprotect_)}},
+                 {233, {"madvise", cfp(&SysCallHandlers::madvise_)}},
                  {258, {"hwprobe", cfp(&SysCallHandlers::hwprobe_)}},
                  {261, {"prlimit", cfp(&SysCallHandlers::prlimit_)}},
                  {278, {"getrandom", cfp(&SysCallHandlers::getrandom_)}},
@@ -86,7 +96,7 @@ namespace pegasus
                   {"clock_gettime",
                    cfp(&SysCallHandlers::clock_gettime_)}}, // sc_call_id = 403 is for
                                                             // "clock_gettime64".
-                 {435, {"clone", cfp(&SysCallHandlers::clone_)}},
+                 {435, {"clone3", cfp(&SysCallHandlers::clone3_)}},
                  {1024, {"open", cfp(&SysCallHandlers::open_)}},
                  {1039, {"lstat", cfp(&SysCallHandlers::lstat_)}},
                  {2011, {"getmainvars", cfp(&SysCallHandlers::getmainvars_)}}});
@@ -137,11 +147,12 @@ namespace pegasus
             uint32_t stx_atomic_write_unit_max_opt;
         };
 
-        int64_t emulateSystemCall(const SystemCallStack & call_stack,
+        int64_t emulateSystemCall(PegasusState* state, const SystemCallStack & call_stack,
                                   sparta::memory::BlockingMemoryIF* memory)
         {
             int64_t ret_val = -1;
             const auto sc_call_id = call_stack[0];
+            current_state_ = state;
             try
             {
                 const auto & syscall = supported_sys_calls_.at(sc_call_id);
@@ -151,6 +162,7 @@ namespace pegasus
             {
                 sparta_assert(false, "System call #" << sc_call_id << " is not known");
             }
+            current_state_ = nullptr;
             return ret_val;
         }
 
@@ -160,6 +172,9 @@ namespace pegasus
 
         Addr getBreakAddress() const { return brk_address_; }
 
+        void saveSnapshot(std::ostream & os);
+        void restoreSnapshot(std::istream & is);
+
       private:
         // Helpers
         std::string readString_(sparta::memory::BlockingMemoryIF* mem, uint64_t string_addr,
@@ -220,6 +235,41 @@ namespace pegasus
         // Convert Linux ret to errno value for internal system calls
         int sysretErrno_(int ret) const { return (ret == -1) ? -errno : ret; }
 
+        // Remember a file opened by the workload so it can be reopened from a snapshot
+        void trackOpenFile_(int fd, int flags);
+
+        // Threads created with clone are run on idle harts
+        struct ThreadInfo
+        {
+            int64_t tid = 0;
+            HartId hart_idx = 0;
+            // Written with 0 and woken on exit (CLONE_CHILD_CLEARTID, set_tid_address)
+            Addr clear_child_tid = 0;
+            // The futex the thread is queued on, 0 if none
+            Addr futex_uaddr = 0;
+        };
+
+        // Get the calling thread, the first hart to make a thread system call is the main thread
+        ThreadInfo & getThread_(PegasusState* state);
+
+        // Find an idle hart for a new thread. Harts of other cores are only used when the cores
+        // run on the same host thread.
+        PegasusState* findIdleHart_(PegasusState* parent, HartId & hart_idx) const;
+
+        template <typename XLEN> void copyHartState_(PegasusState* parent, PegasusState* child);
+
+        // Start a thread on an idle hart, the common part of clone and clone3
+        int64_t cloneThread_(uint64_t flags, Addr stack, Addr parent_tid, Addr tls,
+                             Addr child_tid, sparta::memory::BlockingMemoryIF* memory);
+
+        // Move the thread off the futex queue it was left on (woken by a timeout)
+        void dequeueFutex_(PegasusState* state, ThreadInfo & thread);
+
+        // Wake up to max_wake threads waiting on uaddr whose bitset matches, requeue up to
+        // max_requeue of the others on requeue_uaddr
+        int64_t futexWake_(Addr uaddr, uint32_t bitset, uint64_t max_wake,
+                           Addr requeue_uaddr = 0, uint64_t max_requeue = 0);
+
         // The system calls
         int64_t getcwd_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t dup_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
@@ -258,11 +308,13 @@ namespace pegasus
         int64_t mmap_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t munmap_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t mprotect_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
+        int64_t madvise_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t hwprobe_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t prlimit_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t getrandom_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t statx_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t clone_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
+        int64_t clone3_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t open_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t lstat_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
         int64_t getmainvars_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*);
@@ -312,6 +364,29 @@ namespace pegasus
                 return ret_addr;
             }
 
+            void saveSnapshot(std::ostream & os) const
+            {
+                snapshot::write<uint64_t>(os, next_block_addr_);
+                snapshot::write<uint64_t>(os, guest_to_host_mapping_.size());
+                for (const auto & [guest_addr, host_addr] : guest_to_host_mapping_)
+                {
+                    snapshot::write<uint64_t>(os, guest_addr);
+                    snapshot::write<uint64_t>(os, host_addr);
+                }
+            }
+
+            void restoreSnapshot(std::istream & is)
+            {
+                next_block_addr_ = snapshot::read<uint64_t>(is);
+                guest_to_host_mapping_.clear();
+                const uint64_t num_mappings = snapshot::read<uint64_t>(is);
+                for (uint64_t i = 0; i < num_mappings; ++i)
+                {
+                    const uint64_t guest_addr = snapshot::read<uint64_t>(is);
+                    guest_to_host_mapping_[guest_addr] = snapshot::read<uint64_t>(is);
+                }
+            }
+
             // Return the host address
             uint64_t deallocate(uint64_t guest_addr, uint64_t)
             {
@@ -344,6 +419,31 @@ namespace pegasus
         // For a program, if the `brk` system call is made, the
         // program is asking to extend the data segment
         Addr brk_address_ = 0;
+
+        // The hart making the current system call
+        PegasusState* current_state_ = nullptr;
+
+        // Threads of the workload by hart and the next TID to hand out
+        std::unordered_map<const PegasusState*, ThreadInfo> threads_;
+        int64_t next_tid_ = 0;
+
+        // Threads parked on a futex, by address
+        struct FutexWaiter
+        {
+            PegasusState* state;
+            uint32_t bitset;
+        };
+
+        std::unordered_map<Addr, std::list<FutexWaiter>> futex_queues_;
+
+        // Files opened by the workload: the host path and the open flags, by fd
+        struct OpenFile
+        {
+            std::string path;
+            int flags;
+        };
+
+        std::map<int, OpenFile> open_files_;
     };
 
     const std::string getWorkloadParam(sparta::TreeNode* rtn)
@@ -407,7 +507,18 @@ namespace pegasus
         }
     }
 
-    void SystemCallEmulator::onBindTreeLate_()
+    void SystemCallEmulator::onBindTreeLate_() { initBreakAddress_(); }
+
+    void SystemCallEmulator::reloadWorkload()
+    {
+        const auto & workloads_and_args = sim_->getPegasusSystem()->getWorkloadsAndArgs();
+        workload_ = workloads_and_args.empty() ? "" : workloads_and_args.at(0).at(0);
+        callbacks_->setWorkload(workload_);
+        callbacks_->setBreakAddress(0);
+        initBreakAddress_();
+    }
+
+    void SystemCallEmulator::initBreakAddress_()
     {
         if (syscall_emulation_enabled_)
         {
@@ -425,10 +536,329 @@ namespace pegasus
         }
     }
 
-    int64_t SystemCallEmulator::emulateSystemCall(const SystemCallStack & call_stack,
+    int64_t SystemCallEmulator::emulateSystemCall(PegasusState* state,
+                                                  const SystemCallStack & call_stack,
                                                   sparta::memory::BlockingMemoryIF* memory)
     {
-        return callbacks_->emulateSystemCall(call_stack, memory);
+        return callbacks_->emulateSystemCall(state, call_stack, memory);
+    }
+
+    void SystemCallEmulator::saveSnapshot(std::ostream & os) { callbacks_->saveSnapshot(os); }
+
+    void SystemCallEmulator::restoreSnapshot(std::istream & is) { callbacks_->restoreSnapshot(is); }
+
+    void SysCallHandlers::saveSnapshot(std::ostream & os)
+    {
+        snapshot::write<Addr>(os, brk_address_);
+        memory_map_manager_.saveSnapshot(os);
+
+        // Threads waiting on a futex are restored running, which the workload sees as a spurious
+        // wakeup
+        snapshot::write<int64_t>(os, next_tid_);
+        snapshot::write<uint64_t>(os, threads_.size());
+        for (const auto & [state, thread] : threads_)
+        {
+            snapshot::write<CoreId>(os, state->getCore()->getCoreId());
+            snapshot::write<HartId>(os, thread.hart_idx);
+            snapshot::write<int64_t>(os, thread.tid);
+            snapshot::write<Addr>(os, thread.clear_child_tid);
+        }
+
+        // Files are reopened by path at the same offset, they must still exist when the snapshot
+        // is restored
+        snapshot::write<uint64_t>(os, open_files_.size());
+        for (const auto & [fd, open_file] : open_files_)
+        {
+            snapshot::write<int>(os, fd);
+            snapshot::write<int>(os, open_file.flags);
+            snapshot::write<int64_t>(os, ::lseek(fd, 0, SEEK_CUR));
+            snapshot::writeString(os, open_file.path);
+        }
+    }
+
+    void SysCallHandlers::restoreSnapshot(std::istream & is)
+    {
+        brk_address_ = snapshot::read<Addr>(is);
+        memory_map_manager_.restoreSnapshot(is);
+
+        threads_.clear();
+        futex_queues_.clear();
+        next_tid_ = snapshot::read<int64_t>(is);
+        const uint64_t num_threads = snapshot::read<uint64_t>(is);
+        for (uint64_t i = 0; i < num_threads; ++i)
+        {
+            const CoreId core_id = snapshot::read<CoreId>(is);
+            const HartId hart_idx = snapshot::read<HartId>(is);
+            PegasusState* state =
+                emulator_->getPegasusSim()->getPegasusCore(core_id)->getPegasusState(hart_idx);
+            ThreadInfo & thread = threads_[state];
+            thread.hart_idx = hart_idx;
+            thread.tid = snapshot::read<int64_t>(is);
+            thread.clear_child_tid = snapshot::read<Addr>(is);
+        }
+
+        const uint64_t num_open_files = snapshot::read<uint64_t>(is);
+        for (uint64_t i = 0; i < num_open_files; ++i)
+        {
+            const int fd = snapshot::read<int>(is);
+            OpenFile open_file;
+            open_file.flags = snapshot::read<int>(is);
+            const int64_t offset = snapshot::read<int64_t>(is);
+            open_file.path = snapshot::readString(is);
+
+            int new_fd = ::open(open_file.path.c_str(), open_file.flags);
+            sparta_assert(new_fd >= 0, "Could not reopen '" << open_file.path << "' from snapshot: "
+                                                            << strerror(errno));
+            if (new_fd != fd)
+            {
+                sparta_assert(::dup2(new_fd, fd) == fd,
+                              "Could not move '" << open_file.path << "' to fd " << fd);
+                ::close(new_fd);
+            }
+            if (offset >= 0)
+            {
+                ::lseek(fd, offset, SEEK_SET);
+            }
+            open_files_[fd] = open_file;
+        }
+    }
+
+    void SysCallHandlers::trackOpenFile_(int fd, int flags)
+    {
+        if (fd < 0)
+        {
+            return;
+        }
+
+        // Resolve the path through procfs, it may have been relative to a directory fd
+        char path[PATH_MAX];
+        const std::string fd_link = "/proc/self/fd/" + std::to_string(fd);
+        const ssize_t len = ::readlink(fd_link.c_str(), path, sizeof(path) - 1);
+        if (len > 0)
+        {
+            // Reopening must not create or truncate the file again
+            open_files_[fd] = {std::string(path, len), flags & ~(O_CREAT | O_EXCL | O_TRUNC)};
+        }
+    }
+
+    SysCallHandlers::ThreadInfo & SysCallHandlers::getThread_(PegasusState* state)
+    {
+        if (auto it = threads_.find(state); it != threads_.end())
+        {
+            return it->second;
+        }
+
+        if (next_tid_ == 0)
+        {
+            next_tid_ = ::getpid();
+        }
+
+        ThreadInfo & thread = threads_[state];
+        thread.tid = next_tid_++;
+        for (const auto & [hart_idx, hart_state] : state->getCore()->getThreads())
+        {
+            if (hart_state == state)
+            {
+                thread.hart_idx = hart_idx;
+            }
+        }
+        return thread;
+    }
+
+    PegasusState* SysCallHandlers::findIdleHart_(PegasusState* parent, HartId & hart_idx) const
+    {
+        auto find_on_core = [&hart_idx](PegasusCore* core) -> PegasusState*
+        {
+            for (const auto & [idx, state] : core->getThreads())
+            {
+                if (core->isHartIdle(idx))
+                {
+                    hart_idx = idx;
+                    return state;
+                }
+            }
+            return nullptr;
+        };
+
+        PegasusCore* parent_core = parent->getCore();
+        if (PegasusState* state = find_on_core(parent_core))
+        {
+            return state;
+        }
+
+        // Other cores may be running on other host threads
+        if (!parent_core->isParallel())
+        {
+            const PegasusSim* sim = emulator_->getPegasusSim();
+            for (CoreId core_id = 0; core_id < sim->getNumCores(); ++core_id)
+            {
+                PegasusCore* core = sim->getPegasusCore(core_id);
+                if (core == parent_core)
+                {
+                    continue;
+                }
+                if (PegasusState* state = find_on_core(core))
+                {
+                    return state;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename XLEN>
+    void SysCallHandlers::copyHartState_(PegasusState* parent, PegasusState* child)
+    {
+        for (uint32_t reg = 1; reg < 32; ++reg)
+        {
+            WRITE_INT_REG<XLEN>(child, reg, READ_INT_REG<XLEN>(parent, reg));
+            WRITE_FP_REG<XLEN>(child, reg, READ_FP_REG<XLEN>(parent, reg));
+        }
+        WRITE_FP_REG<XLEN>(child, 0, READ_FP_REG<XLEN>(parent, 0));
+        WRITE_CSR_REG<XLEN>(child, MSTATUS, READ_CSR_REG<XLEN>(parent, MSTATUS));
+        WRITE_CSR_REG<XLEN>(child, FCSR, READ_CSR_REG<XLEN>(parent, FCSR));
+    }
+
+    int64_t SysCallHandlers::cloneThread_(uint64_t flags, Addr stack, Addr parent_tid, Addr tls,
+                                          Addr child_tid, sparta::memory::BlockingMemoryIF* memory)
+    {
+        // Only threads are supported, a new process would need its own address space
+        if ((flags & (CLONE_VM | CLONE_THREAD)) != (CLONE_VM | CLONE_THREAD))
+        {
+            return -ENOSYS;
+        }
+
+        // Make sure the parent is known so its exit does not end the simulation
+        PegasusState* parent = current_state_;
+        getThread_(parent);
+
+        HartId hart_idx = 0;
+        PegasusState* child = findIdleHart_(parent, hart_idx);
+        if (child == nullptr)
+        {
+            return -EAGAIN;
+        }
+
+        if (parent->getXlen() == 64)
+        {
+            copyHartState_<RV64>(parent, child);
+        }
+        else
+        {
+            copyHartState_<RV32>(parent, child);
+        }
+
+        // The child returns 0 from the ecall on its own stack
+        const uint32_t sp = 2, tp = 4, a0 = 10;
+        auto write_reg = [child](uint32_t reg, uint64_t value)
+        {
+            if (child->getXlen() == 64)
+            {
+                WRITE_INT_REG<RV64>(child, reg, value);
+            }
+            else
+            {
+                WRITE_INT_REG<RV32>(child, reg, value);
+            }
+        };
+        if (stack != 0)
+        {
+            write_reg(sp, stack);
+        }
+        if (flags & CLONE_SETTLS)
+        {
+            write_reg(tp, tls);
+        }
+        write_reg(a0, 0);
+        child->setPc(parent->getPc() + 4);
+        child->setPrivMode(parent->getPrivMode(), parent->getVirtualMode());
+
+        // Replace whatever thread ran on the hart before
+        threads_.erase(child);
+        ThreadInfo & thread = getThread_(child);
+
+        const int32_t tid = thread.tid;
+        if (flags & CLONE_PARENT_SETTID)
+        {
+            memory->poke(parent_tid, sizeof(tid), reinterpret_cast<const uint8_t*>(&tid));
+        }
+        if (flags & CLONE_CHILD_SETTID)
+        {
+            memory->poke(child_tid, sizeof(tid), reinterpret_cast<const uint8_t*>(&tid));
+        }
+        if (flags & CLONE_CHILD_CLEARTID)
+        {
+            thread.clear_child_tid = child_tid;
+        }
+
+        child->getCore()->startHart(hart_idx);
+        return tid;
+    }
+
+    void SysCallHandlers::dequeueFutex_(PegasusState* state, ThreadInfo & thread)
+    {
+        if (thread.futex_uaddr != 0)
+        {
+            futex_queues_[thread.futex_uaddr].remove_if([state](const FutexWaiter & waiter)
+                                                        { return waiter.state == state; });
+            thread.futex_uaddr = 0;
+        }
+    }
+
+    int64_t SysCallHandlers::futexWake_(Addr uaddr, uint32_t bitset, uint64_t max_wake,
+                                        Addr requeue_uaddr, uint64_t max_requeue)
+    {
+        auto queue_it = futex_queues_.find(uaddr);
+        if (queue_it == futex_queues_.end())
+        {
+            return 0;
+        }
+
+        int64_t num_woken = 0;
+        uint64_t num_requeued = 0;
+        std::list<FutexWaiter> & queue = queue_it->second;
+        for (auto it = queue.begin(); it != queue.end();)
+        {
+            if ((it->bitset & bitset) == 0)
+            {
+                ++it;
+                continue;
+            }
+
+            ThreadInfo & thread = threads_.at(it->state);
+            if (num_woken < static_cast<int64_t>(max_wake))
+            {
+                // A timed wait may already have given up. The waiter returned -ETIMEDOUT from
+                // its ecall, being woken makes it return 0.
+                if (it->state->getCore()->wakeHart(thread.hart_idx))
+                {
+                    const uint32_t a0 = 10;
+                    if (it->state->getXlen() == 64)
+                    {
+                        WRITE_INT_REG<RV64>(it->state, a0, 0);
+                    }
+                    else
+                    {
+                        WRITE_INT_REG<RV32>(it->state, a0, 0);
+                    }
+                    ++num_woken;
+                }
+                thread.futex_uaddr = 0;
+                it = queue.erase(it);
+            }
+            else if (num_requeued < max_requeue)
+            {
+                thread.futex_uaddr = requeue_uaddr;
+                futex_queues_[requeue_uaddr].emplace_back(*it);
+                ++num_requeued;
+                it = queue.erase(it);
+            }
+            else
+            {
+                break;
+            }
+        }
+        return num_woken + num_requeued;
     }
 
     int SystemCallEmulator::getFDOverrideForWrite(int caller_fd)
@@ -470,7 +900,12 @@ namespace pegasus
     int64_t SysCallHandlers::dup_(const SystemCallStack & call_stack,
                                   sparta::memory::BlockingMemoryIF*)
     {
-        return ::dup(call_stack[1]);
+        const int ret = ::dup(call_stack[1]);
+        if (auto it = open_files_.find(call_stack[1]); (ret >= 0) && (it != open_files_.end()))
+        {
+            open_files_[ret] = it->second;
+        }
+        return ret;
     }
 
     int64_t SysCallHandlers::getuid_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*)
@@ -490,10 +925,9 @@ namespace pegasus
         return getuid_(call_stack, memory);
     }
 
-    int64_t SysCallHandlers::gettid_(const SystemCallStack & call_stack,
-                                     sparta::memory::BlockingMemoryIF* memory)
+    int64_t SysCallHandlers::gettid_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*)
     {
-        return getuid_(call_stack, memory);
+        return getThread_(current_state_).tid;
     }
 
     int64_t SysCallHandlers::getegid_(const SystemCallStack & call_stack,
@@ -569,6 +1003,13 @@ namespace pegasus
         return 0;
     }
 
+    // Used by glibc to release the stack of an exiting thread
+    int64_t SysCallHandlers::madvise_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*)
+    {
+        SYSCALL_LOG(__func__ << "(...) -> 0 # ignored");
+        return 0;
+    }
+
     int64_t SysCallHandlers::hwprobe_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*)
     {
         SYSCALL_LOG(__func__ << "(...) -> 0 # ignored");
@@ -651,6 +1092,7 @@ namespace pegasus
         const std::string pathname = readString_(mem, pathname_addr);
 
         auto ret = ::openat(dirfd, pathname.c_str(), flags, mode);
+        trackOpenFile_(ret, flags);
 
         return ret;
     }
@@ -660,6 +1102,10 @@ namespace pegasus
     {
         const auto fd = call_stack[1];
         auto ret = sysretErrno_(::close(fd));
+        if (ret == 0)
+        {
+            open_files_.erase(fd);
+        }
         return ret;
     }
 
@@ -938,17 +1384,91 @@ namespace pegasus
         return ret;
     }
 
-    int64_t SysCallHandlers::set_tid_address_(const SystemCallStack &,
+    int64_t SysCallHandlers::set_tid_address_(const SystemCallStack & call_stack,
                                               sparta::memory::BlockingMemoryIF*)
     {
-        SYSCALL_LOG(__func__ << "(...) -> 0 # ignored");
-        return 0;
+        ThreadInfo & thread = getThread_(current_state_);
+        thread.clear_child_tid = call_stack[1];
+        SYSCALL_LOG(__func__ << "(" << HEX16(call_stack[1]) << ") -> " << std::dec << thread.tid);
+        return thread.tid;
     }
 
-    int64_t SysCallHandlers::futex_(const SystemCallStack &, sparta::memory::BlockingMemoryIF*)
+    int64_t SysCallHandlers::futex_(const SystemCallStack & call_stack,
+                                    sparta::memory::BlockingMemoryIF* memory)
     {
-        SYSCALL_LOG(__func__ << "(...) -> 0 # ignored");
-        return 0;
+        const Addr uaddr = call_stack[1];
+        const int op = call_stack[2];
+        const uint32_t val = call_stack[3];
+        const uint64_t timeout_or_val2 = call_stack[4];
+        const Addr uaddr2 = call_stack[5];
+        const uint32_t val3 = call_stack[6];
+
+        // All harts share one address space, private and shared futexes are the same
+        const int cmd = op & ~(FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME);
+
+        auto read_futex = [memory](Addr addr)
+        {
+            uint32_t value = 0;
+            memory->peek(addr, sizeof(value), reinterpret_cast<uint8_t*>(&value));
+            return value;
+        };
+
+        int64_t ret = 0;
+        switch (cmd)
+        {
+            case FUTEX_WAIT:
+            case FUTEX_WAIT_BITSET:
+            {
+                const uint32_t bitset = (cmd == FUTEX_WAIT) ? FUTEX_BITSET_MATCH_ANY : val3;
+                if (bitset == 0)
+                {
+                    ret = -EINVAL;
+                    break;
+                }
+                if (read_futex(uaddr) != val)
+                {
+                    ret = -EAGAIN;
+                    break;
+                }
+
+                ThreadInfo & thread = getThread_(current_state_);
+                dequeueFutex_(current_state_, thread);
+                thread.futex_uaddr = uaddr;
+                futex_queues_[uaddr].emplace_back(FutexWaiter{current_state_, bitset});
+
+                // Park the hart instead of letting it spin. There is no notion of time here, a
+                // timed wait gives up when nothing else on the core can run (like WFI) and
+                // returns -ETIMEDOUT unless futexWake_ clears it.
+                const bool timed = (timeout_or_val2 != 0);
+                current_state_->pauseHart(timed ? SimPauseReason::WFI : SimPauseReason::FUTEX);
+                ret = timed ? -ETIMEDOUT : 0;
+                break;
+            }
+            case FUTEX_WAKE:
+                ret = futexWake_(uaddr, FUTEX_BITSET_MATCH_ANY, val);
+                break;
+            case FUTEX_WAKE_BITSET:
+                ret = (val3 == 0) ? -EINVAL : futexWake_(uaddr, val3, val);
+                break;
+            case FUTEX_CMP_REQUEUE:
+                if (read_futex(uaddr) != val3)
+                {
+                    ret = -EAGAIN;
+                    break;
+                }
+                [[fallthrough]];
+            case FUTEX_REQUEUE:
+                ret = futexWake_(uaddr, FUTEX_BITSET_MATCH_ANY, val, uaddr2, timeout_or_val2);
+                break;
+            default:
+                ret = -ENOSYS;
+                break;
+        }
+
+        SYSCALL_LOG(__func__ << "(" << HEX16(uaddr) << ", " << HEX16(op) << ", " << HEX16(val)
+                             << ", " << HEX16(timeout_or_val2) << ", " << HEX16(uaddr2) << ", "
+                             << HEX16(val3) << ") -> " << std::dec << ret);
+        return ret;
     }
 
     int64_t SysCallHandlers::set_robust_list_(const SystemCallStack &,
@@ -986,7 +1506,7 @@ namespace pegasus
     int64_t SysCallHandlers::tgkill_(const SystemCallStack & call_stack,
                                      sparta::memory::BlockingMemoryIF* mem)
     {
-        return exit_(call_stack, mem);
+        return exit_group_(call_stack, mem);
     }
 
     int64_t SysCallHandlers::rt_sigaction_(const SystemCallStack &,
@@ -1032,20 +1552,42 @@ namespace pegasus
     }
 
     int64_t SysCallHandlers::exit_(const SystemCallStack & call_stack,
-                                   sparta::memory::BlockingMemoryIF*)
+                                   sparta::memory::BlockingMemoryIF* memory)
     {
         const int64_t exit_code = call_stack[1];
         SYSCALL_LOG("exit(" << exit_code << ");");
-        emulator_->getPegasusSim()->endSimulation(exit_code);
+
+        // The last thread ends the simulation, otherwise only the calling hart stops
+        auto thread_it = threads_.find(current_state_);
+        if ((thread_it == threads_.end()) || (threads_.size() == 1))
+        {
+            emulator_->getPegasusSim()->endSimulation(exit_code);
+            return exit_code;
+        }
+
+        ThreadInfo & thread = thread_it->second;
+        dequeueFutex_(current_state_, thread);
+        if (thread.clear_child_tid != 0)
+        {
+            // Wakes up pthread_join
+            const int32_t zero = 0;
+            memory->poke(thread.clear_child_tid, sizeof(zero),
+                         reinterpret_cast<const uint8_t*>(&zero));
+            futexWake_(thread.clear_child_tid, FUTEX_BITSET_MATCH_ANY, 1);
+        }
+        threads_.erase(thread_it);
+
+        current_state_->stopSim(exit_code);
         return exit_code;
     }
 
     int64_t SysCallHandlers::exit_group_(const SystemCallStack & call_stack,
-                                         sparta::memory::BlockingMemoryIF* memory)
+                                         sparta::memory::BlockingMemoryIF*)
     {
         const int64_t exit_code = call_stack[1];
         SYSCALL_LOG("exit_group(" << exit_code << ");");
-        return exit_(call_stack, memory);
+        emulator_->getPegasusSim()->endSimulation(exit_code);
+        return exit_code;
     }
 
     int64_t SysCallHandlers::statx_(const SystemCallStack & call_stack,
@@ -1121,13 +1663,35 @@ namespace pegasus
     int64_t SysCallHandlers::clone_(const SystemCallStack & call_stack,
                                     sparta::memory::BlockingMemoryIF* memory)
     {
-        // Get clone args struct from memory
-        clone_args args;
+        // RISC-V argument order: flags, stack, parent_tid, tls, child_tid
+        const uint64_t flags = call_stack[1];
+        const Addr stack = call_stack[2];
+        const Addr parent_tid = call_stack[3];
+        const Addr tls = call_stack[4];
+        const Addr child_tid = call_stack[5];
+
+        const int64_t ret = cloneThread_(flags, stack, parent_tid, tls, child_tid, memory);
+        SYSCALL_LOG(__func__ << "(" << HEX16(flags) << ", " << HEX16(stack) << ", "
+                             << HEX16(parent_tid) << ", " << HEX16(tls) << ", " << HEX16(child_tid)
+                             << ") -> " << std::dec << ret);
+        return ret;
+    }
+
+    int64_t SysCallHandlers::clone3_(const SystemCallStack & call_stack,
+                                     sparta::memory::BlockingMemoryIF* memory)
+    {
+        // Get clone args struct from memory. Older callers pass a shorter struct, newer ones may
+        // pass fields we do not know about.
+        clone_args args = {};
         const uint64_t addr = call_stack[1];
         const size_t size = call_stack[2];
-        sparta_assert(sizeof(clone_args) == size,
-                      "Size of clone_args struct does not match size parameter!");
-        const bool success = memory->tryRead(addr, size, reinterpret_cast<uint8_t*>(&args));
+        constexpr size_t CLONE_ARGS_SIZE_VER0 = 64;
+        if (size < CLONE_ARGS_SIZE_VER0)
+        {
+            return -EINVAL;
+        }
+        const bool success = memory->tryRead(addr, std::min(size, sizeof(clone_args)),
+                                             reinterpret_cast<uint8_t*>(&args));
         sparta_assert(success);
 
         SYSCALL_LOG(__func__ << " clone_args: flags: 0x" << std::hex << args.flags);
@@ -1142,10 +1706,11 @@ namespace pegasus
         SYSCALL_LOG(__func__ << " clone_args: set_tid_size: 0x" << std::hex << args.set_tid_size);
         SYSCALL_LOG(__func__ << " clone_args: cgroup: 0x" << std::hex << args.cgroup);
 
-        // TODO: Boot up a new thread, set the thread/hart ID, pause the current thread, etc.
-
-        sparta_assert(false, __func__ << " returning -1, i.e. not implemented");
-        int64_t ret = -1;
+        // Unlike clone, the stack is given by its lowest address and size
+        const Addr stack = (args.stack != 0) ? (args.stack + args.stack_size) : 0;
+        const int64_t ret = cloneThread_(args.flags, stack, args.parent_tid, args.tls,
+                                         args.child_tid, memory);
+        SYSCALL_LOG(__func__ << "(...) -> " << std::dec << ret);
         return ret;
     }
 
@@ -1159,6 +1724,7 @@ namespace pegasus
         const std::string path = readString_(mem, path_addr);
 
         auto ret = ::open(path.c_str(), flags, mode);
+        trackOpenFile_(ret, flags);
         return ret;
     }
 
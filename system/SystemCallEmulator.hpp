@@ -2,6 +2,8 @@
 
 #include <array>
 #include <cinttypes>
+#include <istream>
+#include <ostream>
 
 #include "include/PegasusTypes.hpp"
 
@@ -15,6 +17,7 @@
 namespace pegasus
 {
     class PegasusSim;
+    class PegasusState;
     class SysCallHandlers;
 
     /**
@@ -60,13 +63,20 @@ namespace pegasus
         //! Destroy!
         ~SystemCallEmulator();
 
-        //! Handle a system call
-        int64_t emulateSystemCall(const SystemCallStack & call_stack,
+        //! Handle a system call made by the given hart
+        int64_t emulateSystemCall(PegasusState* state, const SystemCallStack & call_stack,
                                   sparta::memory::BlockingMemoryIF* memory);
 
         //! Handle exit call
         void exitCall(uint64_t exit_code);
 
+        //! Save/restore the emulated process state (break, mmap regions, threads, open files)
+        void saveSnapshot(std::ostream & os);
+        void restoreSnapshot(std::istream & is);
+
+        //! The system reloaded its workloads (batch mode), pick up the new workload and break
+        void reloadWorkload();
+
         //! Get the default write FD
         int getFDOverrideForWrite(int caller_fd);
 
@@ -79,6 +89,9 @@ namespace pegasus
       private:
         void onBindTreeLate_() override;
 
+        //! Start the program break at the _end symbol of the workload
+        void initBreakAddress_();
+
         // Is system call emulation enabled?
         const bool syscall_emulation_enabled_;
 
@@ -89,7 +102,7 @@ namespace pegasus
         int fd_for_write_ = DEFAULT_WRITE_FD;
         PegasusSim* sim_ = nullptr;
 
-        const std::string workload_;
+        std::string workload_;
 
         std::unique_ptr<SysCallHandlers> callbacks_;
     };
@@ -0,0 +1,94 @@
+#include "sim/PegasusSim.hpp"
+#include "core/PegasusState.hpp"
+#include "core/PegasusExtractor.hpp"
+#include "core/Fetch.hpp"
+
+#include "include/ActionTags.hpp"
+#include "include/PegasusTypes.hpp"
+
+#include "sparta/utils/SpartaTester.hpp"
+
+class PegasusExecuteTester
+{
+
+  public:
+    PegasusExecuteTester()
+    {
+        // Two harts with the default mhartid (0) on one core, only the second one is profiled
+        sparta::app::SimulationConfiguration config;
+        config.processParameter("top.core0.params.num_harts", "2");
+        config.processParameter("top.core0.hart1.params.enable_profiler", "true");
+
+        // Create the simulator
+        pegasus_sim_.reset(new pegasus::PegasusSim(&scheduler_));
+        pegasus_sim_->configure(0, nullptr, &config);
+        pegasus_sim_->buildTree();
+        pegasus_sim_->configureTree();
+        pegasus_sim_->finalizeTree();
+
+        core_ = pegasus_sim_->getPegasusCore();
+    }
+
+    void testLinkedActionsPerHart()
+    {
+        std::cout << "Testing linked instruction Actions of harts sharing an mhartid" << std::endl;
+        pegasus::PegasusState* state0 = core_->getPegasusState(0);
+        pegasus::PegasusState* state1 = core_->getPegasusState(1);
+        EXPECT_EQUAL(state0->getHartId(), state1->getHartId());
+        EXPECT_EQUAL(state0->getCoreHartIdx(), 0);
+        EXPECT_EQUAL(state1->getCoreHartIdx(), 1);
+
+        // addi x1, x1, 1
+        const uint32_t opcode = 0x00108093;
+        injectInstruction(state0, 0x1000, opcode);
+        injectInstruction(state1, 0x2000, opcode);
+        EXPECT_EQUAL(state0->getSimState()->inst_count, 1);
+        EXPECT_EQUAL(state1->getSimState()->inst_count, 1);
+
+        // Both harts decoded the same extractor, each linked its own Actions into it
+        pegasus::PegasusExtractor* extractor = state0->getCurrentInst()->getExtractorInfo();
+        EXPECT_EQUAL(extractor, state1->getCurrentInst()->getExtractorInfo());
+        const pegasus::PegasusExtractor::LinkedActions & linked_actions0 =
+            extractor->getLinkedActions(state0->getCoreHartIdx());
+        const pegasus::PegasusExtractor::LinkedActions & linked_actions1 =
+            extractor->getLinkedActions(state1->getCoreHartIdx());
+        EXPECT_EQUAL(linked_actions0.version, state0->getInstActionsVersion());
+        EXPECT_EQUAL(linked_actions1.version, state1->getInstActionsVersion());
+
+        // Only the profiled hart executes the profiler Actions
+        EXPECT_TRUE(linked_actions1.actions.size() > linked_actions0.actions.size());
+        EXPECT_EQUAL(state0->getCurrentInst()->getActionGroup()->getActions().size(),
+                     linked_actions0.actions.size());
+        EXPECT_EQUAL(state1->getCurrentInst()->getActionGroup()->getActions().size(),
+                     linked_actions1.actions.size());
+    }
+
+  private:
+    void injectInstruction(pegasus::PegasusState* state, const uint64_t pc, const uint32_t opcode)
+    {
+        state->writeMemory(pc, opcode);
+        state->setPc(pc);
+
+        // Fetch and Execute instruction
+        pegasus::ActionGroup* next_action_group = state->getFetchUnit()->getActionGroup();
+        do
+        {
+            next_action_group = next_action_group->execute(state);
+        } while (next_action_group
+                 && (next_action_group->hasTag(pegasus::ActionTags::FETCH_TAG) == false));
+    }
+
+    sparta::Scheduler scheduler_;
+    std::unique_ptr<pegasus::PegasusSim> pegasus_sim_;
+
+    pegasus::PegasusCore* core_ = nullptr;
+};
+
+int main()
+{
+    PegasusExecuteTester tester;
+    tester.testLinkedActionsPerHart();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -1,6 +1,7 @@
 #include "sim/PegasusSim.hpp"
 
 #include "core/translate/PageTable.hpp"
+#include "core/translate/TLB.hpp"
 
 #include "include/PegasusTypes.hpp"
 #include "include/gen/CSRNums.hpp"
@@ -447,6 +448,56 @@ class PegasusTranslateTester
         translation_state->reset();
     }
 
+    void testTLB()
+    {
+        std::cout << "Testing TLB class" << std::endl;
+        pegasus::TLB tlb(16);
+
+        // Power of 2 sizes only
+        EXPECT_THROW(pegasus::TLB(10));
+
+        const uint64_t pte_rwx = 0xcf;  // D, A, X, W, R, V
+        const uint64_t pte_global = pte_rwx | 0x20;
+        const uint32_t asid = 3;
+        const uint32_t vmid = 0;
+
+        // 4K page
+        tlb.insert(0x12345678, 0x80045678, 0xfff, pte_rwx, 1, asid, vmid);
+        const pegasus::TLB::Entry* entry = tlb.lookup(0x12345abc, asid, vmid);
+        EXPECT_TRUE(entry != nullptr);
+        EXPECT_EQUAL(entry->translate(0x12345abc), 0x80045abc);
+        EXPECT_EQUAL(entry->level, 1);
+
+        // Different address space or page misses
+        EXPECT_TRUE(tlb.lookup(0x12345abc, asid + 1, vmid) == nullptr);
+        EXPECT_TRUE(tlb.lookup(0x12346abc, asid, vmid) == nullptr);
+
+        // 2M superpage, every 4K slice hits once inserted
+        tlb.insert(0x40201000, 0x80201000, 0x1fffff, pte_global, 2, asid, vmid);
+        entry = tlb.lookup(0x40201008, asid + 1, vmid);
+        EXPECT_TRUE(entry != nullptr);
+        EXPECT_TRUE(entry->global);
+        EXPECT_EQUAL(entry->translate(0x40201008), 0x80201008);
+
+        // Flushing an ASID keeps global mappings
+        tlb.flush(std::nullopt, asid, std::nullopt);
+        EXPECT_TRUE(tlb.lookup(0x12345abc, asid, vmid) == nullptr);
+        EXPECT_TRUE(tlb.lookup(0x40201008, asid, vmid) != nullptr);
+
+        // Flushing by address matches anywhere in the superpage
+        tlb.flush(0x40300000, std::nullopt, std::nullopt);
+        EXPECT_TRUE(tlb.lookup(0x40201008, asid, vmid) == nullptr);
+
+        // Flush by VMID
+        tlb.insert(0x1000, 0x2000, 0xfff, pte_rwx, 1, 0, 7);
+        EXPECT_TRUE(tlb.lookup(0x1000, 0, 7) != nullptr);
+        EXPECT_TRUE(tlb.lookup(0x1000, 0, 6) == nullptr);
+        tlb.flush(std::nullopt, std::nullopt, 6);
+        EXPECT_TRUE(tlb.lookup(0x1000, 0, 7) != nullptr);
+        tlb.flushAll();
+        EXPECT_TRUE(tlb.lookup(0x1000, 0, 7) == nullptr);
+    }
+
   private:
     sparta::Scheduler scheduler_;
     std::unique_ptr<pegasus::PegasusSim> pegasus_sim_;
@@ -465,6 +516,7 @@ int main(int argc, char** argv)
     translate_tester.testPegasusTranslationStateBasic();
     translate_tester.testPegasusTranslationStateMisaligned();
     translate_tester.testPegasusTranslationStateMultiple();
+    translate_tester.testTLB();
     // translate_tester.testPageTableEntry();
     // translate_tester.testPageTable();
 
@@ -0,0 +1,177 @@
+#include "sim/PegasusSim.hpp"
+#include "core/PegasusState.hpp"
+#include "core/VecRegFile.hpp"
+
+#include "include/PegasusTypes.hpp"
+
+#include "sparta/utils/SpartaTester.hpp"
+
+#include <sstream>
+
+void testVecRegFile()
+{
+    std::cout << "Testing VecRegFile" << std::endl;
+    const uint32_t vlenb = 16;
+    pegasus::VecRegFile vec_reg_file(vlenb);
+    EXPECT_EQUAL(vec_reg_file.getVLENB(), vlenb);
+    EXPECT_EQUAL(vec_reg_file.getDirtyRegs(), 0);
+
+    // Registers start out zeroed in one aligned buffer
+    const std::span<const uint8_t> all_regs =
+        vec_reg_file.getRegGroup(0, pegasus::VecRegFile::NUM_REGS);
+    EXPECT_EQUAL(all_regs.size(), pegasus::VecRegFile::NUM_REGS * vlenb);
+    EXPECT_EQUAL(reinterpret_cast<uintptr_t>(all_regs.data()) % pegasus::VecRegFile::ALIGNMENT,
+                 0);
+    for (const uint8_t byte : all_regs)
+    {
+        EXPECT_EQUAL(byte, 0);
+    }
+
+    // Element writes land at reg_num * VLENB + idx * sizeof(T) and mark the register dirty
+    vec_reg_file.write<uint32_t>(3, 0xdeadbeef, 1);
+    EXPECT_EQUAL(vec_reg_file.read<uint32_t>(3, 1), 0xdeadbeef);
+    EXPECT_EQUAL(vec_reg_file.read<uint32_t>(3, 0), 0);
+    EXPECT_EQUAL(vec_reg_file.read<uint8_t>(3, 4), 0xef);
+    EXPECT_EQUAL(all_regs[3 * vlenb + 7], 0xde);
+    EXPECT_EQUAL(vec_reg_file.getDirtyRegs(), 1u << 3);
+
+    // A register group is contiguous
+    vec_reg_file.write<uint64_t>(4, 0x1111111111111111, 1);
+    vec_reg_file.write<uint64_t>(5, 0x2222222222222222, 0);
+    const std::span<const uint8_t> group = vec_reg_file.getRegGroup(4, 2);
+    EXPECT_EQUAL(group.size(), 2 * vlenb);
+    EXPECT_EQUAL(group.data(), all_regs.data() + 4 * vlenb);
+    EXPECT_EQUAL(group[vlenb - 1], 0x11);
+    EXPECT_EQUAL(group[vlenb], 0x22);
+    EXPECT_EQUAL(vec_reg_file.getDirtyRegs(), (1u << 3) | (1u << 4) | (1u << 5));
+
+    // Reading does not mark registers dirty, mutable views mark the whole group
+    vec_reg_file.clearDirtyRegs();
+    EXPECT_EQUAL(vec_reg_file.read<uint64_t>(5, 0), 0x2222222222222222);
+    EXPECT_EQUAL(vec_reg_file.getRegGroup(8, 8).size(), 8 * vlenb);
+    EXPECT_EQUAL(vec_reg_file.getDirtyRegs(), 0);
+
+    std::span<uint8_t> mutable_group = vec_reg_file.getMutableRegGroup(30, 2);
+    mutable_group[vlenb] = 0x5a;
+    EXPECT_EQUAL(vec_reg_file.read<uint8_t>(31, 0), 0x5a);
+    EXPECT_EQUAL(vec_reg_file.getDirtyRegs(), 3u << 30);
+
+    vec_reg_file.getMutableRegGroup(0, pegasus::VecRegFile::NUM_REGS);
+    EXPECT_EQUAL(vec_reg_file.getDirtyRegs(), 0xffffffff);
+    vec_reg_file.clearDirtyRegs();
+    EXPECT_EQUAL(vec_reg_file.getDirtyRegs(), 0);
+}
+
+class PegasusVecRegSyncTester
+{
+
+  public:
+    PegasusVecRegSyncTester()
+    {
+        // Create the simulator
+        pegasus_sim_.reset(new pegasus::PegasusSim(&scheduler_));
+
+        sparta::app::SimulationConfiguration config;
+        pegasus_sim_->configure(0, nullptr, &config);
+        pegasus_sim_->buildTree();
+        pegasus_sim_->configureTree();
+        pegasus_sim_->finalizeTree();
+
+        state_ = pegasus_sim_->getPegasusCore()->getPegasusState();
+        vec_reg_file_ = state_->getVecRegFile();
+    }
+
+    // Instruction handlers write the register file, the vec_regs register set only sees the
+    // writes once they are synced
+    void testSyncToSparta()
+    {
+        std::cout << "Testing vector register sync to the vec_regs register set" << std::endl;
+        vec_reg_file_->clearDirtyRegs();
+        vec_reg_file_->write<uint64_t>(1, 0x0123456789abcdef, 0);
+        vec_reg_file_->write<uint64_t>(7, 0xfedcba9876543210, 1);
+        EXPECT_EQUAL(vec_reg_file_->getDirtyRegs(), (1u << 1) | (1u << 7));
+        EXPECT_EQUAL(state_->getVecRegister(1)->dmiRead<uint64_t>(), 0);
+
+        state_->syncVecRegsToSparta();
+        EXPECT_EQUAL(vec_reg_file_->getDirtyRegs(), 0);
+        EXPECT_EQUAL(state_->getVecRegister(1)->dmiRead<uint64_t>(), 0x0123456789abcdef);
+        EXPECT_EQUAL(state_->getVecRegister(7)->dmiRead<uint64_t>(1), 0xfedcba9876543210);
+
+        // Registers that were not written are left alone
+        state_->getVecRegister(2)->dmiWrite<uint64_t>(0x5555);
+        state_->syncVecRegsToSparta();
+        EXPECT_EQUAL(state_->getVecRegister(2)->dmiRead<uint64_t>(), 0x5555);
+        state_->syncVecRegsFromSparta();
+    }
+
+    // A debugger (and cosim) writes the vec_regs register set directly and reloads the register
+    // file from it
+    void testSyncFromSparta()
+    {
+        std::cout << "Testing vector register sync from the vec_regs register set" << std::endl;
+        sparta::Register* v3 = state_->findRegister("v3");
+        EXPECT_EQUAL(v3, state_->getVecRegister(3));
+        v3->write<uint64_t>(0xa5a5a5a5a5a5a5a5);
+        EXPECT_EQUAL(vec_reg_file_->read<uint64_t>(3, 0), 0);
+
+        state_->syncVecRegsFromSparta();
+        EXPECT_EQUAL(vec_reg_file_->read<uint64_t>(3, 0), 0xa5a5a5a5a5a5a5a5);
+        EXPECT_EQUAL(vec_reg_file_->getDirtyRegs(), 0);
+
+        // The reload does not push stale register file values back
+        state_->syncVecRegsToSparta();
+        EXPECT_EQUAL(v3->read<uint64_t>(), 0xa5a5a5a5a5a5a5a5);
+    }
+
+    // Snapshots save the vec_regs register set, registers written since the last sync must be
+    // in it and a restore must reload the register file
+    void testSnapshot()
+    {
+        std::cout << "Testing vector registers in snapshots" << std::endl;
+        const uint32_t vlenb = vec_reg_file_->getVLENB();
+        for (uint32_t idx = 0; idx < vlenb; ++idx)
+        {
+            vec_reg_file_->write<uint8_t>(31, idx + 1, idx);
+        }
+        vec_reg_file_->write<uint64_t>(4, 0x1234, 0);
+        EXPECT_NOTEQUAL(vec_reg_file_->getDirtyRegs(), 0);
+
+        std::stringstream snapshot;
+        state_->saveSnapshot(snapshot);
+        EXPECT_EQUAL(vec_reg_file_->getDirtyRegs(), 0);
+
+        // Clobber the registers after the snapshot was taken, synced and not synced
+        vec_reg_file_->write<uint64_t>(4, 0xdead, 0);
+        state_->syncVecRegsToSparta();
+        vec_reg_file_->write<uint8_t>(31, 0xff, 0);
+
+        state_->restoreSnapshot(snapshot);
+        EXPECT_EQUAL(vec_reg_file_->getDirtyRegs(), 0);
+        EXPECT_EQUAL(vec_reg_file_->read<uint64_t>(4, 0), 0x1234);
+        EXPECT_EQUAL(state_->getVecRegister(4)->dmiRead<uint64_t>(), 0x1234);
+        for (uint32_t idx = 0; idx < vlenb; ++idx)
+        {
+            EXPECT_EQUAL(vec_reg_file_->read<uint8_t>(31, idx), idx + 1);
+        }
+    }
+
+  private:
+    sparta::Scheduler scheduler_;
+    std::unique_ptr<pegasus::PegasusSim> pegasus_sim_;
+
+    pegasus::PegasusState* state_ = nullptr;
+    pegasus::VecRegFile* vec_reg_file_ = nullptr;
+};
+
+int main()
+{
+    testVecRegFile();
+
+    PegasusVecRegSyncTester tester;
+    tester.testSyncToSparta();
+    tester.testSyncFromSparta();
+    tester.testSnapshot();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
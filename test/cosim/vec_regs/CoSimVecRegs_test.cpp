@@ -0,0 +1,74 @@
+#include "cosim/PegasusCoSim.hpp"
+#include "sim/PegasusSim.hpp"
+#include "core/PegasusState.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+#include <cstring>
+
+/// Cosim reads and writes the vector registers through the vec_regs register set, while
+/// instruction handlers use the hart's vector register file. Check that values written on
+/// either side are seen on the other.
+
+using pegasus::cosim::PegasusCoSim;
+
+int main()
+{
+    const std::map<std::string, std::string> params = {
+        {"top.core*.params.isa", "rv64gcbv_zicsr_zifencei_zicond_zfh"}};
+    PegasusCoSim cosim(0, "rv64mi-p-csr", params, "cosim_vec_regs.db");
+
+    const pegasus::CoreId core_id = 0;
+    const pegasus::HartId hart_id = 0;
+    pegasus::PegasusState* state =
+        cosim.getPegasusSim().getPegasusCore(core_id)->getPegasusState(hart_id);
+    pegasus::VecRegFile* vec_reg_file = state->getVecRegFile();
+    const uint32_t vlenb = vec_reg_file->getVLENB();
+
+    // Register file writes that were not synced yet are seen by reads and peeks
+    vec_reg_file->write<uint64_t>(1, 0x0123456789abcdef, 0);
+    vec_reg_file->write<uint64_t>(2, 0xfedcba9876543210, 1);
+
+    std::vector<uint8_t> buffer;
+    cosim.readRegister(core_id, hart_id, "v1", buffer);
+    EXPECT_EQUAL(buffer.size(), vlenb);
+    uint64_t value = 0;
+    memcpy(&value, buffer.data(), sizeof(value));
+    EXPECT_EQUAL(value, 0x0123456789abcdef);
+
+    vec_reg_file->write<uint64_t>(1, 0x1111, 0);
+    cosim.peekRegister(core_id, hart_id, "v1", buffer);
+    memcpy(&value, buffer.data(), sizeof(value));
+    EXPECT_EQUAL(value, 0x1111);
+    cosim.peekRegister(core_id, hart_id, "v2", buffer);
+    memcpy(&value, buffer.data() + sizeof(value), sizeof(value));
+    EXPECT_EQUAL(value, 0xfedcba9876543210);
+    EXPECT_EQUAL(vec_reg_file->getDirtyRegs(), 0);
+
+    // Writes and pokes reload the register file
+    std::vector<uint8_t> reg_value(vlenb);
+    for (uint32_t idx = 0; idx < vlenb; ++idx)
+    {
+        reg_value[idx] = idx + 1;
+    }
+    cosim.writeRegister(core_id, hart_id, "v3", reg_value);
+    for (uint32_t idx = 0; idx < vlenb; ++idx)
+    {
+        EXPECT_EQUAL(vec_reg_file->read<uint8_t>(3, idx), idx + 1);
+    }
+
+    reg_value.assign(vlenb, 0x5a);
+    cosim.pokeRegister(core_id, hart_id, "v31", reg_value);
+    for (uint32_t idx = 0; idx < vlenb; ++idx)
+    {
+        EXPECT_EQUAL(vec_reg_file->read<uint8_t>(31, idx), 0x5a);
+    }
+
+    // A reload does not undo register file writes that were synced before it
+    EXPECT_EQUAL(vec_reg_file->read<uint64_t>(1, 0), 0x1111);
+    EXPECT_EQUAL(vec_reg_file->getDirtyRegs(), 0);
+
+    cosim.finish();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -0,0 +1,47 @@
+/* Test: trap_bench.elf
+ * ISA: rv64i
+ * Description: Trap throughput benchmark. Takes a large number of
+ *              M-mode traps (ecalls and illegal instructions) whose
+ *              handler simply skips the trapping instruction. Run with
+ *              pegasus and compare the reported "Traps/sec".
+ */
+
+.include "host.s"
+.include "macros.s"
+
+.equ NUM_ITERATIONS, 100000
+
+.section .text
+    .global main
+
+main:
+    la t0, trap_handler
+    csrw mtvec, t0
+    li s0, NUM_ITERATIONS
+    li s1, 0
+
+loop:
+    ecall
+    # csrw cycle, x0 -- writing a read-only CSR is an illegal instruction
+    .word 0xc0001073
+    addi s0, s0, -1
+    bnez s0, loop
+
+    # Every iteration must have taken two traps
+    li t0, NUM_ITERATIONS * 2
+    bne s1, t0, fail
+
+pass:
+    test_pass
+
+fail:
+    test_fail
+
+# Skip the trapping instruction (all are 4 bytes) and count the trap
+.align 2
+trap_handler:
+    csrr t1, mepc
+    addi t1, t1, 4
+    csrw mepc, t1
+    addi s1, s1, 1
+    mret
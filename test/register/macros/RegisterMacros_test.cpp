@@ -276,6 +276,20 @@ void testCsrRegs()
 
     EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::MVENDORID, "Bank"), 0xe);
     EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::MVENDORID, "Offset"), 0xf);
+
+    // Case 7: Field descriptors must match the string-based field accessors
+    EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::CSR::MVENDORID::BANK), 0xe);
+    EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::CSR::MVENDORID::OFFSET), 0xf);
+
+    POKE_CSR_REG<pegasus::RV64>(state, pegasus::DMCONTROL, 0);
+    WRITE_CSR_FIELD<pegasus::RV64>(state, pegasus::CSR::DMCONTROL::HARTRESET, 1);
+    EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::DMCONTROL, "hartreset"), 1);
+    WRITE_CSR_FIELD<pegasus::RV64>(state, pegasus::CSR::DMCONTROL::HASEL, 1);
+    EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::CSR::DMCONTROL::HASEL), 0);
+
+    POKE_CSR_FIELD<pegasus::RV64>(state, pegasus::CSR::SSTATUS::XS, 2);
+    EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::SSTATUS, "XS"), 2);
+    EXPECT_EQUAL(READ_CSR_FIELD<pegasus::RV64>(state, pegasus::CSR::SSTATUS::XS), 2);
 }
 
 int main()
@@ -8,12 +8,17 @@ class PegasusInstructionTester
 {
 
   public:
-    PegasusInstructionTester()
+    // params are simulator parameters (name, value) to override, e.g. the VLEN of the hart
+    PegasusInstructionTester(const std::vector<std::pair<std::string, std::string>> & params = {})
     {
         // Create the simulator
         pegasus_sim_.reset(new pegasus::PegasusSim(&scheduler_));
 
         sparta::app::SimulationConfiguration config;
+        for (const auto & [name, value] : params)
+        {
+            config.processParameter(name, value);
+        }
         pegasus_sim_->configure(0, nullptr, &config);
         pegasus_sim_->buildTree();
         pegasus_sim_->configureTree();
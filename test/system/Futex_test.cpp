@@ -0,0 +1,147 @@
+#include "sim/PegasusSim.hpp"
+#include "core/PegasusCore.hpp"
+#include "core/PegasusState.hpp"
+#include "system/PegasusSystem.hpp"
+#include "system/SystemCallEmulator.hpp"
+
+#include "include/PegasusTypes.hpp"
+
+#include "sparta/utils/SpartaTester.hpp"
+
+#include <cerrno>
+#include <linux/futex.h>
+
+/// Timed futex waits are parked like WFI and give up when no other hart on the core can run.
+/// A wait that gives up returns -ETIMEDOUT, one that is woken by FUTEX_WAKE returns 0.
+
+class PegasusFutexTester
+{
+
+  public:
+    PegasusFutexTester()
+    {
+        // The workload only provides the break address for system call emulation, the harts run
+        // the code written below
+        sparta::app::SimulationConfiguration config;
+        const pegasus::PegasusSimParameters::WorkloadsAndArgs workloads_and_args{
+            {"workloads/dhry.elf"}};
+        config.processParameter(
+            "top.extension.sim.workloads",
+            pegasus::PegasusSimParameters::convertVectorToStringParam(workloads_and_args));
+        config.processParameter("top.extension.sim.enable_syscall_emulation", "true");
+        config.processParameter("top.core0.params.num_harts", "2");
+        config.copyTreeNodeExtensionsFromArchAndConfigPTrees();
+
+        // Create the simulator
+        pegasus_sim_.reset(new pegasus::PegasusSim(&scheduler_));
+        pegasus_sim_->configure(0, nullptr, &config);
+        pegasus_sim_->buildTree();
+        pegasus_sim_->configureTree();
+        pegasus_sim_->finalizeTree();
+
+        core_ = pegasus_sim_->getPegasusCore();
+    }
+
+    void testTimedWait()
+    {
+        std::cout << "Testing timed futex waits" << std::endl;
+        pegasus::PegasusState* state0 = core_->getPegasusState(0);
+        pegasus::PegasusState* state1 = core_->getPegasusState(1);
+        state0->writeMemory<uint32_t>(FUTEX0, 0);
+        state0->writeMemory<uint32_t>(FUTEX1, 0);
+
+        // Hart0 waits on FUTEX0 without a timeout and is never woken
+        state0->writeMemory<uint32_t>(0x1000, ECALL);
+        setFutexArgs(state0, FUTEX0, FUTEX_WAIT_PRIVATE, 0);
+        state0->setPc(0x1000);
+
+        // Hart1 waits on FUTEX1 with a timeout twice and saves the results in s0 and s1
+        const uint32_t code[] = {
+            ECALL,
+            0x00050413, // mv s0, a0
+            0x00090513, // mv a0, s2
+            ECALL,
+            0x00050493, // mv s1, a0
+            0x0000006f  // j .
+        };
+        for (uint32_t idx = 0; idx < std::size(code); ++idx)
+        {
+            state0->writeMemory<uint32_t>(0x2000 + idx * sizeof(uint32_t), code[idx]);
+        }
+        setFutexArgs(state1, FUTEX1, FUTEX_WAIT_PRIVATE, TIMEOUT);
+        pegasus::WRITE_INT_REG<pegasus::RV64>(state1, S2, FUTEX1);
+        state1->setPc(0x2000);
+        core_->startHart(1);
+
+        // Both harts park
+        core_->runQuantum();
+        EXPECT_FALSE(core_->isHartIdle(0));
+        EXPECT_FALSE(core_->isHartIdle(1));
+        EXPECT_EQUAL(state0->getPc(), 0x1004);
+        EXPECT_EQUAL(state1->getPc(), 0x2004);
+        EXPECT_EQUAL(readReg(state1, A0), -ETIMEDOUT);
+
+        // Nothing else can run, the timed wait gives up and hart1 waits again
+        core_->runQuantum();
+        EXPECT_EQUAL(state0->getPc(), 0x1004);
+        EXPECT_EQUAL(state1->getPc(), 0x2010);
+        EXPECT_EQUAL(readReg(state1, S0), -ETIMEDOUT);
+
+        // Waking the second wait makes it return 0
+        pegasus::SystemCallEmulator* emulator = core_->getSystemCallEmulator();
+        const pegasus::SystemCallStack wake = {SYS_FUTEX, FUTEX1, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0,
+                                               0};
+        EXPECT_EQUAL(emulator->emulateSystemCall(state0, wake,
+                                                 core_->getSystem()->getSystemMemory()),
+                     1);
+        EXPECT_EQUAL(readReg(state1, A0), 0);
+
+        core_->runQuantum();
+        EXPECT_EQUAL(state0->getPc(), 0x1004);
+        EXPECT_EQUAL(state1->getPc(), 0x2014);
+        EXPECT_EQUAL(readReg(state1, S1), 0);
+
+        // Nothing is left waiting on FUTEX1
+        EXPECT_EQUAL(emulator->emulateSystemCall(state0, wake,
+                                                 core_->getSystem()->getSystemMemory()),
+                     0);
+    }
+
+  private:
+    static constexpr uint32_t ECALL = 0x00000073;
+    static constexpr uint64_t SYS_FUTEX = 98;
+    static constexpr uint64_t FUTEX0 = 0x3000;
+    static constexpr uint64_t FUTEX1 = 0x3004;
+    // Only checked for 0, the timespec is never read
+    static constexpr uint64_t TIMEOUT = 0x3100;
+    static constexpr uint32_t S0 = 8, S1 = 9, A0 = 10, S2 = 18;
+
+    static void setFutexArgs(pegasus::PegasusState* state, const uint64_t uaddr, const int op,
+                             const uint64_t timeout)
+    {
+        pegasus::WRITE_INT_REG<pegasus::RV64>(state, 17, SYS_FUTEX);
+        pegasus::WRITE_INT_REG<pegasus::RV64>(state, A0, uaddr);
+        pegasus::WRITE_INT_REG<pegasus::RV64>(state, 11, op);
+        pegasus::WRITE_INT_REG<pegasus::RV64>(state, 12, 0);
+        pegasus::WRITE_INT_REG<pegasus::RV64>(state, 13, timeout);
+    }
+
+    static int64_t readReg(pegasus::PegasusState* state, const uint32_t reg)
+    {
+        return static_cast<int64_t>(pegasus::READ_INT_REG<pegasus::RV64>(state, reg));
+    }
+
+    sparta::Scheduler scheduler_;
+    std::unique_ptr<pegasus::PegasusSim> pegasus_sim_;
+
+    pegasus::PegasusCore* core_ = nullptr;
+};
+
+int main()
+{
+    PegasusFutexTester tester;
+    tester.testTimedWait();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -0,0 +1,158 @@
+#include "system/ReservationTable.hpp"
+
+#include "sparta/utils/SpartaTester.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void testReservations()
+{
+    auto table = std::make_unique<pegasus::ReservationTable>();
+    const uint32_t hart0 = table->addHart();
+    const uint32_t hart1 = table->addHart();
+
+    // SC succeeds with a matching reservation and always clears it
+    table->makeReservation(hart0, 0x1000);
+    EXPECT_TRUE(table->getReservation(hart0).isValid());
+    EXPECT_EQUAL(table->getReservation(hart0).getValue(), 0x1000);
+    EXPECT_TRUE(table->consumeReservation(hart0, 0x1000));
+    EXPECT_FALSE(table->getReservation(hart0).isValid());
+    EXPECT_FALSE(table->consumeReservation(hart0, 0x1000));
+
+    // SC to a different address fails
+    table->makeReservation(hart0, 0x1000);
+    EXPECT_FALSE(table->consumeReservation(hart0, 0x1008));
+
+    // A new LR replaces the previous reservation
+    table->makeReservation(hart0, 0x1000);
+    table->makeReservation(hart0, 0x2000);
+    EXPECT_EQUAL(table->getReservation(hart0).getValue(), 0x2000);
+
+    // Harts can hold reservations on the same line
+    table->makeReservation(hart1, 0x2008);
+    EXPECT_TRUE(table->getReservation(hart0).isValid());
+    EXPECT_TRUE(table->getReservation(hart1).isValid());
+
+    pegasus::ReservationTable::Reservation reservation;
+    table->setReservation(hart1, reservation);
+    EXPECT_FALSE(table->getReservation(hart1).isValid());
+    reservation = 0x3000;
+    table->setReservation(hart1, reservation);
+    EXPECT_EQUAL(table->getReservation(hart1).getValue(), 0x3000);
+}
+
+void testInvalidation()
+{
+    auto table = std::make_unique<pegasus::ReservationTable>();
+    const uint32_t hart0 = table->addHart();
+    const uint32_t hart1 = table->addHart();
+    const uint32_t hart2 = table->addHart();
+
+    table->makeReservation(hart0, 0x1000);
+    table->makeReservation(hart1, 0x1010);
+    table->makeReservation(hart2, 0x1040);
+
+    // A hart's own stores do not invalidate its reservation
+    table->invalidate(hart0, 0x1000, 8);
+    EXPECT_TRUE(table->getReservation(hart0).isValid());
+
+    // Stores invalidate the other harts' reservations on the same cache line only
+    table->invalidate(hart0, 0x1038, 8);
+    EXPECT_TRUE(table->getReservation(hart0).isValid());
+    EXPECT_FALSE(table->getReservation(hart1).isValid());
+    EXPECT_TRUE(table->getReservation(hart2).isValid());
+
+    // A store crossing a line boundary invalidates both lines
+    table->makeReservation(hart1, 0x1010);
+    table->invalidate(hart2, 0x103c, 8);
+    EXPECT_FALSE(table->getReservation(hart0).isValid());
+    EXPECT_FALSE(table->getReservation(hart1).isValid());
+    EXPECT_TRUE(table->getReservation(hart2).isValid());
+
+    // Lines that share a bucket are still told apart
+    const pegasus::Addr aliased_line = 0x1040 + 1024 * pegasus::ReservationTable::LINE_SIZE;
+    table->invalidate(hart0, aliased_line, 8);
+    EXPECT_TRUE(table->getReservation(hart2).isValid());
+}
+
+// Harts on separate host threads increment a shared counter, half of them with LR/SC loops and
+// half of them with plain stores. An LR that misses a concurrent store while its reservation
+// survives that store lets the SC overwrite the store, losing an increment.
+void testConcurrentLrScAndStores()
+{
+    constexpr uint32_t NUM_HARTS = 4;
+    constexpr uint64_t NUM_INCREMENTS = 200000;
+    constexpr pegasus::Addr paddr = 0x8000;
+
+    auto table = std::make_unique<pegasus::ReservationTable>();
+    std::array<uint32_t, NUM_HARTS> hart_idxs;
+    for (auto & hart_idx : hart_idxs)
+    {
+        hart_idx = table->addHart();
+    }
+
+    // Memory is accessed with relaxed atomics, like plain host memory accesses. SCs and stores
+    // are serialized with each other (PegasusSystem::lockMemory), LRs are not.
+    std::atomic<uint64_t> memory{0};
+    std::mutex memory_mutex;
+
+    auto lr_sc_hart = [&](const uint32_t hart_idx)
+    {
+        for (uint64_t i = 0; i < NUM_INCREMENTS;)
+        {
+            table->makeReservation(hart_idx, paddr);
+            const uint64_t value = memory.load(std::memory_order_relaxed);
+
+            const std::lock_guard<std::mutex> lock(memory_mutex);
+            if (table->consumeReservation(hart_idx, paddr))
+            {
+                memory.store(value + 1, std::memory_order_relaxed);
+                table->invalidate(hart_idx, paddr, sizeof(uint64_t));
+                ++i;
+            }
+        }
+    };
+
+    auto store_hart = [&](const uint32_t hart_idx)
+    {
+        for (uint64_t i = 0; i < NUM_INCREMENTS; ++i)
+        {
+            const std::lock_guard<std::mutex> lock(memory_mutex);
+            memory.store(memory.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            table->invalidate(hart_idx, paddr, sizeof(uint64_t));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < NUM_HARTS; ++i)
+    {
+        if ((i % 2) == 0)
+        {
+            threads.emplace_back(lr_sc_hart, hart_idxs[i]);
+        }
+        else
+        {
+            threads.emplace_back(store_hart, hart_idxs[i]);
+        }
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQUAL(memory.load(), NUM_HARTS * NUM_INCREMENTS);
+}
+
+int main()
+{
+    testReservations();
+    testInvalidation();
+    testConcurrentLrScAndStores();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -191,6 +191,62 @@ class ViaInstructionTester : public PegasusInstructionTester
         EXPECT_EQUAL(sim_state->inst_count, 4);
     }
 
+    void testVaddvv5()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const pegasus::Addr pc = 0x1000;
+        uint32_t opcode;
+
+        state->getVectorConfig()->setVLEN(64);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(14);   // avl = 14
+        state->getVectorConfig()->setLMUL(16); // vlmul = 2
+        state->getVectorConfig()->setSEW(8);   // sew = 8
+
+        VLEN old_val = {0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA};
+        VLEN vs0_val = {0xF0, 0x0F, 0, 0, 0, 0, 0, 0}; // mask first 4 and last 6
+        VLEN vs1_val = {0, 1, 2, 3, 4, 5, 6, 7};
+        VLEN vs2_val = {1, 2, 3, 4, 5, 6, 7, 8};
+        VLEN vs3_val = {9, 10, 11, 12, 13, 14, 15, 16};
+        VLEN vs4_val = {17, 18, 19, 20, 21, 22, 23, 24};
+        VLEN vs5_val = {9, 11, 13, 15, 17, 19, 21, 23};
+        VLEN vs6_val = {18, 20, 22, 24, 26, 28, 30, 32};
+
+        WRITE_VEC_REG<VLEN>(state, 0, vs0_val);
+        WRITE_VEC_REG<VLEN>(state, 1, vs1_val);
+        WRITE_VEC_REG<VLEN>(state, 2, vs2_val);
+        WRITE_VEC_REG<VLEN>(state, 3, vs3_val);
+        WRITE_VEC_REG<VLEN>(state, 4, vs4_val);
+        WRITE_VEC_REG<VLEN>(state, 5, old_val);
+        WRITE_VEC_REG<VLEN>(state, 6, old_val);
+        opcode = vaddvvOp(5, 1, 3, 0); // masked
+        injectInstruction(pc, opcode);
+
+        // Masked off and tail elements keep their previous value
+        auto vd_val1 = READ_VEC_REG<VLEN>(state, 5);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            EXPECT_EQUAL(vd_val1[i], old_val[i]);
+        }
+        for (size_t i = 4; i < vd_val1.size(); ++i)
+        {
+            EXPECT_EQUAL(vd_val1[i], vs5_val[i]);
+        }
+
+        auto vd_val2 = READ_VEC_REG<VLEN>(state, 6);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            EXPECT_EQUAL(vd_val2[i], vs6_val[i]);
+        }
+        for (size_t i = 4; i < vd_val2.size(); ++i)
+        {
+            EXPECT_EQUAL(vd_val2[i], old_val[i]);
+        }
+        const pegasus::PegasusState::SimState* sim_state = state->getSimState();
+        std::cout << sim_state->current_inst << std::endl;
+        EXPECT_EQUAL(sim_state->inst_count, 5);
+    }
+
     uint32_t vaddvvOp(uint8_t rd, uint8_t rs1, uint8_t rs2, uint8_t vm)
     {
         uint32_t opcode = 0;
@@ -225,6 +281,7 @@ int main()
     Via_tester.testVaddvv2();
     Via_tester.testVaddvv3();
     Via_tester.testVaddvv4();
+    Via_tester.testVaddvv5();
 
     REPORT_ERROR;
     return ERROR_CODE;
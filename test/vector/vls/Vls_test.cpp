@@ -1,8 +1,12 @@
 #include "test/sim/InstructionTester.hpp"
 #include "core/VecElements.hpp"
+#include "core/Trap.hpp"
+#include "core/translate/PegasusTranslationState.hpp"
 #include "sparta/utils/SpartaTester.hpp"
 #include "mavis/Mavis.h"
 
+#include <bit>
+
 class VlsInstructionTester : public PegasusInstructionTester
 {
 
@@ -10,7 +14,8 @@ class VlsInstructionTester : public PegasusInstructionTester
     using VLEN = std::array<uint8_t, 8>;
     using XLEN = uint64_t;
 
-    VlsInstructionTester() = default;
+    // The batched strided tests need more than 256 elements in a register group
+    VlsInstructionTester() : PegasusInstructionTester({{"top.core0.hart0.params.vlen", "512"}}) {}
 
     void testVle8()
     {
@@ -110,6 +115,296 @@ class VlsInstructionTester : public PegasusInstructionTester
         EXPECT_EQUAL(sim_state->inst_count, 3);
     }
 
+    void testVle8MaskedPageCross()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const uint64_t pc = 0x1000;
+        const pegasus::Addr addr = 0x2ffc; // crosses into the next page
+        const uint32_t vd = 2, rs1 = 1;
+        const VLEN vd_prev = {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa};
+        const VLEN mask = {0b10110101, 0, 0, 0, 0, 0, 0, 0};
+
+        state->getVectorConfig()->setVLEN(64);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(8); // avl = 8
+        state->getVectorConfig()->setSEW(8);
+        state->getVectorConfig()->setLMUL(8);
+        for (size_t i = 0; i < vd_prev.size(); ++i)
+        {
+            state->writeMemory<uint8_t>(addr + i, i + 1);
+        }
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+        WRITE_VEC_REG<VLEN>(state, vd, vd_prev);
+        WRITE_VEC_REG<VLEN>(state, pegasus::V0, mask);
+
+        uint32_t opcode = vle8Op(vd, rs1, 0); // vm = 0 masked
+        injectInstruction(pc, opcode);
+
+        // Masked off elements are undisturbed
+        const VLEN vd_val = READ_VEC_REG<VLEN>(state, vd);
+        for (size_t i = 0; i < vd_val.size(); ++i)
+        {
+            const bool active = (mask[0] >> i) & 1;
+            EXPECT_EQUAL(vd_val[i], active ? (i + 1) : vd_prev[i]);
+        }
+        const pegasus::PegasusState::SimState* sim_state = state->getSimState();
+        std::cout << sim_state->current_inst << std::endl;
+        EXPECT_EQUAL(sim_state->inst_count, 4);
+    }
+
+    void testVse8PageCross()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const uint64_t pc = 0x1000;
+        const pegasus::Addr addr = 0x3ffa; // crosses into the next page
+        const uint32_t vs3 = 4, rs1 = 1;
+        const VLEN vs3_val = {1, 2, 3, 4, 5, 6, 7, 8};
+
+        state->getVectorConfig()->setVLEN(64);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(8); // avl = 8
+        state->getVectorConfig()->setSEW(8);
+        state->getVectorConfig()->setLMUL(8);
+        for (size_t i = 0; i < vs3_val.size() + 1; ++i)
+        {
+            state->writeMemory<uint8_t>(addr + i, 0);
+        }
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+        WRITE_VEC_REG<VLEN>(state, vs3, vs3_val);
+
+        uint32_t opcode = vse8Op(vs3, rs1, 1); // vm = 1 unmasked
+        injectInstruction(pc, opcode);
+
+        for (size_t i = 0; i < vs3_val.size(); ++i)
+        {
+            EXPECT_EQUAL(state->readMemory<uint8_t>(addr + i), vs3_val[i]);
+        }
+        // Past vl
+        EXPECT_EQUAL(state->readMemory<uint8_t>(addr + vs3_val.size()), 0);
+        const pegasus::PegasusState::SimState* sim_state = state->getSimState();
+        std::cout << sim_state->current_inst << std::endl;
+        EXPECT_EQUAL(sim_state->inst_count, 5);
+    }
+
+    void testVsoxei8PageCross()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const uint64_t pc = 0x1000;
+        const pegasus::Addr addr = 0x4ff8;
+        const uint32_t vs3 = 8, rs1 = 1, vs2 = 3;
+        // Element 1 is in the next page, element 3 stores over element 0
+        const VLEN vs2_val = {0, 16, 2, 0, 0, 0, 0, 0};
+        const VLEN vs3_val = {0x11, 0x11, 0x22, 0x22, 0x33, 0x33, 0x44, 0x44};
+
+        state->getVectorConfig()->setVLEN(64);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(4);   // avl = 4
+        state->getVectorConfig()->setSEW(16); // sew = 16
+        state->getVectorConfig()->setLMUL(8); // lmul = 1
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+        WRITE_VEC_REG<VLEN>(state, vs2, vs2_val);
+        WRITE_VEC_REG<VLEN>(state, vs3, vs3_val);
+
+        uint32_t opcode = vsoxei8Op(vs3, rs1, vs2, 1); // vm = 1 unmasked
+        injectInstruction(pc, opcode);
+
+        // Ordered: the last store to an address wins
+        EXPECT_EQUAL(state->readMemory<uint16_t>(addr), 0x4444);
+        EXPECT_EQUAL(state->readMemory<uint16_t>(addr + 2), 0x3333);
+        EXPECT_EQUAL(state->readMemory<uint16_t>(addr + 16), 0x2222);
+        const pegasus::PegasusState::SimState* sim_state = state->getSimState();
+        std::cout << sim_state->current_inst << std::endl;
+        EXPECT_EQUAL(sim_state->inst_count, 6);
+    }
+
+    void testVlseg3e8PageCross()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const uint64_t pc = 0x1000;
+        const pegasus::Addr addr = 0x5ffa; // crosses into the next page
+        const uint32_t vd = 8, rs1 = 1;
+        const size_t nfields = 3, vl = 5;
+        const VLEN vd_prev = {0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa};
+
+        state->getVectorConfig()->setVLEN(64);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(vl); // avl = 5
+        state->getVectorConfig()->setSEW(8);
+        state->getVectorConfig()->setLMUL(8);
+        for (size_t i = 0; i < vl * nfields; ++i)
+        {
+            state->writeMemory<uint8_t>(addr + i, i);
+        }
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+        for (size_t f = 0; f < nfields; ++f)
+        {
+            WRITE_VEC_REG<VLEN>(state, vd + f, vd_prev);
+        }
+
+        uint32_t opcode = vlseg3e8Op(vd, rs1, 1); // vm = 1 unmasked
+        injectInstruction(pc, opcode);
+
+        // Field f of segment i goes to element i of vd + f
+        for (size_t f = 0; f < nfields; ++f)
+        {
+            const VLEN vd_val = READ_VEC_REG<VLEN>(state, vd + f);
+            for (size_t i = 0; i < vd_val.size(); ++i)
+            {
+                EXPECT_EQUAL(vd_val[i], (i < vl) ? (i * nfields + f) : vd_prev[i]);
+            }
+        }
+        const pegasus::PegasusState::SimState* sim_state = state->getSimState();
+        std::cout << sim_state->current_inst << std::endl;
+        EXPECT_EQUAL(sim_state->inst_count, 7);
+    }
+
+    void testVsseg4e16Masked()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const uint64_t pc = 0x1000;
+        const pegasus::Addr addr = 0x6000;
+        const uint32_t vs3 = 12, rs1 = 1;
+        const size_t nfields = 4, vl = 3;
+        const VLEN mask = {0b101, 0, 0, 0, 0, 0, 0, 0};
+
+        state->getVectorConfig()->setVLEN(64);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(vl);  // avl = 3
+        state->getVectorConfig()->setSEW(16); // sew = 16
+        state->getVectorConfig()->setLMUL(8); // lmul = 1
+        for (size_t i = 0; i < (vl + 1) * nfields; ++i)
+        {
+            state->writeMemory<uint16_t>(addr + i * 2, 0);
+        }
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+        WRITE_VEC_REG<VLEN>(state, pegasus::V0, mask);
+        for (size_t f = 0; f < nfields; ++f)
+        {
+            std::array<uint16_t, 4> vs3_val;
+            for (size_t i = 0; i < vs3_val.size(); ++i)
+            {
+                vs3_val[i] = 0x100 * (i + 1) + f;
+            }
+            WRITE_VEC_REG<VLEN>(state, vs3 + f, std::bit_cast<VLEN>(vs3_val));
+        }
+
+        uint32_t opcode = vsseg4e16Op(vs3, rs1, 0); // vm = 0 masked
+        injectInstruction(pc, opcode);
+
+        // Segment i is stored at addr + i * 8 if it is active, nothing is stored past vl
+        for (size_t i = 0; i < vl + 1; ++i)
+        {
+            const bool active = (i < vl) && ((mask[0] >> i) & 1);
+            for (size_t f = 0; f < nfields; ++f)
+            {
+                const uint16_t expected = active ? (0x100 * (i + 1) + f) : 0;
+                EXPECT_EQUAL(state->readMemory<uint16_t>(addr + (i * nfields + f) * 2), expected);
+            }
+        }
+        const pegasus::PegasusState::SimState* sim_state = state->getSimState();
+        std::cout << sim_state->current_inst << std::endl;
+        EXPECT_EQUAL(sim_state->inst_count, 8);
+    }
+
+    // A strided load whose elements are on more pages than can be translated at once is
+    // translated and executed in batches
+    void testVlse8ManyPages()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const uint64_t pc = 0x1000;
+        const pegasus::Addr addr = LOAD_PAGES + 0x123;
+        const pegasus::Addr stride = 0x1000; // one page per element
+        const uint32_t vd = 8, rs1 = 1, rs2 = 2;
+        const size_t vl = 300, vlenb = 64;
+
+        enableTranslation(state);
+        state->getVectorConfig()->setVLEN(vlenb * 8);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(vl);
+        state->getVectorConfig()->setSEW(8);
+        state->getVectorConfig()->setLMUL(64); // lmul = 8
+        for (size_t i = 0; i < vl; ++i)
+        {
+            state->writeMemory<uint8_t>(addr + i * stride, i * 3 + 1);
+        }
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+        WRITE_INT_REG<XLEN>(state, rs2, stride);
+
+        uint32_t opcode = vlse8Op(vd, rs1, rs2, 1); // vm = 1 unmasked
+        injectInstruction(pc, opcode);
+
+        for (size_t i = 0; i < vl; ++i)
+        {
+            EXPECT_EQUAL(READ_VEC_ELEM<uint8_t>(state, vd + i / vlenb, i % vlenb),
+                         static_cast<uint8_t>(i * 3 + 1));
+        }
+        EXPECT_EQUAL(state->getVectorConfig()->getVSTART(), 0);
+        EXPECT_EQUAL(state->getPc(), pc + 4);
+        const pegasus::PegasusState::SimState* sim_state = state->getSimState();
+        std::cout << sim_state->current_inst << std::endl;
+        EXPECT_EQUAL(sim_state->inst_count, 9);
+    }
+
+    // A page fault in a later batch of a strided store leaves vstart at the start of that batch,
+    // the elements of the earlier batches are stored. Restarting the store finishes it.
+    void testVsse8FaultInLaterBatch()
+    {
+        pegasus::PegasusState* state = getPegasusState();
+        const uint64_t pc = 0x1000;
+        const pegasus::Addr addr = STORE_PAGES + 0x456;
+        const pegasus::Addr stride = 0x1000; // one page per element
+        const uint32_t vs3 = 8, rs1 = 1, rs2 = 2;
+        const size_t vl = 300, vlenb = 64;
+        // An element may need two pages, the first batch stops when one more page is left
+        const size_t batch_end = pegasus::PegasusTranslationState::MAX_TRANSLATION - 1;
+        const size_t fault_elem = 280;
+        const pegasus::Addr fault_vaddr = addr + fault_elem * stride;
+
+        enableTranslation(state);
+        setPte(state, STORE_TABLE, fault_elem, 0);
+        state->getVectorConfig()->setVLEN(vlenb * 8);
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(vl);
+        state->getVectorConfig()->setSEW(8);
+        state->getVectorConfig()->setLMUL(64); // lmul = 8
+        for (size_t i = 0; i < vl; ++i)
+        {
+            state->writeMemory<uint8_t>(addr + i * stride, 0);
+            WRITE_VEC_ELEM<uint8_t>(state, vs3 + i / vlenb, i * 5 + 2, i % vlenb);
+        }
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+        WRITE_INT_REG<XLEN>(state, rs2, stride);
+
+        uint32_t opcode = vsse8Op(vs3, rs1, rs2, 1); // vm = 1 unmasked
+        injectInstruction(pc, opcode);
+
+        EXPECT_EQUAL(READ_CSR_REG<XLEN>(state, pegasus::MCAUSE),
+                     static_cast<XLEN>(pegasus::FaultCause::STORE_AMO_PAGE_FAULT));
+        EXPECT_EQUAL(READ_CSR_REG<XLEN>(state, pegasus::MTVAL), fault_vaddr);
+        EXPECT_EQUAL(READ_CSR_REG<XLEN>(state, pegasus::MEPC), pc);
+        EXPECT_EQUAL(state->getVectorConfig()->getVSTART(), batch_end);
+        for (size_t i = 0; i < vl; ++i)
+        {
+            const uint8_t expected = (i < batch_end) ? (i * 5 + 2) : 0;
+            EXPECT_EQUAL(state->readMemory<uint8_t>(addr + i * stride), expected);
+        }
+
+        // Map the page and restart the store at vstart, the trap went back to machine mode
+        enableTranslation(state);
+        for (size_t i = 0; i < batch_end; ++i)
+        {
+            state->writeMemory<uint8_t>(addr + i * stride, 0);
+        }
+        injectInstruction(pc, opcode);
+
+        EXPECT_EQUAL(state->getVectorConfig()->getVSTART(), 0);
+        for (size_t i = 0; i < vl; ++i)
+        {
+            const uint8_t expected = (i < batch_end) ? 0 : (i * 5 + 2);
+            EXPECT_EQUAL(state->readMemory<uint8_t>(addr + i * stride), expected);
+        }
+    }
+
     uint32_t vle8Op(uint8_t rd, uint8_t rs1, uint8_t vm)
     {
         uint32_t opcode = 0;
@@ -134,6 +429,30 @@ class VlsInstructionTester : public PegasusInstructionTester
         return opcode;
     }
 
+    uint32_t vse8Op(uint8_t rs3, uint8_t rs1, uint8_t vm)
+    {
+        uint32_t opcode = 0;
+        uint8_t offset = 0;
+        opcode |= 0x27 << offset; // opcode
+        offset += 7;
+        opcode |= rs3 << offset; // vs3
+        offset += 5;
+        opcode |= 0 << offset; // width
+        offset += 3;
+        opcode |= rs1 << offset; // rs1
+        offset += 5;
+        opcode |= 0 << offset; // rs2
+        offset += 5;
+        opcode |= vm << offset; // vm
+        offset += 1;
+        opcode |= 0 << offset; // newop
+        offset += 3;
+        opcode |= 0 << offset; // nf
+        offset += 3;
+        EXPECT_EQUAL(offset, 32);
+        return opcode;
+    }
+
     uint32_t vlse8Op(uint8_t rd, uint8_t rs1, uint8_t rs2, uint8_t vm)
     {
         uint32_t opcode = 0;
@@ -158,6 +477,30 @@ class VlsInstructionTester : public PegasusInstructionTester
         return opcode;
     }
 
+    uint32_t vsse8Op(uint8_t rs3, uint8_t rs1, uint8_t rs2, uint8_t vm)
+    {
+        uint32_t opcode = 0;
+        uint8_t offset = 0;
+        opcode |= 0x27 << offset; // opcode
+        offset += 7;
+        opcode |= rs3 << offset; // vs3
+        offset += 5;
+        opcode |= 0 << offset; // width
+        offset += 3;
+        opcode |= rs1 << offset; // rs1
+        offset += 5;
+        opcode |= rs2 << offset; // rs2
+        offset += 5;
+        opcode |= vm << offset; // vm
+        offset += 1;
+        opcode |= 2 << offset; // newop
+        offset += 3;
+        opcode |= 0 << offset; // nf
+        offset += 3;
+        EXPECT_EQUAL(offset, 32);
+        return opcode;
+    }
+
     uint32_t vloxei8Op(uint8_t rd, uint8_t rs1, uint8_t vs2, uint8_t vm)
     {
         uint32_t opcode = 0;
@@ -182,7 +525,125 @@ class VlsInstructionTester : public PegasusInstructionTester
         return opcode;
     }
 
+    uint32_t vsoxei8Op(uint8_t rs3, uint8_t rs1, uint8_t vs2, uint8_t vm)
+    {
+        uint32_t opcode = 0;
+        uint8_t offset = 0;
+        opcode |= 0x27 << offset; // opcode
+        offset += 7;
+        opcode |= rs3 << offset; // vs3
+        offset += 5;
+        opcode |= 0 << offset; // width
+        offset += 3;
+        opcode |= rs1 << offset; // rs1
+        offset += 5;
+        opcode |= vs2 << offset; // rs2
+        offset += 5;
+        opcode |= vm << offset; // vm
+        offset += 1;
+        opcode |= 3 << offset; // newop
+        offset += 3;
+        opcode |= 0 << offset; // nf
+        offset += 3;
+        EXPECT_EQUAL(offset, 32);
+        return opcode;
+    }
+
+    uint32_t vlseg3e8Op(uint8_t rd, uint8_t rs1, uint8_t vm)
+    {
+        uint32_t opcode = 0;
+        uint8_t offset = 0;
+        opcode |= 0x7 << offset; // opcode
+        offset += 7;
+        opcode |= rd << offset; // rd
+        offset += 5;
+        opcode |= 0 << offset; // width
+        offset += 3;
+        opcode |= rs1 << offset; // rs1
+        offset += 5;
+        opcode |= 0 << offset; // rs2
+        offset += 5;
+        opcode |= vm << offset; // vm
+        offset += 1;
+        opcode |= 0 << offset; // newop
+        offset += 3;
+        opcode |= 2 << offset; // nf
+        offset += 3;
+        EXPECT_EQUAL(offset, 32);
+        return opcode;
+    }
+
+    uint32_t vsseg4e16Op(uint8_t rs3, uint8_t rs1, uint8_t vm)
+    {
+        uint32_t opcode = 0;
+        uint8_t offset = 0;
+        opcode |= 0x27 << offset; // opcode
+        offset += 7;
+        opcode |= rs3 << offset; // vs3
+        offset += 5;
+        opcode |= 5 << offset; // width
+        offset += 3;
+        opcode |= rs1 << offset; // rs1
+        offset += 5;
+        opcode |= 0 << offset; // rs2
+        offset += 5;
+        opcode |= vm << offset; // vm
+        offset += 1;
+        opcode |= 0 << offset; // newop
+        offset += 3;
+        opcode |= 3 << offset; // nf
+        offset += 3;
+        EXPECT_EQUAL(offset, 32);
+        return opcode;
+    }
+
   private:
+    // Sv39 page tables identity mapping the 2MB regions of the strided tests with 4K pages
+    static constexpr pegasus::Addr ROOT_TABLE = 0x10000;
+    static constexpr pegasus::Addr L1_TABLE = 0x11000;
+    static constexpr pegasus::Addr LOAD_TABLE = 0x12000;
+    static constexpr pegasus::Addr STORE_TABLE = 0x13000;
+    static constexpr pegasus::Addr LOAD_PAGES = 0x200000;
+    static constexpr pegasus::Addr STORE_PAGES = 0x400000;
+
+    // PTE bits
+    static constexpr uint64_t PTE_V = 1 << 0, PTE_R = 1 << 1, PTE_W = 1 << 2, PTE_A = 1 << 6,
+                              PTE_D = 1 << 7;
+
+    static void setPte(pegasus::PegasusState* state, const pegasus::Addr table,
+                       const uint32_t idx, const uint64_t pte)
+    {
+        state->writeMemory<uint64_t>(table + idx * sizeof(uint64_t), pte);
+    }
+
+    static uint64_t makePte(const pegasus::Addr paddr, const uint64_t bits)
+    {
+        return ((paddr >> 12) << 10) | bits;
+    }
+
+    // Fill the page tables and translate loads and stores as supervisor accesses (MPRV), the
+    // hart stays in machine mode so instruction fetch is not translated
+    void enableTranslation(pegasus::PegasusState* state)
+    {
+        const uint64_t leaf_bits = PTE_V | PTE_R | PTE_W | PTE_A | PTE_D;
+        setPte(state, ROOT_TABLE, 0, makePte(L1_TABLE, PTE_V));
+        setPte(state, L1_TABLE, LOAD_PAGES >> 21, makePte(LOAD_TABLE, PTE_V));
+        setPte(state, L1_TABLE, STORE_PAGES >> 21, makePte(STORE_TABLE, PTE_V));
+        for (uint32_t idx = 0; idx < 512; ++idx)
+        {
+            setPte(state, LOAD_TABLE, idx, makePte(LOAD_PAGES + idx * 0x1000, leaf_bits));
+            setPte(state, STORE_TABLE, idx, makePte(STORE_PAGES + idx * 0x1000, leaf_bits));
+        }
+
+        const uint64_t satp_sv39 = 8;
+        WRITE_CSR_REG<XLEN>(state, pegasus::SATP, (satp_sv39 << 60) | (ROOT_TABLE >> 12));
+        WRITE_CSR_FIELD<XLEN>(state, pegasus::CSR::MSTATUS::MPP,
+                              static_cast<XLEN>(pegasus::PrivMode::SUPERVISOR));
+        WRITE_CSR_FIELD<XLEN>(state, pegasus::CSR::MSTATUS::MPRV, XLEN(1));
+        state->updateTranslationMode<XLEN>(
+            pegasus::translate_types::TranslationStage::SUPERVISOR);
+    }
+
     pegasus::PegasusInst::PtrType instPtr_ = nullptr;
 };
 
@@ -193,6 +654,13 @@ int main()
     Vls_tester.testVle8();
     Vls_tester.testVlse8();
     Vls_tester.testVloxei8();
+    Vls_tester.testVle8MaskedPageCross();
+    Vls_tester.testVse8PageCross();
+    Vls_tester.testVsoxei8PageCross();
+    Vls_tester.testVlseg3e8PageCross();
+    Vls_tester.testVsseg4e16Masked();
+    Vls_tester.testVlse8ManyPages();
+    Vls_tester.testVsse8FaultInLaterBatch();
 
     REPORT_ERROR;
     return ERROR_CODE;